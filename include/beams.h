@@ -1,15 +1,19 @@
 #pragma once
 #include "config.h"
+#include "telemetry.h"
+#include "latency.h"
 
 // Memory to remember if the beam was broken last time we checked
-bool beamLast[4] = {false, false, false, false};
+bool beamLast[NUM_STRIPS_CONNECTED] = {};
+// Every break seen so far, all beams (shown on the HUD, hud.h)
+uint16_t beamBreaks = 0;
 
 void beamsBegin() {
-  for (int i = 0; i < 4; i++) {
+  for (int i = 0; i < NUM_STRIPS_CONNECTED; i++) {
     pinMode(BEAM_PINS[i], INPUT_PULLUP); // Use internal resistor
   }
   // Initialize beam memory with the actual current state to avoid false positives
-  for (int i = 0; i < 4; i++) {
+  for (int i = 0; i < NUM_STRIPS_CONNECTED; i++) {
     beamLast[i] = digitalRead(BEAM_PINS[i]) == HIGH;
   }
   Serial.println("Beams: Sensors Active");
@@ -20,11 +24,13 @@ void beamsBegin() {
 bool beamBroken(uint8_t i) {
   // With INPUT_PULLUP: LOW = beam connected (seeing light), HIGH = beam broken
   bool now = digitalRead(BEAM_PINS[i]) == HIGH; // HIGH means beam is broken
+  latencyBeamPoll(i, now);
 
   // Logic: It is broken NOW (HIGH), but it wasn't broken BEFORE (was LOW).
   if (now && !beamLast[i]) {
     beamLast[i] = true; // Remember it's broken
-    Serial.print("Beam "); Serial.print(i); Serial.println(" broken!");
+    beamBreaks++;
+    LOG_DEBUG(TEV_BEAM, i);
     return true;
   }
 
@@ -34,7 +40,7 @@ bool beamBroken(uint8_t i) {
 
 // Reset the beam memory
 void beamsReset() {
-  for (int i = 0; i < 4; i++) {
+  for (int i = 0; i < NUM_STRIPS_CONNECTED; i++) {
     beamLast[i] = digitalRead(BEAM_PINS[i]) == HIGH;
   }
   Serial.println("Beams: Memory Reset");
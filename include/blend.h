@@ -0,0 +1,130 @@
+#pragma once
+#include <stdint.h>
+#include <string.h>
+
+// --- PIXEL BLEND KERNELS ---
+// Fades, cross-fades and brightness ramps over whole spans of a strip's
+// pixel buffer (strips[q].getPixels(), 3 bytes per LED, brightness already
+// applied). Going through getPixelColor()/Color() for every channel of
+// every LED is far too slow for a frame of the whole wall, so these work
+// on the buffer directly, four channel bytes at a time in one 32-bit word
+// ("SIMD within a register"). Every channel gets the same treatment, so
+// the word boundaries don't have to line up with the LEDs.
+//
+// Levels and mix amounts are 0-255: 0 = nothing, 255 = all of it. On the
+// board (Cortex-M4 with the DSP extension) the saturating add is a single
+// UQADD8 and the byte unpacking is UXTB16; elsewhere the same results come
+// from plain integer arithmetic. bench_blend checks both against a
+// per-channel version and times them.
+//
+// Example, fade quadrant q to half over a few frames:
+//   blendScale(strips[q].getPixels(), LEDS_PER_QUAD, 128); stripShow(q);
+
+// 0-255 level as a multiplier out of 256, so 255 leaves a byte unchanged
+inline uint16_t blendWeight(uint8_t level) {
+  return level + (level >> 7);
+}
+
+inline uint32_t blendLoad(const uint8_t* p) {
+  uint32_t w;
+  memcpy(&w, p, 4); // one unaligned load on the M4
+  return w;
+}
+
+inline void blendStore(uint8_t* p, uint32_t w) {
+  memcpy(p, &w, 4);
+}
+
+// Bytes 0 and 2 of a word, and bytes 1 and 3, each in a 16-bit lane
+inline uint32_t blendEven(uint32_t x) {
+#if defined(__ARM_FEATURE_DSP)
+  uint32_t r;
+  asm("uxtb16 %0, %1" : "=r"(r) : "r"(x));
+  return r;
+#else
+  return x & 0x00FF00FF;
+#endif
+}
+
+inline uint32_t blendOdd(uint32_t x) {
+#if defined(__ARM_FEATURE_DSP)
+  uint32_t r;
+  asm("uxtb16 %0, %1, ror #8" : "=r"(r) : "r"(x));
+  return r;
+#else
+  return (x >> 8) & 0x00FF00FF;
+#endif
+}
+
+// Each byte times w/256. A lane holds at most 255 x 256, so nothing
+// carries into the next one.
+inline uint32_t blendScaleWord(uint32_t x, uint16_t w) {
+  uint32_t even = blendEven(x) * w;
+  uint32_t odd = blendOdd(x) * w;
+  return ((even >> 8) & 0x00FF00FF) | (odd & 0xFF00FF00);
+}
+
+// Each byte (a x wa + b x wb) / 256, with wa + wb = 256
+inline uint32_t blendLerpWord(uint32_t a, uint32_t b, uint16_t wa, uint16_t wb) {
+  uint32_t even = blendEven(a) * wa + blendEven(b) * wb;
+  uint32_t odd = blendOdd(a) * wa + blendOdd(b) * wb;
+  return ((even >> 8) & 0x00FF00FF) | (odd & 0xFF00FF00);
+}
+
+// Each byte a + b, stopping at 255
+inline uint32_t blendAddWord(uint32_t a, uint32_t b) {
+#if defined(__ARM_FEATURE_DSP)
+  uint32_t r;
+  asm("uqadd8 %0, %1, %2" : "=r"(r) : "r"(a), "r"(b));
+  return r;
+#else
+  // Add the low 7 bits of every byte, then put the top bits back in
+  uint32_t sum = ((a & 0x7F7F7F7F) + (b & 0x7F7F7F7F)) ^ ((a ^ b) & 0x80808080);
+  uint32_t carry = ((a & b) | ((a | b) & ~sum)) & 0x80808080; // bytes that overflowed
+  return sum | ((carry << 1) - (carry >> 7));                  // ... become 0xFF
+#endif
+}
+
+// The same operations on single bytes, for the 0-3 left over at the end
+// of a span (identical results)
+inline uint8_t blendScaleByte(uint8_t x, uint16_t w) { return (x * w) >> 8; }
+inline uint8_t blendLerpByte(uint8_t a, uint8_t b, uint16_t wa, uint16_t wb) { return (a * wa + b * wb) >> 8; }
+inline uint8_t blendAddByte(uint8_t a, uint8_t b) { return a + b > 255 ? 255 : a + b; }
+
+// --- SPANS (count = LEDs, 3 bytes each) ---
+
+// Brightness ramp / fade: every channel times level/255
+void blendScale(uint8_t* px, uint16_t count, uint8_t level) {
+  uint16_t w = blendWeight(level);
+  uint16_t bytes = count * 3, i = 0;
+  for (; i + 4 <= bytes; i += 4) blendStore(&px[i], blendScaleWord(blendLoad(&px[i]), w));
+  for (; i < bytes; i++) px[i] = blendScaleByte(px[i], w);
+}
+
+// Cross-fade: out = from + (to - from) x mix/255. out may be from or to.
+void blendLerp(uint8_t* out, const uint8_t* from, const uint8_t* to, uint16_t count, uint8_t mix) {
+  uint16_t wb = blendWeight(mix), wa = 256 - wb;
+  uint16_t bytes = count * 3, i = 0;
+  for (; i + 4 <= bytes; i += 4) {
+    blendStore(&out[i], blendLerpWord(blendLoad(&from[i]), blendLoad(&to[i]), wa, wb));
+  }
+  for (; i < bytes; i++) out[i] = blendLerpByte(from[i], to[i], wa, wb);
+}
+
+// Saturating add: out = min(out + src, 255) per channel
+void blendAdd(uint8_t* out, const uint8_t* src, uint16_t count) {
+  uint16_t bytes = count * 3, i = 0;
+  for (; i + 4 <= bytes; i += 4) blendStore(&out[i], blendAddWord(blendLoad(&out[i]), blendLoad(&src[i])));
+  for (; i < bytes; i++) out[i] = blendAddByte(out[i], src[i]);
+}
+
+// Additive blend: out = min(out + src x level/255, 255), e.g. a glow or
+// sparkle layer laid over the scene
+void blendAddScaled(uint8_t* out, const uint8_t* src, uint16_t count, uint8_t level) {
+  uint16_t w = blendWeight(level);
+  uint16_t bytes = count * 3, i = 0;
+  for (; i + 4 <= bytes; i += 4) {
+    blendStore(&out[i], blendAddWord(blendLoad(&out[i]), blendScaleWord(blendLoad(&src[i]), w)));
+  }
+  for (; i < bytes; i++) out[i] = blendAddByte(out[i], blendScaleByte(src[i], w));
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include "config.h"
+#include "modes.h"
+#include "memstats.h"
+#include "serial_room.h"
+
+// --- BOOT TIMING ---
+// At the venue nobody plugs in a laptop, so setup() must not wait for one.
+// It brings everything up in stages, each timed:
+//   params    saved tunables from the data flash
+//   leds      clear and show every strip once (before the IR receiver is
+//             running, so its interrupts can't garble the frame and no
+//             second "cleanup" pass is needed)
+//   beams     sensor pins
+//   ir        the IR receiver
+//   hud       the on-board LED matrix
+//   journal   replay the saved game state from the data flash
+//   serial    whatever is left of BOOT_SERIAL_WAIT_MS (counted from the
+//             start of setup, so it overlaps the stages above): a Serial
+//             Monitor that is already open gets the startup messages
+// After that the game is in MODE_OFF and answers the remote. Nothing
+// waits for a USB host beyond that grace period.
+//
+// The breakdown is kept and printed from loop() as soon as someone opens
+// the Serial Monitor, one line per loop (with the RAM numbers from
+// modesReportRam() and memPrint()):
+//   Boot: MODE_OFF after 52.3 ms (budget 500 ms)
+//   Boot stages ms: params 0.4 leds 44.5 beams 0.0 ir 0.1 hud 0.0 journal 7.2 serial 0.0
+
+enum BootStage : uint8_t {
+  BOOT_PARAMS, BOOT_LEDS, BOOT_BEAMS, BOOT_IR, BOOT_HUD, BOOT_JOURNAL, BOOT_SERIAL, BOOT_STAGES
+};
+
+const char* const BOOT_STAGE_NAMES[BOOT_STAGES] = {
+  "params", "leds", "beams", "ir", "hud", "journal", "serial"
+};
+
+// Grace for a Serial Monitor that is already open, counted from the start
+// of setup()
+const uint16_t BOOT_SERIAL_WAIT_MS = 300;
+// setup() must reach MODE_OFF within this, serial grace included
+const uint16_t BOOT_BUDGET_MS = 500;
+// Report lines are only printed once the UART has this much room
+// (serial_room.h)
+const uint8_t BOOT_REPORT_ROOM = 40;
+const uint8_t BOOT_REPORT_LINES = 4;
+
+uint32_t bootStartUs = 0;
+uint32_t bootLastUs = 0;
+uint32_t bootStageUs[BOOT_STAGES];
+uint32_t bootTotalUs = 0;
+uint8_t bootReportNext = BOOT_REPORT_LINES; // next report line (none pending)
+
+// Call first thing in setup()
+void bootBegin() {
+  bootStartUs = micros();
+  bootLastUs = bootStartUs;
+  memset(bootStageUs, 0, sizeof(bootStageUs));
+  bootReportNext = BOOT_REPORT_LINES;
+}
+
+// Stage `s` has just finished
+void bootDone(BootStage s) {
+  uint32_t now = micros();
+  bootStageUs[s] = now - bootLastUs;
+  bootLastUs = now;
+}
+
+// Give an open Serial Monitor what is left of the grace period, then stop
+// the clock. The report waits in loop() for the monitor.
+void bootFinish() {
+  while (!Serial && micros() - bootStartUs < BOOT_SERIAL_WAIT_MS * 1000UL) delay(1);
+  bootDone(BOOT_SERIAL);
+  bootTotalUs = micros() - bootStartUs;
+  bootReportNext = 0;
+}
+
+void bootPrintMs(uint32_t us) {
+  Serial.print((unsigned long)(us / 1000));
+  Serial.print('.');
+  Serial.print((unsigned long)(us / 100 % 10));
+}
+
+// Call every loop: prints the boot report once the Serial Monitor is open
+void bootService() {
+  if (bootReportNext >= BOOT_REPORT_LINES || !Serial) return;
+  if (serialRoom() < BOOT_REPORT_ROOM) return;
+  switch (bootReportNext++) {
+    case 0:
+      Serial.print("Boot: MODE_OFF after "); bootPrintMs(bootTotalUs);
+      Serial.print(" ms (budget "); Serial.print(BOOT_BUDGET_MS);
+      Serial.println(bootTotalUs > BOOT_BUDGET_MS * 1000UL ? " ms, OVER)" : " ms)");
+      break;
+    case 1:
+      Serial.print("Boot stages ms:");
+      for (uint8_t s = 0; s < BOOT_STAGES; s++) {
+        Serial.print(' '); Serial.print(BOOT_STAGE_NAMES[s]); Serial.print(' ');
+        bootPrintMs(bootStageUs[s]);
+      }
+      Serial.println();
+      break;
+    case 2:
+      modesReportRam();
+      break;
+    default:
+      if (memAvailable) memPrint();
+      break;
+  }
+}
@@ -1,31 +1,95 @@
 #pragma once
 #include <Arduino.h>
 
+// --- PANEL GEOMETRY ---
+// Each quadrant is one panel: a serpentine strip folded into rows, pixel 0
+// at the bottom left, even rows running left to right and odd rows back.
+// PanelLayout describes one at compile time, so the index maps below fold
+// to constants wherever the coordinates are constants, and every buffer
+// sized from it is fixed at build time. All panels of a wall share the
+// layout picked by `Panel`.
+enum TurnLeds : uint8_t {
+  TURN_LED_PER_ROW,  // one LED at the end of each row is spent on the turn
+  TURN_NONE          // rows butt straight into each other
+};
+
+template <uint8_t Rows, uint8_t Cols, TurnLeds Turn, uint8_t SpareRows>
+struct PanelLayout {
+  static constexpr uint8_t ROWS = Rows;  // visible matrix
+  static constexpr uint8_t COLS = Cols;
+  static constexpr uint8_t PHYS_COLS = Cols + (Turn == TURN_LED_PER_ROW ? 1 : 0);
+  static constexpr uint8_t PHYS_ROWS = Rows + SpareRows;  // spare rows stay dark
+  static constexpr uint16_t LEDS = (uint16_t)PHYS_ROWS * PHYS_COLS;
+
+  // Strip index of visible pixel (x, y); out-of-range requests map to 0.
+  // A turn LED sits at the end of its row whichever way the row runs.
+  static constexpr uint16_t index(uint8_t x, uint8_t y) {
+    return x >= COLS || y >= ROWS ? 0
+         : (uint16_t)y * PHYS_COLS + (y % 2 == 0 ? x : COLS - 1 - x);
+  }
+
+  // The reverse: which visible pixel strip index i is. False for a turn
+  // LED or a spare row.
+  static constexpr bool pixelAt(uint16_t i, uint8_t& x, uint8_t& y) {
+    uint16_t row = i / PHYS_COLS, p = i % PHYS_COLS;
+    if (row >= ROWS || p >= COLS) return false;
+    y = (uint8_t)row;
+    x = (uint8_t)(row % 2 == 0 ? p : COLS - 1 - p);
+    return true;
+  }
+
+  static_assert(Rows > 0 && Cols > 0, "a panel needs at least one pixel");
+  static_assert((uint32_t)(Rows + SpareRows) * (Cols + 1) <= 65535, "a strip holds at most 65535 LEDs");
+};
+
 // --- HARDWARE CONFIGURATION ---
 #define NUM_STRIPS_CONNECTED 4   // How many quadrants are physically wired up right now?
-#define QUAD_ROWS 18             // Height of the usable (visible) matrix
-#define QUAD_COLS 18             // Width of the usable (visible) matrix
 
-// Physical strip layout: the strip is routed in a 19x19 physical grid
-// but one LED per row is consumed by the serpentine turn and should
-// remain unused by the visible 18x18 matrix. Keep the usable
-// dimensions in `QUAD_*` and expose the physical dimensions below.
-#define PHYS_ROWS (QUAD_ROWS+1)       // Physical rows on the strip routing
-#define PHYS_COLS (QUAD_COLS+1)       // Physical cols on the strip routing
+// The honeycomb: 18x18 visible pixels routed on a 19x19 grid. One LED per
+// row is consumed by the serpentine turn and the top physical row is a
+// spare; both stay unused by the visible matrix.
+typedef PanelLayout<18, 18, TURN_LED_PER_ROW, 1> Panel;
+
+const uint8_t QUAD_ROWS = Panel::ROWS;       // Height of the usable (visible) matrix
+const uint8_t QUAD_COLS = Panel::COLS;       // Width of the usable (visible) matrix
+const uint8_t PHYS_ROWS = Panel::PHYS_ROWS;  // Physical rows on the strip routing
+const uint8_t PHYS_COLS = Panel::PHYS_COLS;  // Physical cols on the strip routing
 
 // Number of LEDs per physical quadrant (what the strip actually has)
-#define LEDS_PER_QUAD (PHYS_ROWS * PHYS_COLS)
+const uint16_t LEDS_PER_QUAD = Panel::LEDS;
 
 #define BRIGHTNESS 50            // 0 (off) to 255 (blindingly bright)
 
 // --- PINS ---
-// Digital pins for the LED Data wires
-const uint8_t LED_PINS[4]  = {8, 9, 6, 7};
-// Digital pins for the IR Beam Break sensors
-const uint8_t BEAM_PINS[4] = {2, 3, 4, 5};
+// Digital pins for the LED Data wires, one per quadrant
+const uint8_t LED_PINS[]  = {8, 9, 6, 7};
+// Digital pins for the IR Beam Break sensors, one per quadrant
+const uint8_t BEAM_PINS[] = {2, 3, 4, 5};
+static_assert(sizeof(LED_PINS) >= NUM_STRIPS_CONNECTED && sizeof(BEAM_PINS) >= NUM_STRIPS_CONNECTED,
+              "every connected quadrant needs an LED pin and a beam pin");
 // Pin for the IR Remote Receiver
 #define IR_RECEIVER_PIN 11
 
+// --- MULTI-BOARD LINK (link.h) ---
+// One board can run the whole wall (LINK_SINGLE, the default), or a leader
+// runs the game and followers drive the LEDs: pio run -e leader, and
+// -e follower1 / -e follower2 for the others. Leader TX (pin 1) goes to
+// every follower's RX (pin 0), and LINK_SYNC_PIN to LINK_SYNC_PIN.
+#define LINK_SINGLE   0
+#define LINK_LEADER   1
+#define LINK_FOLLOWER 2
+#ifndef LINK_ROLE
+#define LINK_ROLE LINK_SINGLE
+#endif
+#ifndef LINK_BOARD
+#define LINK_BOARD 0             // a follower's number (1, 2, ...); the leader is 0
+#endif
+// Which board drives each quadrant's strip (0 = the leader itself)
+const uint8_t LINK_QUAD_BOARD[] = {1, 1, 2, 2};
+static_assert(sizeof(LINK_QUAD_BOARD) >= NUM_STRIPS_CONNECTED, "every connected quadrant needs a board");
+#define LINK_SYNC_PIN 12         // leader toggles it: every follower latches its frame
+#define LINK_BAUD 1000000UL
+
 //Contestant Mapping to Quadrants
 enum ContestantQuadrantMapping {
   QUEEN = 0,
@@ -71,39 +135,4 @@ inline const char* modeToString(Mode m) {
 inline const char* modeToString(int m) { return modeToString(static_cast<Mode>(m)); }
 
 // Global variable to track the current state
-extern Mode currentMode;
-
-// Flickering variables for bear face (per-quadrant)
-extern bool flickerActive[NUM_STRIPS_CONNECTED];
-extern unsigned long nextToggleTimePerQuad[NUM_STRIPS_CONNECTED];
-extern bool bearOnPerQuad[NUM_STRIPS_CONNECTED];
-// Per-quadrant steady-on flags (set by CODE_7 + selector or CODE_2 lock)
-extern bool steadyActive[NUM_STRIPS_CONNECTED];
-// Armed state: CODE_8 arms flicker; CODE_PREV triggers it for a quadrant
-extern bool flickerArmed;
-// When true CODE_9 armed: select quadrants to flicker at a faster rate
-extern bool flickerFastArmed;
-// Per-quadrant marker for VERY fast flicker (set by CODE_9 selection)
-extern bool flickerFastPerQuad[NUM_STRIPS_CONNECTED];
-// Per-quadrant fixed-lose flicker flag (activated by CODE_LOSE)
-extern bool flickerLosePerQuad[NUM_STRIPS_CONNECTED];
-// (No single-target quadrant variable; per-quadrant arrays are used)
-// MODE_R3 state: which columns in top-left have been turned white
-extern bool topLeftColumnsWhite[QUAD_COLS];
-// MODE_R3 state: which columns in top-right are white (true) or yellow (false)
-extern bool topRightColumnsWhite[QUAD_COLS];
-// MODE_R3: per-column color state: 0 = BLUE, 1 = GREEN
-extern uint8_t topLeftColumnColor[QUAD_COLS];
-extern uint8_t topRightColumnColor[QUAD_COLS];
-// Random flash arrays (defined in src/main.cpp)
-extern bool randomFlashActive[NUM_STRIPS_CONNECTED * LEDS_PER_QUAD];
-extern uint32_t randomFlashSavedColor[NUM_STRIPS_CONNECTED * LEDS_PER_QUAD];
-extern unsigned long randomFlashEndTime[NUM_STRIPS_CONNECTED * LEDS_PER_QUAD];
-// Lose sequence state (defined in src/main.cpp)
-extern bool loseSequenceActive[NUM_STRIPS_CONNECTED];
-extern int loseSequenceCount[NUM_STRIPS_CONNECTED];
-extern unsigned long loseSequenceNextToggle[NUM_STRIPS_CONNECTED];
-// Armed state: CODE_7 arms a steady-on action for PREV to trigger
-extern bool steadyArmed;
-// When true the bottom-left quadrant stays bright red for the duration of MODE_R2
-extern bool bottomLeftLocked;
\ No newline at end of file
+extern Mode currentMode;
\ No newline at end of file
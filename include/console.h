@@ -0,0 +1,142 @@
+#pragma once
+#include "params.h"
+#include "profiler.h"
+#include "latency.h"
+#include "memstats.h"
+#include "link.h"
+#include "serial_room.h"
+
+// --- SERIAL CONSOLE ---
+// Type commands into the Serial Monitor (ending with Enter) to tune the
+// game while it runs:
+//   list                 show every parameter, its value and range
+//   get <name>           show one parameter
+//   set <name> <value>   change it (takes effect straight away)
+//   save                 keep the current values after a reset
+//   defaults             go back to the built-in values (not saved)
+//   forget               delete the saved values
+//   prof                 loop section timings (LOOP_PROFILER builds only)
+//   prof reset           start the timings again
+//   lat                  input-to-light latency (LATENCY_TRACE builds only)
+//   lat reset            start the latency numbers again
+//   mem                  stack high-water mark and free heap (board only)
+//   link                 multi-board link bandwidth (link leader builds only)
+// consoleService() only reads what has already arrived and prints at most
+// one line of a listing per loop (when the UART has room for it), so typing
+// never holds up the LEDs.
+
+const uint8_t CONSOLE_LINE_LEN = 40;
+// A listing line is only printed once the UART has this much room
+// (serial_room.h), so print() never has to wait for the wire
+const uint8_t CONSOLE_LIST_ROOM = 40;
+
+char consoleLine[CONSOLE_LINE_LEN];
+uint8_t consoleLineLen = 0;
+uint8_t consoleListNext = PARAM_COUNT; // next parameter to print for "list"
+uint8_t consoleProfNext = PROF_SECTIONS; // next section to print for "prof"
+uint8_t consoleLatNext = 0xFF;           // next report line for "lat" (0xFF = none)
+
+void consolePrintParam(const ParamInfo& p) {
+  Serial.print(p.name); Serial.print(" = "); Serial.print(paramGet(p));
+  Serial.print("  ("); Serial.print(p.minValue); Serial.print(".."); Serial.print(p.maxValue);
+  Serial.println(")");
+}
+
+void consoleRun(char* line) {
+  char* cmd = strtok(line, " \t");
+  if (!cmd) return;
+  char* name = strtok(nullptr, " \t");
+  char* value = strtok(nullptr, " \t");
+
+  if (strcmp(cmd, "list") == 0) {
+    consoleListNext = 0; // printed a line at a time by consoleService()
+  } else if (strcmp(cmd, "get") == 0 || strcmp(cmd, "set") == 0) {
+    const ParamInfo* p = name ? paramFind(name) : nullptr;
+    if (!p) {
+      Serial.print("Unknown parameter: "); Serial.println(name ? name : "");
+      return;
+    }
+    if (cmd[0] == 's') {
+      char* end = nullptr;
+      long v = value ? strtol(value, &end, 10) : -1;
+      if (!value || *end != '\0' || !paramSet(*p, v)) {
+        uint16_t lo, hi;
+        paramLimits(*p, lo, hi);
+        Serial.print("Value must be "); Serial.print(lo); Serial.print(".."); Serial.println(hi);
+        return;
+      }
+    }
+    consolePrintParam(*p);
+  } else if (strcmp(cmd, "save") == 0) {
+    Serial.println(paramsSave() ? "Params saved" : "Params: save failed");
+  } else if (strcmp(cmd, "defaults") == 0) {
+    params = PARAM_DEFAULTS;
+    ledsApplyBrightness();
+    Serial.println("Params: defaults (type save to keep them)");
+  } else if (strcmp(cmd, "forget") == 0) {
+    Serial.println(paramsForget() ? "Params: saved values deleted" : "Params: forget failed");
+  } else if (strcmp(cmd, "prof") == 0) {
+#ifdef LOOP_PROFILER
+    if (name && strcmp(name, "reset") == 0) {
+      profReset();
+      Serial.println("Profiler reset");
+    } else {
+      consoleProfNext = 0; // printed a section at a time by consoleService()
+    }
+#else
+    Serial.println("Profiler not built in (use pio run -e profile)");
+#endif
+  } else if (strcmp(cmd, "lat") == 0) {
+#ifdef LATENCY_TRACE
+    if (name && strcmp(name, "reset") == 0) {
+      latencyReset();
+      Serial.println("Latency reset");
+    } else {
+      consoleLatNext = 0; // printed a line at a time by consoleService()
+    }
+#else
+    Serial.println("Latency tracing not built in (use pio run -e latency)");
+#endif
+  } else if (strcmp(cmd, "mem") == 0) {
+    memPrint();
+  } else if (strcmp(cmd, "link") == 0) {
+#if LINK_ROLE == LINK_LEADER
+    linkPrint();
+#else
+    Serial.println("Not a link leader (use pio run -e leader)");
+#endif
+  } else {
+    Serial.print("Unknown command: "); Serial.println(cmd);
+  }
+}
+
+// Call every loop
+void consoleService() {
+  // 1. Collect whatever has arrived (never wait for more)
+  while (Serial.available() > 0) {
+    char c = (char)Serial.read();
+    if (c == '\r') continue;
+    if (c == '\n') {
+      consoleLine[consoleLineLen] = '\0';
+      consoleLineLen = 0;
+      consoleRun(consoleLine);
+      break; // one command per loop
+    }
+    if (consoleLineLen < CONSOLE_LINE_LEN - 1) consoleLine[consoleLineLen++] = c;
+  }
+
+  // 2. Continue a listing
+  if (consoleListNext < PARAM_COUNT && serialRoom() >= CONSOLE_LIST_ROOM) {
+    consolePrintParam(PARAM_TABLE[consoleListNext++]);
+  }
+#ifdef LOOP_PROFILER
+  else if (consoleProfNext < PROF_SECTIONS && serialRoom() >= CONSOLE_LIST_ROOM) {
+    profPrintSection(consoleProfNext++);
+  }
+#endif
+#ifdef LATENCY_TRACE
+  else if (consoleLatNext < LATENCY_REPORT_LINES && serialRoom() >= CONSOLE_LIST_ROOM) {
+    latencyPrintLine(consoleLatNext++);
+  }
+#endif
+}
@@ -0,0 +1,188 @@
+#pragma once
+#include "leds.h"
+#include "modestate.h"
+#include "journal.h"
+#include "rng.h"
+
+// --- MODE_R2 QUADRANT EFFECTS ---
+// Each quadrant has one "effect slot" that says what it is doing right now
+// (steady bear, flickering bear, lose sequence, red X...). The remote arms
+// an effect with CODE_7/8/9 and a selector key (PREV/NEXT/PAUSE) applies it
+// to a quadrant. To add a new effect: add a kind to EffectKind (in
+// modestate.h, next to the slots), say how it starts in effectStart() and
+// what happens on each tick in effectsUpdate().
+
+// The slots live in the mode arena while MODE_R2 runs (see modestate.h)
+QuadEffect* const quadEffects = modeState.r2.effects;
+
+// Timing for each effect lives in params.h (flicker*, fast*, lose*)
+
+inline bool effectIsTimed(uint8_t kind) {
+  return kind == EFFECT_FLICKER || kind == EFFECT_FLICKER_FAST || kind == EFFECT_LOSE;
+}
+
+// The bear used by every MODE_R2 effect: white outline, very dark muddy brown face
+void effectDrawBear(uint8_t q) {
+  drawBearFace(q, strips[0].Color(255, 255, 255), strips[0].Color(15, 8, 0));
+}
+
+// ... painted only, for frames that add to it before their one show()
+void effectPaintBear(uint8_t q) {
+  paintBearFace(q, strips[0].Color(255, 255, 255), strips[0].Color(15, 8, 0));
+}
+
+// Put a slot into a new state without drawing anything
+void effectSetKind(uint8_t q, uint8_t kind) {
+  if (quadEffects[q].kind != kind) journalLogEffect(q, kind);
+  quadEffects[q].kind = kind;
+  quadEffects[q].phase = 0;
+  if (effectIsTimed(kind)) modeState.r2.timedMask |= (1 << q);
+  else modeState.r2.timedMask &= ~(1 << q);
+}
+
+// Start an effect on a quadrant and draw its first frame.
+// A locked quadrant ignores everything except another lock.
+void effectStart(uint8_t q, uint8_t kind) {
+  if (q >= NUM_STRIPS_CONNECTED) return;
+  if (quadEffects[q].kind == EFFECT_LOCKED && kind != EFFECT_LOCKED) return;
+
+  latencyTarget(q);
+  effectSetKind(q, kind);
+  unsigned long now = millis();
+  switch (kind) {
+    case EFFECT_STEADY:
+      effectDrawBear(q);
+      break;
+    case EFFECT_FLICKER:
+      effectDrawBear(q);
+      quadEffects[q].deadline = now + rngRange(params.flickerMinMs, params.flickerMaxMs);
+      break;
+    case EFFECT_FLICKER_FAST:
+      effectDrawBear(q);
+      quadEffects[q].deadline = now + rngRange(params.fastMinMs, params.fastMaxMs);
+      break;
+    case EFFECT_LOSE: {
+      effectPaintBear(q);
+      // If specific white pixels exist in the bear, change them to brown
+      // Coordinates are in quadrant-local (x,y) space.
+      uint32_t whiteCol = strips[q].Color(255, 255, 255);
+      uint32_t brownCol = strips[q].Color(15, 8, 0);
+      const uint8_t brownPixels[3][2] = {{6, 9}, {11, 13}, {12, 14}};
+      for (int i = 0; i < 3; i++) {
+        uint16_t p = bearIndex(brownPixels[i][0], brownPixels[i][1]);
+        if (strips[q].getPixelColor(p) == whiteCol) strips[q].setPixelColor(p, brownCol);
+      }
+      stripShow(q);
+      quadEffects[q].deadline = now + params.loseToggleMs; // first toggle after 50ms
+      break;
+    }
+    case EFFECT_LOST:
+      effectPaintBear(q);
+      paintRedXOver(q);
+      stripShow(q);
+      break;
+    case EFFECT_LOCKED:
+      drawRedX(q);
+      break;
+    default:
+      break;
+  }
+}
+
+// Remember which effect the next selector key should apply (CODE_7/8/9)
+void effectArm(uint8_t kind) {
+  modeState.r2.armed = kind;
+}
+
+// Apply the armed effect to a quadrant (called by the selector keys)
+void effectSelect(uint8_t q) {
+  if (modeState.r2.armed == EFFECT_NONE) return;
+  effectStart(q, modeState.r2.armed);
+}
+
+// Stop every flickering quadrant except `keep`. The bear is left in
+// whatever state it was in; steady and locked quadrants are untouched.
+void effectsStopFlicker(uint8_t keep) {
+  for (int q = 0; q < NUM_STRIPS_CONNECTED; q++) {
+    if (q == keep) continue;
+    uint8_t k = quadEffects[q].kind;
+    if (k == EFFECT_FLICKER || k == EFFECT_FLICKER_FAST) effectSetKind(q, EFFECT_NONE);
+  }
+}
+
+// True if MODE_R2 is running and any quadrant is running the given effect
+bool effectsAnyRunning(uint8_t kind) {
+  if (!modeIsRunning(MODE_R2)) return false;
+  for (int q = 0; q < NUM_STRIPS_CONNECTED; q++) {
+    if (quadEffects[q].kind == kind) return true;
+  }
+  return false;
+}
+
+// One pass over the quadrants with a timed effect: toggle the bear when
+// its deadline passes and schedule the next toggle.
+void effectsUpdate() {
+  if (modeState.r2.timedMask == 0) return; // nothing flickering, nothing to do
+
+  for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) {
+    if (!(modeState.r2.timedMask & (1 << q))) continue;
+    QuadEffect& e = quadEffects[q];
+    unsigned long now = millis();
+    if ((long)(now - e.deadline) < 0) continue;
+
+    // The last lose toggle brings the bear back with the X already over
+    // it: one draw and one show, not the bear and then the X
+    e.phase++;
+    if (e.kind == EFFECT_LOSE && e.phase >= params.loseToggles) {
+      effectStart(q, EFFECT_LOST);
+      continue;
+    }
+
+    // Toggle: even phase = bear visible, odd = quadrant dark
+    if (e.phase % 2 == 0) {
+      effectDrawBear(q);
+    } else {
+      strips[q].clear();
+      stripShow(q);
+    }
+
+    switch (e.kind) {
+      case EFFECT_FLICKER:
+        e.deadline = millis() + rngRange(params.flickerMinMs, params.flickerMaxMs);
+        break;
+      case EFFECT_FLICKER_FAST:
+        e.deadline = millis() + rngRange(params.fastMinMs, params.fastMaxMs);
+        break;
+      case EFFECT_LOSE:
+        // Schedule next toggle exactly 50ms later
+        e.deadline = now + params.loseToggleMs;
+        break;
+    }
+  }
+}
+
+// Enter MODE_R2: blue flash, then bears everywhere except a locked bottom-left
+void round2Enter() {
+  setBlueGradient();
+  stripsLatch();
+  delay(1000);
+  ledsAllOff();
+  // The arena starts zeroed, so every slot is EFFECT_NONE and nothing is armed
+  // Immediately lock and fill bottom-left quadrant bright red for MODE_R2
+  effectStart(Q_BOTTOM_LEFT, EFFECT_LOCKED);
+  // Draw bear face only on the other quadrants
+  for (int q = 0; q < NUM_STRIPS_CONNECTED; q++) {
+    if (q == Q_BOTTOM_LEFT) continue;
+    effectDrawBear(q);
+  }
+}
+
+// Resume MODE_R2 after a reset: skip the blue flash and put every
+// quadrant straight back into the effect it had
+void round2Resume() {
+  for (int q = 0; q < NUM_STRIPS_CONNECTED; q++) {
+    uint8_t kind = journalResumed.r2Kinds[q];
+    if (kind == EFFECT_NONE) effectDrawBear(q);
+    else effectStart(q, kind);
+  }
+}
@@ -0,0 +1,153 @@
+#pragma once
+#include "config.h"
+#include "modestate.h"
+#include "rounds.h"
+#include "effects.h"
+#include "round3.h"
+#include "telemetry.h"
+#include "feed_records.h"
+
+// --- STATE FEED ---
+// What a scoreboard overlay needs, in a form a program can read: the mode,
+// the Round 1 rows, the Round 3 boundary, each quadrant's Round 2 effect,
+// and lose/win moments. feedService() compares the game with what it last
+// sent and writes a small record (feed_records.h) only for what changed.
+// Every FEED_SNAPSHOT_MS it sends everything, so an overlay that starts
+// late (or lost a record) is right again within a couple of seconds.
+// Records are written whole, between the telemetry records (telemetry.h);
+// read them with the decoder: pio run -e decode_feed (see README).
+
+const uint16_t FEED_SNAPSHOT_MS = 2000;
+
+// The fields of the feed, as the board last sent them
+struct FeedGameState {
+  uint8_t mode;
+  uint8_t boundary;
+  uint8_t rows[NUM_STRIPS_CONNECTED];
+  uint8_t effects[NUM_STRIPS_CONNECTED];
+};
+static_assert(NUM_STRIPS_CONNECTED <= FEED_MAX_QUADS, "a snapshot carries at most FEED_MAX_QUADS quadrants");
+
+FeedGameState feedSent;
+bool feedSynced = false;        // false: no snapshot sent since feedBegin()
+uint16_t feedSeq = 0;
+unsigned long feedSnapshotMs = 0; // when the last snapshot went out
+// Events owed to the overlay: set with the record that announces them and
+// kept until the event itself goes out (snapshots don't carry events)
+bool feedWinPending = false;
+uint8_t feedLosePending = 0;     // bit q: quadrant q's lose
+
+// Start over after a reset: seq from 0, snapshot first
+void feedBegin() {
+  feedSynced = false;
+  feedSeq = 0;
+  feedWinPending = false;
+  feedLosePending = 0;
+}
+
+// The game's current values of the feed's fields
+void feedRead(FeedGameState& s) {
+  memset(&s, 0, sizeof(s));
+  s.mode = activeMode;
+  if (activeMode == MODE_R1 || activeMode == MODE_R4) memcpy(s.rows, r1Rows, sizeof(s.rows));
+  if (activeMode == MODE_R3) s.boundary = trackBlueCols();
+  if (activeMode == MODE_R2) {
+    for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) s.effects[q] = quadEffects[q].kind;
+  }
+}
+
+// Send one record, whole, or nothing when the UART hasn't room for it
+// (serial_room.h; no room at all means nothing). Nothing is lost that way:
+// whatever didn't go out still differs, or is still pending, next loop and
+// is sent then.
+bool feedSend(uint8_t type, const uint8_t* body, uint8_t len) {
+  uint8_t record[FEED_HEADER_BYTES + FEED_MAX_BODY + 1];
+  uint8_t size = FEED_HEADER_BYTES + len + 1;
+  if (serialRoom() < size) return false;
+  record[0] = FEED_SYNC;
+  record[1] = (uint8_t)feedSeq;
+  record[2] = (uint8_t)(feedSeq >> 8);
+  record[3] = type;
+  record[4] = len;
+  memcpy(&record[FEED_HEADER_BYTES], body, len);
+  record[FEED_HEADER_BYTES + len] = feedCheck(record, len);
+  Serial.write(record, size);
+  feedSeq++;
+  return true;
+}
+
+bool feedSendPair(uint8_t type, uint8_t a, uint8_t b) {
+  uint8_t body[2] = {a, b};
+  return feedSend(type, body, 2);
+}
+
+void feedSnapshot(const FeedGameState& now) {
+  uint32_t ms = millis();
+  uint8_t body[FEED_SNAPSHOT_FIXED + 2 * NUM_STRIPS_CONNECTED] = {
+    FEED_VERSION, (uint8_t)ms, (uint8_t)(ms >> 8), (uint8_t)(ms >> 16), (uint8_t)(ms >> 24),
+    now.mode, now.boundary, NUM_STRIPS_CONNECTED
+  };
+  memcpy(&body[FEED_SNAPSHOT_FIXED], now.rows, NUM_STRIPS_CONNECTED);
+  memcpy(&body[FEED_SNAPSHOT_FIXED + NUM_STRIPS_CONNECTED], now.effects, NUM_STRIPS_CONNECTED);
+  if (!feedSend(FEED_SNAPSHOT, body, sizeof(body))) return;
+  feedSnapshotMs = millis();
+  feedSent = now;
+  feedSynced = true;
+}
+
+// Send the events still owed. False if one didn't fit.
+bool feedSendEvents() {
+  if (feedWinPending) {
+    if (!feedSendPair(FEED_EVENT, FEED_WIN, FEED_NO_QUAD)) return false;
+    feedWinPending = false;
+  }
+  for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) {
+    if (!(feedLosePending & 1 << q)) continue;
+    if (!feedSendPair(FEED_EVENT, FEED_LOSE, q)) return false;
+    feedLosePending &= ~(1 << q);
+  }
+  return true;
+}
+
+// Send what changed since the last call. Stops at the first record that
+// doesn't fit; the rest goes next loop.
+void feedDeltas(const FeedGameState& now) {
+  if (now.mode != feedSent.mode) {
+    if (!feedSend(FEED_MODE, &now.mode, 1)) return;
+    memset(&feedSent, 0, sizeof(feedSent)); // both ends: a new mode starts from 0
+    feedSent.mode = now.mode;
+    if (now.mode == MODE_FINALE) feedWinPending = true;
+  }
+  if (!feedSendEvents()) return;
+  if (now.boundary != feedSent.boundary) {
+    if (!feedSend(FEED_BOUNDARY, &now.boundary, 1)) return;
+    feedSent.boundary = now.boundary;
+  }
+  for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) {
+    if (now.rows[q] != feedSent.rows[q]) {
+      if (!feedSendPair(FEED_ROWS, q, now.rows[q])) return;
+      feedSent.rows[q] = now.rows[q];
+    }
+    if (now.effects[q] != feedSent.effects[q]) {
+      if (!feedSendPair(FEED_EFFECT, q, now.effects[q])) return;
+      feedSent.effects[q] = now.effects[q];
+      if (now.effects[q] == EFFECT_LOSE) feedLosePending |= 1 << q;
+      if (!feedSendEvents()) return;
+    }
+  }
+}
+
+// Call every loop, after the mode has run and before telemetryService().
+// A mode that hasn't been entered yet still has the old mode's state in
+// the arena: wait for it. Nothing is sent without a Serial Monitor; an
+// overlay that connects later is right after the next snapshot.
+void feedService() {
+  if (!activeModeEntered || !Serial) return;
+  // A telemetry record half sent (the UART was full): finish it first, so
+  // the two never interleave
+  if (telemetryQueued() % TELEMETRY_FRAME_BYTES) return;
+  FeedGameState now;
+  feedRead(now);
+  if (feedSynced) feedDeltas(now);
+  if (!feedSynced || millis() - feedSnapshotMs >= FEED_SNAPSHOT_MS) feedSnapshot(now);
+}
@@ -0,0 +1,152 @@
+#pragma once
+#include <stdio.h>
+#include <string.h>
+#include "feed_records.h"
+
+// --- STATE FEED DECODER (host only) ---
+// Rebuilds the game state from the board's Serial stream (feed.h): feed
+// records update a FeedView, everything else (telemetry records, text) is
+// handed on untouched, so it can go on to the telemetry decoder. The view
+// is only `synced` once a snapshot has arrived and no record went missing
+// since. Used by src/decode_feed.cpp and the host tests.
+
+// What the overlay shows
+struct FeedView {
+  bool synced;          // false: wait for the next snapshot
+  uint8_t mode;         // Mode (config.h)
+  uint8_t boundary;     // Round 3: blue columns
+  uint8_t quads;        // quadrants on the board
+  uint8_t rows[FEED_MAX_QUADS];
+  uint8_t effects[FEED_MAX_QUADS]; // EffectKind (modestate.h)
+  uint32_t snapshotMs;  // board millis() of the last snapshot
+};
+
+struct FeedDecoder {
+  uint8_t record[FEED_HEADER_BYTES + FEED_MAX_BODY + 1];
+  uint16_t have;          // bytes of a possible record collected so far
+  bool seqKnown;
+  uint16_t nextSeq;
+  FeedView view;
+  unsigned long records;  // good records decoded
+  unsigned long bad;      // sync bytes that didn't start a valid record
+  unsigned long lost;     // seq numbers skipped
+  unsigned long badVersion; // snapshots of a version this decoder doesn't know
+};
+
+// Same order as FeedType and FeedEvent in feed_records.h
+const char* const FEED_TYPE_NAMES[FEED_TYPE_COUNT] = {
+  "snapshot", "mode", "rows", "boundary", "effect", "event"
+};
+const char* const FEED_EVENT_NAMES[FEED_EVENT_COUNT] = {"lose", "win"};
+
+// Apply one checked record to the view. False if it is impossible.
+bool feedApply(FeedDecoder& d, uint8_t type, const uint8_t* body, uint8_t len) {
+  FeedView& v = d.view;
+  if (type == FEED_SNAPSHOT) {
+    if (len < FEED_SNAPSHOT_FIXED) return false;
+    if (body[0] != FEED_VERSION) {
+      d.badVersion++;
+      v.synced = false;
+      return true;
+    }
+    uint8_t n = body[7];
+    if (n > FEED_MAX_QUADS || len != FEED_SNAPSHOT_FIXED + 2 * n) return false;
+    memset(&v, 0, sizeof(v));
+    v.snapshotMs = body[1] | body[2] << 8 | body[3] << 16 | (uint32_t)body[4] << 24;
+    v.mode = body[5];
+    v.boundary = body[6];
+    v.quads = n;
+    memcpy(v.rows, &body[FEED_SNAPSHOT_FIXED], n);
+    memcpy(v.effects, &body[FEED_SNAPSHOT_FIXED + n], n);
+    v.synced = true;
+    return true;
+  }
+  switch (type) {
+    case FEED_MODE:
+      if (len != 1) return false;
+      // Same rule as the board: the new mode starts with every field at 0
+      memset(v.rows, 0, sizeof(v.rows));
+      memset(v.effects, 0, sizeof(v.effects));
+      v.boundary = 0;
+      v.mode = body[0];
+      return true;
+    case FEED_BOUNDARY:
+      if (len != 1) return false;
+      v.boundary = body[0];
+      return true;
+    case FEED_ROWS:
+    case FEED_EFFECT:
+      if (len != 2 || body[0] >= FEED_MAX_QUADS) return false;
+      (type == FEED_ROWS ? v.rows : v.effects)[body[0]] = body[1];
+      return true;
+    case FEED_EVENT:
+      return len == 2 && body[0] < FEED_EVENT_COUNT;
+    default:
+      return false;
+  }
+}
+
+// Format one record (no newline)
+void feedDescribe(uint8_t type, const uint8_t* body, uint8_t len, char* out, size_t size) {
+  const char* name = type < FEED_TYPE_COUNT ? FEED_TYPE_NAMES[type] : "?";
+  if (type == FEED_SNAPSHOT && len >= FEED_SNAPSHOT_FIXED) {
+    size_t at = snprintf(out, size, "%-9s v%u mode %u, boundary %u, rows", name, body[0], body[5], body[6]);
+    uint8_t n = body[7];
+    for (uint8_t q = 0; q < n && at < size; q++) at += snprintf(out + at, size - at, " %u", body[FEED_SNAPSHOT_FIXED + q]);
+    if (at < size) at += snprintf(out + at, size - at, ", effects");
+    for (uint8_t q = 0; q < n && at < size; q++) {
+      at += snprintf(out + at, size - at, " %u", body[FEED_SNAPSHOT_FIXED + n + q]);
+    }
+  } else if ((type == FEED_ROWS || type == FEED_EFFECT) && len == 2) {
+    snprintf(out, size, "%-9s quad %u: %u", name, body[0], body[1]);
+  } else if (type == FEED_EVENT && len == 2) {
+    const char* event = body[0] < FEED_EVENT_COUNT ? FEED_EVENT_NAMES[body[0]] : "?";
+    if (body[1] == FEED_NO_QUAD) snprintf(out, size, "%-9s %s", name, event);
+    else snprintf(out, size, "%-9s %s, quad %u", name, event, body[1]);
+  } else {
+    snprintf(out, size, "%-9s %u", name, len ? body[0] : 0);
+  }
+}
+
+// Feed one byte. Each complete record updates d.view, then goes to
+// onRecord(decoder, seq, type, body, len); anything else goes to onOther(byte).
+void feedDecodeByte(FeedDecoder& d, uint8_t c,
+                    void (*onRecord)(const FeedDecoder& d, uint16_t seq, uint8_t type,
+                                     const uint8_t* body, uint8_t len),
+                    void (*onOther)(uint8_t c)) {
+  if (d.have == 0 && c != FEED_SYNC) { onOther(c); return; }
+  d.record[d.have++] = c;
+  if (d.have < FEED_HEADER_BYTES) return;
+  uint8_t len = d.record[4];
+  if (len <= FEED_MAX_BODY && d.have < FEED_HEADER_BYTES + len + 1) return;
+
+  const uint8_t* body = &d.record[FEED_HEADER_BYTES];
+  uint8_t type = d.record[3];
+  if (len <= FEED_MAX_BODY && d.record[FEED_HEADER_BYTES + len] == feedCheck(d.record, len) &&
+      type < FEED_TYPE_COUNT) {
+    uint16_t seq = d.record[1] | d.record[2] << 8;
+    d.have = 0;
+    d.records++;
+    if (d.seqKnown && seq != d.nextSeq) {
+      d.lost += (uint16_t)(seq - d.nextSeq);
+      d.view.synced = false;
+    }
+    d.seqKnown = true;
+    d.nextSeq = seq + 1;
+    if (!feedApply(d, type, body, len)) {
+      d.bad++;
+      d.view.synced = false;
+    }
+    onRecord(d, seq, type, body, len);
+    return;
+  }
+  // Not a record after all: the first byte belongs to someone else, try
+  // again from the next
+  d.bad++;
+  onOther(d.record[0]);
+  uint16_t restLen = d.have - 1;
+  uint8_t rest[sizeof(d.record)];
+  memcpy(rest, d.record + 1, restLen);
+  d.have = 0;
+  for (uint16_t i = 0; i < restLen; i++) feedDecodeByte(d, rest[i], onRecord, onOther);
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <stdint.h>
+
+// --- STATE FEED RECORD FORMAT ---
+// Shared by the game (feed.h) and the host decoder (feed_decode.h), so both
+// always agree on the bytes. The feed shares the Serial stream with the
+// telemetry records and plain text; its own sync byte tells them apart.
+//
+// Every record is:
+//   [0xA6] [seq lo] [seq hi] [type] [len] [len bytes] [check]
+// seq counts every record the board sends (from 0 after a reset), so a
+// gap means something was lost. check is the sum of the bytes before it.
+//
+//   FEED_SNAPSHOT  version, millis (4 bytes LE), mode, R3 boundary,
+//                  quadrant count n, n x R1 rows, n x R2 effect
+//   FEED_MODE      mode: a new mode starts with every other field at 0
+//   FEED_ROWS      quadrant, rows (Round 1 / 4 score)
+//   FEED_BOUNDARY  blue columns on the Round 3 track
+//   FEED_EFFECT    quadrant, EffectKind (Round 2)
+//   FEED_EVENT     FeedEvent, quadrant (FEED_NO_QUAD if none)
+// Rows, boundary and effects are 0 outside the modes they belong to.
+
+const uint8_t FEED_SYNC = 0xA6; // not ASCII, and not the telemetry's 0xA5
+const uint8_t FEED_VERSION = 1;
+const uint8_t FEED_HEADER_BYTES = 5;
+const uint8_t FEED_SNAPSHOT_FIXED = 8; // snapshot body before the per-quadrant bytes
+const uint8_t FEED_MAX_QUADS = 8;
+const uint8_t FEED_MAX_BODY = FEED_SNAPSHOT_FIXED + 2 * FEED_MAX_QUADS;
+const uint8_t FEED_NO_QUAD = 0xFF;
+
+enum FeedType : uint8_t {
+  FEED_SNAPSHOT,
+  FEED_MODE,
+  FEED_ROWS,
+  FEED_BOUNDARY,
+  FEED_EFFECT,
+  FEED_EVENT,
+  FEED_TYPE_COUNT
+};
+
+enum FeedEvent : uint8_t {
+  FEED_LOSE,  // a quadrant started the lose sequence
+  FEED_WIN,   // the finale started
+  FEED_EVENT_COUNT
+};
+
+inline uint8_t feedCheck(const uint8_t* record, uint8_t len) {
+  uint8_t sum = 0;
+  for (uint16_t i = 0; i < FEED_HEADER_BYTES + len; i++) sum += record[i];
+  return sum;
+}
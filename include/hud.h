@@ -0,0 +1,121 @@
+#pragma once
+#include <Arduino_LED_Matrix.h>
+#include "config.h"
+#include "profiler.h"
+
+// --- HEALTH HUD ON THE BOARD'S 12x8 LED MATRIX ---
+// Serial is rarely plugged in during a show, so the UNO R4 WiFi's own LED
+// matrix shows whether the firmware is keeping up:
+//
+//   row 0  M . . . . . . . . . . H   M: one LED at column = currentMode
+//                                    H: heartbeat, flips every update
+//   row 2  F F F F F F F . . . . .   loops per second, one LED per 10
+//   row 4  W W W . . . . . . . . .   worst loop in the last second,
+//                                    one LED per 5 ms started (full = 60+)
+//   row 6  E . . . . . . . . . . .   remote frames that were not a known
+//                                    button, last second
+//   row 7  B B . . . . . . . . . .   beams broken, last second
+//
+// The numbers cover the last second in HUD_SLOTS slices, so the HUD can
+// redraw HUD_SLOTS times a second and still show whole-second figures.
+// hudService() costs one micros() per loop; the redraw itself is a fixed
+// amount of bit twiddling plus loadFrame(), which only copies the 12 bytes
+// (the matrix library lights the LEDs from its own timer interrupt).
+
+const uint8_t HUD_COLS = 12;
+const uint8_t HUD_SLOTS = 4;
+const uint16_t HUD_UPDATE_MS = 1000 / HUD_SLOTS;
+
+const uint8_t HUD_ROW_MODE = 0;
+const uint8_t HUD_ROW_FPS = 2;
+const uint8_t HUD_ROW_WORST = 4;
+const uint8_t HUD_ROW_IR = 6;
+const uint8_t HUD_ROW_BEAMS = 7;
+const uint8_t HUD_FPS_PER_LED = 10;
+const uint8_t HUD_MS_PER_LED = 5;
+
+// Counted by the modules themselves (remote.h, beams.h)
+extern uint16_t remoteBadFrames;
+extern uint16_t beamBreaks;
+
+struct HudSlot {
+  uint16_t loops;
+  uint16_t irBad;
+  uint16_t beams;
+  uint32_t worstUs;
+};
+
+ArduinoLEDMatrix hudMatrix;
+HudSlot hudSlots[HUD_SLOTS];
+uint8_t hudSlot = 0;
+uint32_t hudLastLoopUs = 0;
+unsigned long hudLastUpdateMs = 0;
+uint16_t hudLastIrBad = 0;
+uint16_t hudLastBeams = 0;
+bool hudHeartbeat = false;
+
+void hudBegin() {
+  hudMatrix.begin();
+  memset(hudSlots, 0, sizeof(hudSlots));
+  hudLastLoopUs = micros();
+  hudLastUpdateMs = millis();
+}
+
+// Frames are 96 bits, row by row from the top left, MSB first
+inline void hudPixel(uint32_t frame[3], uint8_t row, uint8_t col) {
+  uint8_t i = row * HUD_COLS + col;
+  frame[i / 32] |= 0x80000000UL >> (i % 32);
+}
+
+// Light the first `n` LEDs of `row` (capped at a full row)
+inline void hudBar(uint32_t frame[3], uint8_t row, uint32_t n) {
+  if (n > HUD_COLS) n = HUD_COLS;
+  for (uint8_t c = 0; c < n; c++) hudPixel(frame, row, c);
+}
+
+// Close the current slice and redraw from the last HUD_SLOTS of them
+void hudUpdate() {
+  HudSlot& now = hudSlots[hudSlot];
+  now.irBad = remoteBadFrames - hudLastIrBad;
+  now.beams = beamBreaks - hudLastBeams;
+  hudLastIrBad = remoteBadFrames;
+  hudLastBeams = beamBreaks;
+
+  HudSlot sum = {0, 0, 0, 0};
+  for (uint8_t s = 0; s < HUD_SLOTS; s++) {
+    sum.loops += hudSlots[s].loops;
+    sum.irBad += hudSlots[s].irBad;
+    sum.beams += hudSlots[s].beams;
+    if (hudSlots[s].worstUs > sum.worstUs) sum.worstUs = hudSlots[s].worstUs;
+  }
+
+  uint32_t frame[3] = {0, 0, 0};
+  hudPixel(frame, HUD_ROW_MODE, currentMode);
+  hudHeartbeat = !hudHeartbeat;
+  if (hudHeartbeat) hudPixel(frame, HUD_ROW_MODE, HUD_COLS - 1);
+  hudBar(frame, HUD_ROW_FPS, sum.loops / HUD_FPS_PER_LED);
+  hudBar(frame, HUD_ROW_WORST, (sum.worstUs + HUD_MS_PER_LED * 1000UL - 1) / (HUD_MS_PER_LED * 1000UL));
+  hudBar(frame, HUD_ROW_IR, sum.irBad);
+  hudBar(frame, HUD_ROW_BEAMS, sum.beams);
+  hudMatrix.loadFrame(frame);
+
+  hudSlot = (hudSlot + 1) % HUD_SLOTS;
+  hudSlots[hudSlot] = {0, 0, 0, 0};
+}
+
+// Call once per loop
+void hudService() {
+  uint32_t us = micros();
+  HudSlot& now = hudSlots[hudSlot];
+  uint32_t frameUs = us - hudLastLoopUs;
+  hudLastLoopUs = us;
+  now.loops++;
+  if (frameUs > now.worstUs) now.worstUs = frameUs;
+
+  unsigned long ms = millis();
+  if (ms - hudLastUpdateMs < HUD_UPDATE_MS) return;
+  hudLastUpdateMs = ms;
+  PROF_BEGIN(PROF_HUD);
+  hudUpdate();
+  PROF_END(PROF_HUD);
+}
@@ -0,0 +1,288 @@
+#pragma once
+#include <DataFlash.h>
+#include "config.h"
+#include "modestate.h"
+
+// --- GAME JOURNAL ---
+// A brownout or a bumped reset button used to drop the board back into
+// MODE_OFF with every score forgotten. Now every mode change and score
+// change is appended to a small log in the data flash, and setup() replays
+// that log so the game comes back on the scene it was showing.
+//
+// How it is stored:
+//  - The journal owns the first JOURNAL_SECTORS blocks of the data flash
+//    and is written as one ring of 4-byte records: [tag][arg][value][check].
+//  - Records are only ever appended, so every byte is written once per lap
+//    around the ring (that's the wear levelling).
+//  - The block after the one being written is always kept erased. On boot
+//    the write position is where that erased gap starts.
+//  - Each block starts with a checkpoint (the full game state), so after
+//    the oldest block is erased the records that remain still describe
+//    everything.
+//  - A checkpoint is written one record per loop, every field first and
+//    the mode last. Its records carry JOURNAL_CHECKPOINT_FLAG, and replay
+//    only takes them once that closing mode record is there: a checkpoint
+//    cut short by a power loss leaves the state before it untouched.
+//  - Erased slots are skipped by a blank check, not by their contents.
+//    A record whose CRC-8 doesn't match (power lost halfway through
+//    writing it) or whose values are out of range is skipped too.
+//
+// Logging never touches the flash directly: records wait in a small queue
+// and journalService() writes at most one record (or erases one block) per
+// call, so the loop never stalls for more than one flash operation.
+
+const uint8_t JOURNAL_SECTORS = 4;  // 4 KB of the 8 KB data flash
+const uint8_t JOURNAL_RECORD_BYTES = 4;
+const uint16_t JOURNAL_RECORDS_PER_SECTOR = DATA_FLASH_BLOCK_BYTES / JOURNAL_RECORD_BYTES;
+const uint16_t JOURNAL_RECORDS = JOURNAL_SECTORS * JOURNAL_RECORDS_PER_SECTOR;
+const uint8_t JOURNAL_QUEUE_LEN = 16;
+
+enum JournalTag : uint8_t {
+  JOURNAL_MODE = 1,     // value = Mode; resets everything below
+  JOURNAL_R1_ROWS,      // arg = quadrant, value = honey rows
+  JOURNAL_R2_EFFECT,    // arg = quadrant, value = EffectKind
+  JOURNAL_R3_BOUNDARY   // value = blue columns on the Round 3 track
+};
+const uint8_t JOURNAL_CHECKPOINT_FLAG = 0x80; // tag bit: part of a checkpoint
+
+// Everything needed to put a scene back after a reset
+struct JournalSnapshot {
+  uint8_t mode;
+  uint8_t r1Rows[NUM_STRIPS_CONNECTED];
+  uint8_t r2Kinds[NUM_STRIPS_CONNECTED];
+  uint8_t r3BlueCols;
+};
+
+// One record per field, mode last
+const uint8_t JOURNAL_CHECKPOINT_RECORDS = 2 + 2 * NUM_STRIPS_CONNECTED;
+
+JournalSnapshot journalState;    // the game as the journal will describe it
+JournalSnapshot journalResumed;  // what the journal said at boot
+bool journalResumePending = false;
+
+uint8_t journalQueue[JOURNAL_QUEUE_LEN][3];
+uint8_t journalQueueHead = 0;
+uint8_t journalQueueCount = 0;
+
+bool journalReady = false;
+uint16_t journalHead = 0;           // next record slot to write
+bool journalEnteringSector = false; // erase work pending for the sector at journalHead
+uint8_t journalCheckpointStep = JOURNAL_CHECKPOINT_RECORDS; // next checkpoint record
+
+// CRC-8 (polynomial 0x07) from 0xFF, so neither an all-zero nor an
+// all-0xFF slot passes as a record
+uint8_t journalCheck(uint8_t tag, uint8_t arg, uint8_t value) {
+  const uint8_t bytes[3] = {tag, arg, value};
+  uint8_t crc = 0xFF;
+  for (uint8_t b : bytes) {
+    crc ^= b;
+    for (uint8_t bit = 0; bit < 8; bit++) crc = crc & 0x80 ? (crc << 1) ^ 0x07 : crc << 1;
+  }
+  return crc;
+}
+
+uint32_t journalSlotOffset(uint16_t slot) {
+  return (uint32_t)slot * JOURNAL_RECORD_BYTES;
+}
+
+// A mode change starts that mode from scratch
+void journalResetMode(JournalSnapshot& s, uint8_t mode) {
+  memset(&s, 0, sizeof(s));
+  s.mode = mode;
+  s.r3BlueCols = QUAD_COLS; // Round 3 starts with the top-left quadrant blue
+}
+
+// Values that don't fit (flash read back wrong) are ignored
+void journalApply(JournalSnapshot& s, uint8_t tag, uint8_t arg, uint8_t value) {
+  switch (tag) {
+    case JOURNAL_MODE:
+      if (value <= MODE_FINALE) journalResetMode(s, value);
+      break;
+    case JOURNAL_R1_ROWS:
+      if (arg < NUM_STRIPS_CONNECTED) s.r1Rows[arg] = value;
+      break;
+    case JOURNAL_R2_EFFECT:
+      if (arg < NUM_STRIPS_CONNECTED && value <= EFFECT_LOCKED) s.r2Kinds[arg] = value;
+      break;
+    case JOURNAL_R3_BOUNDARY:
+      s.r3BlueCols = value;
+      break;
+  }
+}
+
+// Record `i` of the checkpoint describing `s`
+void journalCheckpointRecord(const JournalSnapshot& s, uint8_t i, uint8_t rec[3]) {
+  if (i < NUM_STRIPS_CONNECTED) {
+    rec[0] = JOURNAL_R1_ROWS; rec[1] = i; rec[2] = s.r1Rows[i];
+  } else if (i < 2 * NUM_STRIPS_CONNECTED) {
+    uint8_t q = i - NUM_STRIPS_CONNECTED;
+    rec[0] = JOURNAL_R2_EFFECT; rec[1] = q; rec[2] = s.r2Kinds[q];
+  } else if (i == 2 * NUM_STRIPS_CONNECTED) {
+    rec[0] = JOURNAL_R3_BOUNDARY; rec[1] = 0; rec[2] = s.r3BlueCols;
+  } else {
+    rec[0] = JOURNAL_MODE; rec[1] = 0; rec[2] = s.mode;
+  }
+  rec[0] |= JOURNAL_CHECKPOINT_FLAG;
+}
+
+// Replay of one record. Checkpoint records collect in `staged` and only
+// replace `s` when the closing mode record arrives; any plain record
+// (written after a checkpoint that never finished) drops them.
+void journalReplay(JournalSnapshot& s, JournalSnapshot& staged, bool& staging, const uint8_t rec[3]) {
+  if (!(rec[0] & JOURNAL_CHECKPOINT_FLAG)) {
+    staging = false;
+    journalApply(s, rec[0], rec[1], rec[2]);
+    return;
+  }
+  uint8_t tag = rec[0] & ~JOURNAL_CHECKPOINT_FLAG;
+  if (!staging) {
+    journalResetMode(staged, MODE_OFF);
+    staging = true;
+  }
+  if (tag != JOURNAL_MODE) {
+    journalApply(staged, tag, rec[1], rec[2]);
+  } else if (rec[2] <= MODE_FINALE) {
+    staged.mode = rec[2]; // sets the mode without resetting the fields above
+    s = staged;
+    staging = false;
+  }
+}
+
+// Write a full checkpoint before anything else still queued. The queue is
+// dropped because the checkpoint already contains its effect.
+void journalCheckpoint() {
+  journalCheckpointStep = 0;
+  journalQueueCount = 0;
+}
+
+// Queue a change and apply it to journalState straight away
+void journalLog(uint8_t tag, uint8_t arg, uint8_t value) {
+  journalApply(journalState, tag, arg, value);
+  if (journalQueueCount == JOURNAL_QUEUE_LEN) {
+    // Flash is falling behind: a checkpoint covers everything we drop
+    journalCheckpoint();
+    return;
+  }
+  uint8_t* e = journalQueue[(journalQueueHead + journalQueueCount) % JOURNAL_QUEUE_LEN];
+  e[0] = tag; e[1] = arg; e[2] = value;
+  journalQueueCount++;
+}
+
+void journalLogMode(uint8_t mode) { journalLog(JOURNAL_MODE, 0, mode); }
+void journalLogRows(uint8_t q, uint8_t rows) { journalLog(JOURNAL_R1_ROWS, q, rows); }
+void journalLogEffect(uint8_t q, uint8_t kind) { journalLog(JOURNAL_R2_EFFECT, q, kind); }
+void journalLogBoundary(uint8_t blueCols) { journalLog(JOURNAL_R3_BOUNDARY, 0, blueCols); }
+
+// The write position just moved to the start of a sector: make sure it
+// and the one after it are erased, then open it with a checkpoint
+void journalEnterSector() {
+  journalEnteringSector = true;
+  journalCheckpoint();
+}
+
+void journalWriteRecord(const uint8_t rec[3]) {
+  uint8_t bytes[JOURNAL_RECORD_BYTES] = {rec[0], rec[1], rec[2], journalCheck(rec[0], rec[1], rec[2])};
+  dataFlashWrite(journalSlotOffset(journalHead), bytes, JOURNAL_RECORD_BYTES);
+  journalHead = (journalHead + 1) % JOURNAL_RECORDS;
+  if (journalHead % JOURNAL_RECORDS_PER_SECTOR == 0) journalEnterSector();
+}
+
+// Erase one sector if it isn't blank yet. Returns true if it erased.
+bool journalEraseIfUsed(uint8_t sector) {
+  uint32_t offset = (uint32_t)sector * DATA_FLASH_BLOCK_BYTES;
+  if (dataFlashIsBlank(offset, DATA_FLASH_BLOCK_BYTES)) return false;
+  dataFlashErase(offset, 1);
+  return true;
+}
+
+// Do at most one flash operation. Call every loop while nothing
+// time-critical (like an IR frame) is going on.
+void journalService() {
+  if (!journalReady) return;
+
+  if (journalEnteringSector) {
+    uint8_t sector = journalHead / JOURNAL_RECORDS_PER_SECTOR;
+    if (journalEraseIfUsed(sector)) return;
+    if (journalEraseIfUsed((sector + 1) % JOURNAL_SECTORS)) return;
+    journalEnteringSector = false;
+  }
+
+  uint8_t rec[3];
+  if (journalCheckpointStep < JOURNAL_CHECKPOINT_RECORDS) {
+    journalCheckpointRecord(journalState, journalCheckpointStep++, rec);
+    journalWriteRecord(rec);
+    return;
+  }
+
+  if (journalQueueCount > 0) {
+    memcpy(rec, journalQueue[journalQueueHead], 3);
+    journalQueueHead = (journalQueueHead + 1) % JOURNAL_QUEUE_LEN;
+    journalQueueCount--;
+    journalWriteRecord(rec);
+  }
+}
+
+// Find the write position, replay the journal into journalResumed and
+// decide whether the game should resume. Call once from setup().
+void journalBegin() {
+  journalResetMode(journalState, MODE_OFF);
+  journalQueueCount = 0;
+  journalCheckpointStep = JOURNAL_CHECKPOINT_RECORDS;
+  journalEnteringSector = false;
+  journalResumePending = false;
+  if (!dataFlashBegin()) {
+    Serial.println("Journal: data flash unavailable");
+    return;
+  }
+
+  // 1. The write position is the start of the erased gap: the first blank
+  // slot whose previous slot (going round the ring) is not blank
+  bool prevBlank = dataFlashIsBlank(journalSlotOffset(JOURNAL_RECORDS - 1), JOURNAL_RECORD_BYTES);
+  bool anyUsed = false;
+  journalHead = 0;
+  for (uint16_t slot = 0; slot < JOURNAL_RECORDS; slot++) {
+    bool blank = dataFlashIsBlank(journalSlotOffset(slot), JOURNAL_RECORD_BYTES);
+    if (!blank) anyUsed = true;
+    if (blank && !prevBlank) {
+      journalHead = slot;
+      break;
+    }
+    prevBlank = blank;
+  }
+
+  // 2. Replay from the oldest record (just after the gap) to the newest
+  uint16_t replayed = 0;
+  JournalSnapshot staged;
+  bool staging = false;
+  for (uint16_t i = 0; i < JOURNAL_RECORDS; i++) {
+    uint16_t slot = (journalHead + i) % JOURNAL_RECORDS;
+    if (dataFlashIsBlank(journalSlotOffset(slot), JOURNAL_RECORD_BYTES)) continue;
+    uint8_t rec[JOURNAL_RECORD_BYTES];
+    dataFlashRead(journalSlotOffset(slot), rec, JOURNAL_RECORD_BYTES);
+    if (rec[3] != journalCheck(rec[0], rec[1], rec[2])) continue; // torn
+    journalReplay(journalState, staged, staging, rec);
+    replayed++;
+  }
+
+  // 3. Only append onto blank flash. If the rest of this sector isn't blank
+  // (an erase was cut short), move on to the next sector.
+  uint16_t sectorEnd = (journalHead / JOURNAL_RECORDS_PER_SECTOR + 1) * JOURNAL_RECORDS_PER_SECTOR;
+  uint32_t tailBytes = journalSlotOffset(sectorEnd) - journalSlotOffset(journalHead);
+  if (!anyUsed) {
+    journalHead = 0; // factory-blank flash: start a fresh journal
+    journalEnterSector();
+  } else if (!dataFlashIsBlank(journalSlotOffset(journalHead), tailBytes)) {
+    journalHead = sectorEnd % JOURNAL_RECORDS;
+    journalEnterSector();
+  } else if (journalHead % JOURNAL_RECORDS_PER_SECTOR == 0) {
+    journalEnterSector(); // cut off before the sector was opened
+  }
+  journalReady = true;
+
+  Serial.print("Journal: "); Serial.print(replayed); Serial.print(" records, last mode ");
+  Serial.println(modeToString((Mode)journalState.mode));
+  if (journalState.mode != MODE_OFF) {
+    journalResumed = journalState;
+    journalResumePending = true;
+  }
+}
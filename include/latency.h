@@ -0,0 +1,236 @@
+#pragma once
+#include "config.h"
+#include "telemetry.h"
+
+// --- INPUT-TO-LIGHT LATENCY TRACING ---
+// How long does it take from a ball breaking a beam, or a remote button,
+// until the LEDs actually change? Every input opens a trace with its own
+// ID, and the trace collects a timestamp (micros) at each stage:
+//
+//   input    beam: the last loop that still saw the beam clear (the ball
+//            broke it somewhere after that). IR: decode() had a frame.
+//   seen     beam: beamBroken() noticed it. IR: after readRemote()'s
+//            settle delay.
+//   applied  the game changed what a quadrant should show (a point, an
+//            effect, a boundary move, or the new mode being entered once
+//            the remote is quiet)
+//   first    the first of those quadrants finished show()
+//   last     the last of them finished show() (the input is fully visible)
+//
+// The stages map onto "where did the time go": input->seen is loop
+// position (beam) or the settle delay (IR), seen->applied is the isIdle()
+// gating before a mode is entered, applied->first is waiting for show(),
+// first->last is show ordering across quadrants. Type "lat" in the Serial
+// Monitor for min/avg/max per stage and a histogram of the total per input
+// type, "lat reset" to start again.
+//
+// Only built in when LATENCY_TRACE is defined (pio run -e latency); in
+// other builds every latency*() call below is an empty inline function.
+
+enum LatencyInput : uint8_t { LAT_BEAM, LAT_IR, LAT_INPUTS };
+enum LatencyStage : uint8_t { LAT_POLL, LAT_GATE, LAT_SHOW, LAT_ORDER, LAT_TOTAL, LAT_STAGES };
+
+#ifdef LATENCY_TRACE
+
+// Traces still waiting for their show(). Inputs that never change the
+// LEDs are dropped when their handler finishes; anything older than
+// LATENCY_TIMEOUT_US is given up on and counted.
+const uint8_t LATENCY_SLOTS = 8;
+const uint32_t LATENCY_TIMEOUT_US = 2000000UL;
+const uint8_t LATENCY_NONE = 0xFF;
+// Histogram of the total in ms: bucket b is "under 2^b ms", the last one
+// everything from 2^9 ms = 512 ms up (printed as ">=512")
+const uint8_t LATENCY_BUCKETS = 11;
+
+struct LatencyTrace {
+  uint16_t id;         // 0 = slot free
+  uint8_t input;       // LatencyInput
+  uint8_t pending;     // quadrants that still have to show the change
+  uint32_t inputUs, seenUs, appliedUs, firstUs;
+};
+static_assert(NUM_STRIPS_CONNECTED <= 8, "LatencyTrace::pending has one bit per quadrant");
+
+struct LatencyStats {
+  uint32_t count;
+  uint32_t timeouts;
+  uint32_t minUs[LAT_STAGES];
+  uint32_t maxUs[LAT_STAGES];
+  uint64_t totalUs[LAT_STAGES];
+  uint32_t buckets[LATENCY_BUCKETS];
+};
+
+LatencyTrace latencyTraces[LATENCY_SLOTS];
+LatencyStats latencyStats[LAT_INPUTS];
+uint16_t latencyNextId = 1;
+uint8_t latencyCurrent = LATENCY_NONE;   // trace the running code belongs to
+uint8_t latencyModeSlot = LATENCY_NONE;  // trace waiting for its mode to be entered
+uint32_t latencyBeamClear[NUM_STRIPS_CONNECTED];  // last poll that saw each beam clear
+
+const char* const LATENCY_INPUT_NAMES[LAT_INPUTS] = {"beam", "ir"};
+const char* const LATENCY_STAGE_NAMES[LAT_STAGES] = {"poll", "gate", "show", "order", "total"};
+
+void latencyReset() {
+  memset(latencyStats, 0, sizeof(latencyStats));
+  for (uint8_t i = 0; i < LAT_INPUTS; i++) {
+    for (uint8_t s = 0; s < LAT_STAGES; s++) latencyStats[i].minUs[s] = UINT32_MAX;
+  }
+}
+
+void latencyFree(uint8_t slot) {
+  if (slot == LATENCY_NONE) return;
+  latencyTraces[slot].id = 0;
+  if (latencyCurrent == slot) latencyCurrent = LATENCY_NONE;
+  if (latencyModeSlot == slot) latencyModeSlot = LATENCY_NONE;
+}
+
+// Start a trace for an input that arrived at `inputUs`. It becomes the
+// current trace until latencyClose().
+void latencyOpen(uint8_t input, uint32_t inputUs) {
+  uint32_t now = micros();
+  uint8_t slot = LATENCY_NONE;
+  for (uint8_t i = 0; i < LATENCY_SLOTS; i++) {
+    LatencyTrace& t = latencyTraces[i];
+    if (t.id && now - t.inputUs > LATENCY_TIMEOUT_US) {
+      latencyStats[t.input].timeouts++;
+      latencyFree(i);
+    }
+    if (!t.id && slot == LATENCY_NONE) slot = i;
+  }
+  latencyCurrent = slot;
+  if (slot == LATENCY_NONE) return; // all busy: this input goes untraced
+  latencyTraces[slot] = {latencyNextId++, input, 0, inputUs, now, 0, 0};
+  if (latencyNextId == 0) latencyNextId = 1;
+}
+
+// The current trace's input has been read (after the IR settle delay)
+void latencySeen() {
+  if (latencyCurrent != LATENCY_NONE) latencyTraces[latencyCurrent].seenUs = micros();
+}
+
+// The current trace changed what quadrant q should show
+void latencyTarget(uint8_t q) {
+  if (latencyCurrent == LATENCY_NONE) return;
+  LatencyTrace& t = latencyTraces[latencyCurrent];
+  if (!t.appliedUs) t.appliedUs = micros();
+  t.pending |= 1 << q;
+}
+
+// The input handler is done. A trace that didn't touch any quadrant has
+// nothing to wait for and is dropped.
+void latencyClose() {
+  if (latencyCurrent == LATENCY_NONE) return;
+  if (!latencyTraces[latencyCurrent].pending && latencyCurrent != latencyModeSlot) latencyFree(latencyCurrent);
+  latencyCurrent = LATENCY_NONE;
+}
+
+// The current trace switched modes: it continues when the mode is entered
+void latencyHoldForMode() {
+  if (latencyCurrent == LATENCY_NONE) return;
+  latencyFree(latencyModeSlot); // an earlier switch that never got entered
+  latencyModeSlot = latencyCurrent;
+}
+
+// modesUpdate() is about to enter the new mode, which redraws every
+// quadrant. Call latencyClose() after the enter hook.
+void latencyModeEntering() {
+  latencyCurrent = latencyModeSlot;
+  latencyModeSlot = LATENCY_NONE;
+  for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) latencyTarget(q);
+}
+
+// Remember when beam i was last seen clear (call on every poll)
+void latencyBeamPoll(uint8_t i, bool broken) {
+  if (!broken) latencyBeamClear[i] = micros();
+}
+uint32_t latencyBeamClearUs(uint8_t i) { return latencyBeamClear[i]; }
+
+void latencyRecord(LatencyStats& st, uint8_t stage, uint32_t us) {
+  if (us < st.minUs[stage]) st.minUs[stage] = us;
+  if (us > st.maxUs[stage]) st.maxUs[stage] = us;
+  st.totalUs[stage] += us;
+}
+
+// Strip q has just finished show(): every trace waiting on it is one
+// quadrant closer to done
+void latencyShown(uint8_t q) {
+  uint32_t now = micros();
+  for (uint8_t i = 0; i < LATENCY_SLOTS; i++) {
+    LatencyTrace& t = latencyTraces[i];
+    if (!t.id || !(t.pending & (1 << q))) continue;
+    t.pending &= ~(1 << q);
+    if (!t.firstUs) t.firstUs = now;
+    if (t.pending) continue;
+
+    LatencyStats& st = latencyStats[t.input];
+    st.count++;
+    latencyRecord(st, LAT_POLL, t.seenUs - t.inputUs);
+    latencyRecord(st, LAT_GATE, t.appliedUs - t.seenUs);
+    latencyRecord(st, LAT_SHOW, t.firstUs - t.appliedUs);
+    latencyRecord(st, LAT_ORDER, now - t.firstUs);
+    uint32_t totalUs = now - t.inputUs;
+    latencyRecord(st, LAT_TOTAL, totalUs);
+    uint32_t ms = totalUs / 1000;
+    uint8_t b = ms ? 32 - __builtin_clz(ms) : 0;
+    st.buckets[b < LATENCY_BUCKETS ? b : LATENCY_BUCKETS - 1]++;
+    LOG_DEBUG(TEV_LATENCY, ms > 0xFFFF ? 0xFFFF : ms);
+    latencyFree(i); // also ends it as the current trace: later draws don't count
+  }
+}
+
+void latencyPrintMs(uint64_t us) {
+  Serial.print((unsigned long)(us / 1000));
+  Serial.print('.');
+  Serial.print((unsigned long)(us / 100 % 10));
+}
+
+// Two lines per input type (line 0/1 = beam, 2/3 = IR):
+//   beam n=12 timeouts=0 total ms: min 3.1 avg 9.8 max 21.0 | <4:2 <16:9 <32:1
+//   beam stages avg/max ms: poll 5.0/10.1 gate 0.0/0.0 show 0.1/0.2 order 0.0/0.0
+const uint8_t LATENCY_REPORT_LINES = 2 * LAT_INPUTS;
+
+void latencyPrintLine(uint8_t line) {
+  const LatencyStats& st = latencyStats[line / 2];
+  Serial.print(LATENCY_INPUT_NAMES[line / 2]);
+  if (line % 2 == 0) {
+    Serial.print(" n="); Serial.print((unsigned long)st.count);
+    Serial.print(" timeouts="); Serial.print((unsigned long)st.timeouts);
+    if (st.count) {
+      Serial.print(" total ms: min "); latencyPrintMs(st.minUs[LAT_TOTAL]);
+      Serial.print(" avg "); latencyPrintMs(st.totalUs[LAT_TOTAL] / st.count);
+      Serial.print(" max "); latencyPrintMs(st.maxUs[LAT_TOTAL]);
+      Serial.print(" |");
+      for (uint8_t b = 0; b < LATENCY_BUCKETS; b++) {
+        if (!st.buckets[b]) continue;
+        Serial.print(b == LATENCY_BUCKETS - 1 ? " >=" : " <");
+        Serial.print(1UL << (b == LATENCY_BUCKETS - 1 ? b - 1 : b));
+        Serial.print(':'); Serial.print((unsigned long)st.buckets[b]);
+      }
+    }
+  } else {
+    Serial.print(" stages avg/max ms:");
+    for (uint8_t s = 0; s < LAT_TOTAL && st.count; s++) {
+      Serial.print(' '); Serial.print(LATENCY_STAGE_NAMES[s]); Serial.print(' ');
+      latencyPrintMs(st.totalUs[s] / st.count);
+      Serial.print('/');
+      latencyPrintMs(st.maxUs[s]);
+    }
+  }
+  Serial.println();
+}
+
+void latencyBegin() { latencyReset(); }
+
+#else
+
+inline void latencyBegin() {}
+inline void latencyOpen(uint8_t, uint32_t) {}
+inline void latencySeen() {}
+inline void latencyTarget(uint8_t) {}
+inline void latencyClose() {}
+inline void latencyHoldForMode() {}
+inline void latencyModeEntering() {}
+inline void latencyBeamPoll(uint8_t, bool) {}
+inline uint32_t latencyBeamClearUs(uint8_t) { return 0; }
+inline void latencyShown(uint8_t) {}
+
+#endif
@@ -1,42 +1,84 @@
 #pragma once
 #include <Adafruit_NeoPixel.h>
 #include "config.h"
+#include "params.h"
+#include "profiler.h"
+#include "latency.h"
+
+// One LED strip per quadrant, for however many quadrants there are. The
+// pixel buffers still come from the NeoPixel library (updateLength()
+// allocates them), once, when stripsConfigure() first runs.
+Adafruit_NeoPixel strips[NUM_STRIPS_CONNECTED];
+
+// Size and wire up every strip, the same as constructing each with its
+// length and pin. ledsBegin() (and a link follower) call this first, so it
+// doesn't depend on the order globals are built in. Calling it again
+// keeps the buffers it already has.
+void stripsConfigure() {
+  for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) {
+    if (strips[q].numPixels() == LEDS_PER_QUAD) continue;
+    strips[q].updateType(NEO_GRB + NEO_KHZ800);
+    strips[q].updateLength(LEDS_PER_QUAD);
+    strips[q].setPin(LED_PINS[q]);
+  }
+}
+
+#if LINK_ROLE == LINK_LEADER
+// Other boards drive the LEDs (link.h)
+void linkQueue(uint8_t q);
+void linkLatch();
+#endif
+
+// Push strip q's buffer to the LEDs. Every show() in the game goes through
+// here so the profiler can time each strip and latency.h knows when a
+// change became visible. On a link leader the strip goes out with the
+// next frame instead (link.h).
+void stripShow(uint8_t q) {
+#if LINK_ROLE == LINK_LEADER
+  linkQueue(q);
+#else
+  PROF_BEGIN(PROF_SHOW);
+  strips[q].show();
+  PROF_END_AT(PROF_SHOW, q);
+  latencyShown(q);
+#endif
+}
 
-// Define the 4 LED strips
-Adafruit_NeoPixel strips[4] = {
-  Adafruit_NeoPixel(LEDS_PER_QUAD, LED_PINS[0], NEO_GRB + NEO_KHZ800),
-  Adafruit_NeoPixel(LEDS_PER_QUAD, LED_PINS[1], NEO_GRB + NEO_KHZ800),
-  Adafruit_NeoPixel(LEDS_PER_QUAD, LED_PINS[2], NEO_GRB + NEO_KHZ800),
-  Adafruit_NeoPixel(LEDS_PER_QUAD, LED_PINS[3], NEO_GRB + NEO_KHZ800)
-};
+// Make everything drawn so far visible now, before the game pauses with it
+// on screen. stripShow() already did on a single board; a link leader
+// sends the frame to its followers here.
+void stripsLatch() {
+#if LINK_ROLE == LINK_LEADER
+  linkLatch();
+#endif
+}
 
 void ledsBegin() {
+  stripsConfigure();
   for (int i = 0; i < NUM_STRIPS_CONNECTED; i++) {
     strips[i].begin();
-    strips[i].setBrightness(BRIGHTNESS);
+    strips[i].setBrightness(params.brightness);
     strips[i].clear(); // Clear all pixels to 'off' in the buffer
-    strips[i].show();  // Now send the cleared buffer to the strip
+    stripShow(i);  // Now send the cleared buffer to the strip
   }
   Serial.println("LEDs: System Ready");
 }
 
+// Apply params.brightness to what's on the strips right now (console "set")
+void ledsApplyBrightness() {
+  for (int i = 0; i < NUM_STRIPS_CONNECTED; i++) {
+    strips[i].setBrightness(params.brightness);
+    stripShow(i);
+  }
+}
+
 // Helper: Converts X,Y coordinates to the LED index number.
 // ASSUMPTION: Pixel 0 is at Bottom-Left.
 // Even Rows (0, 2, 4...) run Left -> Right.
 // Odd Rows (1, 3, 5...) run Right -> Left.
+// The map itself is Panel::index() (config.h); out-of-range requests map to 0.
 uint16_t xyToIndex(uint8_t x, uint8_t y) {
-  // Safety: out-of-range requests map to 0
-  if (x >= QUAD_COLS || y >= QUAD_ROWS) return 0;
-
-  if (y % 2 == 0) {
-    // Left to Right: usable columns map to physical cols 0..(QUAD_COLS-1)
-    return (uint16_t)y * PHYS_COLS + x;
-  } else {
-    // Right to Left: usable columns map to physical cols reversed
-    // We avoid the physical "turn" LED at column (PHYS_COLS-1), so
-    // map usable x=0..(QUAD_COLS-1) to physical columns (PHYS_COLS-2)..0
-    return (uint16_t)y * PHYS_COLS + (PHYS_COLS - 2 - x);
-  }
+  return Panel::index(x, y);
 }
 
 // Turns on 'rows' amount of LEDs from the bottom up.
@@ -56,7 +98,7 @@ void drawProgress(uint8_t q, uint8_t rows, uint32_t color) {
       strips[q].setPixelColor(idx, color);
     }
   }
-  strips[q].show();
+  stripShow(q);
 }
 
 // Fills the whole quadrant with one color
@@ -69,7 +111,7 @@ void fillQuad(uint8_t q, uint32_t color) {
       strips[q].setPixelColor(idx, color);
     }
   }
-  strips[q].show();
+  stripShow(q);
 }
 
 // Draws a jar border with interior fill in a single pass (no flashing)
@@ -120,7 +162,7 @@ void drawJarWithProgress(uint8_t q, uint8_t rows, uint32_t borderColor, uint8_t
       }
     }
   
-  strips[q].show(); // Show once at the end
+  stripShow(q); // Show once at the end
 }
 
 // Draws a jar border: Left, Right, and Bottom sides with 2-column thickness
@@ -154,7 +196,7 @@ void drawJarBorder(uint8_t q, uint32_t borderColor) {
     }
   }
   
-  strips[q].show();
+  stripShow(q);
 }
 
 // Fills the interior of the jar (excluding the border) from bottom up
@@ -177,23 +219,53 @@ void drawProgressInterior(uint8_t q, uint8_t rows, uint32_t color) {
     }
   }
   
-  strips[q].show();
+  stripShow(q);
+}
+
+// Paints one interior row of the jar (columns 2-15, `row` rows above the
+// bottom border) and nothing else. Used to grow the honey one row at a
+// time without repainting the border. Call show() yourself afterwards.
+void drawJarRow(uint8_t q, uint8_t row, uint32_t color) {
+  if (q >= NUM_STRIPS_CONNECTED) return;
+  uint8_t y = 2 + row;
+  if (y >= QUAD_ROWS) return;
+  for (uint8_t x = 2; x < QUAD_COLS - 2; x++) {
+    strips[q].setPixelColor(xyToIndex(x, y), color);
+  }
+}
+
+// Paints usable column x of quadrant q, bottom to top. On the serpentine
+// strip a column is two strided runs (even rows from row 0, odd rows
+// mirrored from row 1), so this walks the strip directly instead of calling
+// xyToIndex() per pixel. Call show() yourself afterwards.
+void drawColumn(uint8_t q, uint8_t x, uint32_t color) {
+  if (q >= NUM_STRIPS_CONNECTED || x >= QUAD_COLS) return;
+  const uint16_t stride = 2 * PHYS_COLS;
+  const uint16_t end = QUAD_ROWS * PHYS_COLS;
+  for (uint16_t i = Panel::index(x, 0); i < end; i += stride) {
+    strips[q].setPixelColor(i, color);
+  }
+  if (QUAD_ROWS < 2) return;
+  for (uint16_t i = Panel::index(x, 1); i < end; i += stride) {
+    strips[q].setPixelColor(i, color);
+  }
 }
 
 void ledsAllOff() {
   // ATTEMPT 1: Clear the buffer and push
   for(int i=0; i<NUM_STRIPS_CONNECTED; i++) {
     strips[i].clear();
-    strips[i].show();
+    stripShow(i);
   }
 
   // CRITICAL DELAY: Give the IR library time to finish its interrupt
+  stripsLatch();
   delay(50); 
 
   // ATTEMPT 2: Force it again (The "Cleanup" pass)
   for(int i=0; i<NUM_STRIPS_CONNECTED; i++) {
     strips[i].clear();
-    strips[i].show();
+    stripShow(i);
   }
 }
 
@@ -208,213 +280,247 @@ void setBlueGradient() {
         strips[q].setPixelColor(idx, color);
       }
     }
-    strips[q].show();
+    stripShow(q);
   }
 }
 
-// Draws the outline of a bear's face in the specified color
-void drawBearFace(uint8_t q, uint32_t outlineColor, uint32_t fillColor) {
+// The bear is drawn on an 18x18 grid; a bigger panel gets it centred
+const uint8_t BEAR_ART_SIZE = 18;
+static_assert(QUAD_COLS >= BEAR_ART_SIZE && QUAD_ROWS >= BEAR_ART_SIZE, "the bear needs an 18x18 panel or bigger");
+const uint8_t BEAR_X0 = (QUAD_COLS - BEAR_ART_SIZE) / 2;
+const uint8_t BEAR_Y0 = (QUAD_ROWS - BEAR_ART_SIZE) / 2;
+
+// Strip index of pixel (x, y) of the bear art
+inline uint16_t bearIndex(uint8_t x, uint8_t y) {
+  return Panel::index(BEAR_X0 + x, BEAR_Y0 + y);
+}
+
+// Paints the outline of a bear's face in the specified color over a
+// cleared quadrant. Call show() yourself afterwards.
+void paintBearFace(uint8_t q, uint32_t outlineColor, uint32_t fillColor) {
   if (q >= NUM_STRIPS_CONNECTED) return;
   
   strips[q].clear();
   
   // Define bear face outline coordinates (x, y)
   // Eyes
-  strips[q].setPixelColor(xyToIndex(6, 11), outlineColor);
-  strips[q].setPixelColor(xyToIndex(10, 11), outlineColor);
+  strips[q].setPixelColor(bearIndex(6, 11), outlineColor);
+  strips[q].setPixelColor(bearIndex(10, 11), outlineColor);
   
   // Nose (triangle)
-  strips[q].setPixelColor(xyToIndex(7, 8), outlineColor);
-  strips[q].setPixelColor(xyToIndex(8, 8), outlineColor);
-  strips[q].setPixelColor(xyToIndex(9, 8), outlineColor);
-  strips[q].setPixelColor(xyToIndex(7, 9), outlineColor);
-  strips[q].setPixelColor(xyToIndex(9, 9), outlineColor);
-  strips[q].setPixelColor(xyToIndex(8, 7), outlineColor);
-  strips[q].setPixelColor(xyToIndex(8, 6), outlineColor);
-  strips[q].setPixelColor(xyToIndex(7, 5), outlineColor);
-  strips[q].setPixelColor(xyToIndex(9, 5), outlineColor);
-  strips[q].setPixelColor(xyToIndex(6, 9), outlineColor);
-  strips[q].setPixelColor(xyToIndex(10, 9), outlineColor);
+  strips[q].setPixelColor(bearIndex(7, 8), outlineColor);
+  strips[q].setPixelColor(bearIndex(8, 8), outlineColor);
+  strips[q].setPixelColor(bearIndex(9, 8), outlineColor);
+  strips[q].setPixelColor(bearIndex(7, 9), outlineColor);
+  strips[q].setPixelColor(bearIndex(9, 9), outlineColor);
+  strips[q].setPixelColor(bearIndex(8, 7), outlineColor);
+  strips[q].setPixelColor(bearIndex(8, 6), outlineColor);
+  strips[q].setPixelColor(bearIndex(7, 5), outlineColor);
+  strips[q].setPixelColor(bearIndex(9, 5), outlineColor);
+  strips[q].setPixelColor(bearIndex(6, 9), outlineColor);
+  strips[q].setPixelColor(bearIndex(10, 9), outlineColor);
 
   // Ears
-  strips[q].setPixelColor(xyToIndex(3, 13), outlineColor);
-  strips[q].setPixelColor(xyToIndex(4, 12), outlineColor);
-  strips[q].setPixelColor(xyToIndex(5, 13), outlineColor);
-  strips[q].setPixelColor(xyToIndex(4, 13), outlineColor);
-  strips[q].setPixelColor(xyToIndex(4, 14), outlineColor);
-  strips[q].setPixelColor(xyToIndex(12, 12), outlineColor);
-  strips[q].setPixelColor(xyToIndex(12, 13), outlineColor);
-  strips[q].setPixelColor(xyToIndex(13, 13), outlineColor);
-  strips[q].setPixelColor(xyToIndex(11, 13), outlineColor);
-  strips[q].setPixelColor(xyToIndex(12, 14), outlineColor);
+  strips[q].setPixelColor(bearIndex(3, 13), outlineColor);
+  strips[q].setPixelColor(bearIndex(4, 12), outlineColor);
+  strips[q].setPixelColor(bearIndex(5, 13), outlineColor);
+  strips[q].setPixelColor(bearIndex(4, 13), outlineColor);
+  strips[q].setPixelColor(bearIndex(4, 14), outlineColor);
+  strips[q].setPixelColor(bearIndex(12, 12), outlineColor);
+  strips[q].setPixelColor(bearIndex(12, 13), outlineColor);
+  strips[q].setPixelColor(bearIndex(13, 13), outlineColor);
+  strips[q].setPixelColor(bearIndex(11, 13), outlineColor);
+  strips[q].setPixelColor(bearIndex(12, 14), outlineColor);
 
   // Bottom of face
-  strips[q].setPixelColor(xyToIndex(5, 2), outlineColor);
-  strips[q].setPixelColor(xyToIndex(6, 2), outlineColor);
-  strips[q].setPixelColor(xyToIndex(7, 2), outlineColor);
-  strips[q].setPixelColor(xyToIndex(8, 2), outlineColor);
-  strips[q].setPixelColor(xyToIndex(9, 2), outlineColor);
-  strips[q].setPixelColor(xyToIndex(10, 2), outlineColor);
-  strips[q].setPixelColor(xyToIndex(11, 2), outlineColor);
+  strips[q].setPixelColor(bearIndex(5, 2), outlineColor);
+  strips[q].setPixelColor(bearIndex(6, 2), outlineColor);
+  strips[q].setPixelColor(bearIndex(7, 2), outlineColor);
+  strips[q].setPixelColor(bearIndex(8, 2), outlineColor);
+  strips[q].setPixelColor(bearIndex(9, 2), outlineColor);
+  strips[q].setPixelColor(bearIndex(10, 2), outlineColor);
+  strips[q].setPixelColor(bearIndex(11, 2), outlineColor);
 
   //Left Side
-  strips[q].setPixelColor(xyToIndex(4, 3), outlineColor);
-  strips[q].setPixelColor(xyToIndex(3, 4), outlineColor);
-  strips[q].setPixelColor(xyToIndex(2, 5), outlineColor);
-  strips[q].setPixelColor(xyToIndex(1, 6), outlineColor);
-  strips[q].setPixelColor(xyToIndex(1, 7), outlineColor);
-  strips[q].setPixelColor(xyToIndex(1, 8), outlineColor);
-  strips[q].setPixelColor(xyToIndex(1, 9), outlineColor);
-  strips[q].setPixelColor(xyToIndex(2, 10), outlineColor);
-  strips[q].setPixelColor(xyToIndex(2, 11), outlineColor);
-  strips[q].setPixelColor(xyToIndex(1, 12), outlineColor);
-  strips[q].setPixelColor(xyToIndex(1, 13), outlineColor);
-  strips[q].setPixelColor(xyToIndex(1, 14), outlineColor);
-  strips[q].setPixelColor(xyToIndex(2, 15), outlineColor);
-  strips[q].setPixelColor(xyToIndex(3, 16), outlineColor);
-  strips[q].setPixelColor(xyToIndex(4, 16), outlineColor);
-  strips[q].setPixelColor(xyToIndex(5, 16), outlineColor);
-  strips[q].setPixelColor(xyToIndex(6, 15), outlineColor);
-  strips[q].setPixelColor(xyToIndex(7, 14), outlineColor);
+  strips[q].setPixelColor(bearIndex(4, 3), outlineColor);
+  strips[q].setPixelColor(bearIndex(3, 4), outlineColor);
+  strips[q].setPixelColor(bearIndex(2, 5), outlineColor);
+  strips[q].setPixelColor(bearIndex(1, 6), outlineColor);
+  strips[q].setPixelColor(bearIndex(1, 7), outlineColor);
+  strips[q].setPixelColor(bearIndex(1, 8), outlineColor);
+  strips[q].setPixelColor(bearIndex(1, 9), outlineColor);
+  strips[q].setPixelColor(bearIndex(2, 10), outlineColor);
+  strips[q].setPixelColor(bearIndex(2, 11), outlineColor);
+  strips[q].setPixelColor(bearIndex(1, 12), outlineColor);
+  strips[q].setPixelColor(bearIndex(1, 13), outlineColor);
+  strips[q].setPixelColor(bearIndex(1, 14), outlineColor);
+  strips[q].setPixelColor(bearIndex(2, 15), outlineColor);
+  strips[q].setPixelColor(bearIndex(3, 16), outlineColor);
+  strips[q].setPixelColor(bearIndex(4, 16), outlineColor);
+  strips[q].setPixelColor(bearIndex(5, 16), outlineColor);
+  strips[q].setPixelColor(bearIndex(6, 15), outlineColor);
+  strips[q].setPixelColor(bearIndex(7, 14), outlineColor);
 
 
   //Right Side
-  strips[q].setPixelColor(xyToIndex(12, 3), outlineColor);
-  strips[q].setPixelColor(xyToIndex(13, 4), outlineColor);
-  strips[q].setPixelColor(xyToIndex(14, 5), outlineColor);
-  strips[q].setPixelColor(xyToIndex(15, 6), outlineColor);
-  strips[q].setPixelColor(xyToIndex(15, 7), outlineColor);
-  strips[q].setPixelColor(xyToIndex(15, 8), outlineColor);
-  strips[q].setPixelColor(xyToIndex(15, 9), outlineColor);
-  strips[q].setPixelColor(xyToIndex(14, 10), outlineColor);
-  strips[q].setPixelColor(xyToIndex(14, 11), outlineColor);
-  strips[q].setPixelColor(xyToIndex(15, 12), outlineColor);
-  strips[q].setPixelColor(xyToIndex(15, 13), outlineColor);
-  strips[q].setPixelColor(xyToIndex(15, 14), outlineColor);
-  strips[q].setPixelColor(xyToIndex(14, 15), outlineColor);
-  strips[q].setPixelColor(xyToIndex(13, 16), outlineColor);
-  strips[q].setPixelColor(xyToIndex(12, 16), outlineColor);
-  strips[q].setPixelColor(xyToIndex(11, 16), outlineColor);
-  strips[q].setPixelColor(xyToIndex(10, 15), outlineColor);
-  strips[q].setPixelColor(xyToIndex(9, 14), outlineColor);
+  strips[q].setPixelColor(bearIndex(12, 3), outlineColor);
+  strips[q].setPixelColor(bearIndex(13, 4), outlineColor);
+  strips[q].setPixelColor(bearIndex(14, 5), outlineColor);
+  strips[q].setPixelColor(bearIndex(15, 6), outlineColor);
+  strips[q].setPixelColor(bearIndex(15, 7), outlineColor);
+  strips[q].setPixelColor(bearIndex(15, 8), outlineColor);
+  strips[q].setPixelColor(bearIndex(15, 9), outlineColor);
+  strips[q].setPixelColor(bearIndex(14, 10), outlineColor);
+  strips[q].setPixelColor(bearIndex(14, 11), outlineColor);
+  strips[q].setPixelColor(bearIndex(15, 12), outlineColor);
+  strips[q].setPixelColor(bearIndex(15, 13), outlineColor);
+  strips[q].setPixelColor(bearIndex(15, 14), outlineColor);
+  strips[q].setPixelColor(bearIndex(14, 15), outlineColor);
+  strips[q].setPixelColor(bearIndex(13, 16), outlineColor);
+  strips[q].setPixelColor(bearIndex(12, 16), outlineColor);
+  strips[q].setPixelColor(bearIndex(11, 16), outlineColor);
+  strips[q].setPixelColor(bearIndex(10, 15), outlineColor);
+  strips[q].setPixelColor(bearIndex(9, 14), outlineColor);
 
   //Top Middle
-  strips[q].setPixelColor(xyToIndex(8, 14), outlineColor);
+  strips[q].setPixelColor(bearIndex(8, 14), outlineColor);
 
   //Extra Pixels
-  strips[q].setPixelColor(xyToIndex(8, 9), fillColor);
-  strips[q].setPixelColor(xyToIndex(8, 5), fillColor);
-  strips[q].setPixelColor(xyToIndex(2, 13), fillColor);
-  strips[q].setPixelColor(xyToIndex(14, 13), fillColor);
+  strips[q].setPixelColor(bearIndex(8, 9), fillColor);
+  strips[q].setPixelColor(bearIndex(8, 5), fillColor);
+  strips[q].setPixelColor(bearIndex(2, 13), fillColor);
+  strips[q].setPixelColor(bearIndex(14, 13), fillColor);
 
 
   for(int a = 5; a < 12; a++) {
-    strips[q].setPixelColor(xyToIndex(a, 3), fillColor);
+    strips[q].setPixelColor(bearIndex(a, 3), fillColor);
   }
   
   for(int a = 4; a < 13; a++) {
-    strips[q].setPixelColor(xyToIndex(a, 4), fillColor);
+    strips[q].setPixelColor(bearIndex(a, 4), fillColor);
   }
 
   for(int a = 3; a < 7; a++) {
-    strips[q].setPixelColor(xyToIndex(a, 5), fillColor);
+    strips[q].setPixelColor(bearIndex(a, 5), fillColor);
   }
 
   for(int a = 10; a < 14; a++) {
-    strips[q].setPixelColor(xyToIndex(a, 5), fillColor);
+    strips[q].setPixelColor(bearIndex(a, 5), fillColor);
   }
 
   for(int a = 2; a < 8; a++) {
-    strips[q].setPixelColor(xyToIndex(a, 6), fillColor);
+    strips[q].setPixelColor(bearIndex(a, 6), fillColor);
   }
 
   for(int a = 9; a < 15; a++) {
-    strips[q].setPixelColor(xyToIndex(a, 6), fillColor);
+    strips[q].setPixelColor(bearIndex(a, 6), fillColor);
   }
 
   for(int a = 2; a < 8; a++) {
-    strips[q].setPixelColor(xyToIndex(a, 7), fillColor);
+    strips[q].setPixelColor(bearIndex(a, 7), fillColor);
   }
 
   for(int a = 9; a < 15; a++) {
-    strips[q].setPixelColor(xyToIndex(a, 7), fillColor);
+    strips[q].setPixelColor(bearIndex(a, 7), fillColor);
   }
 
    for(int a = 2; a < 7; a++) {
-    strips[q].setPixelColor(xyToIndex(a, 8), fillColor);
+    strips[q].setPixelColor(bearIndex(a, 8), fillColor);
   }
 
    for(int a = 10; a < 15; a++) {
-    strips[q].setPixelColor(xyToIndex(a, 8), fillColor);
+    strips[q].setPixelColor(bearIndex(a, 8), fillColor);
   }
 
    for(int a = 2; a < 6; a++) {
-    strips[q].setPixelColor(xyToIndex(a, 9), fillColor);
+    strips[q].setPixelColor(bearIndex(a, 9), fillColor);
   }
  
    for(int a = 11; a < 15; a++) {
-    strips[q].setPixelColor(xyToIndex(a, 9), fillColor);
+    strips[q].setPixelColor(bearIndex(a, 9), fillColor);
   }
 
   for(int a = 3; a < 14; a++) {
-    strips[q].setPixelColor(xyToIndex(a, 10), fillColor);
+    strips[q].setPixelColor(bearIndex(a, 10), fillColor);
   }
  
    for(int a = 3; a < 6; a++) {
-    strips[q].setPixelColor(xyToIndex(a, 11), fillColor);
+    strips[q].setPixelColor(bearIndex(a, 11), fillColor);
   }
 
   for(int a = 7; a < 10; a++) {
-    strips[q].setPixelColor(xyToIndex(a, 11), fillColor);
+    strips[q].setPixelColor(bearIndex(a, 11), fillColor);
   }
 
   for(int a = 11; a < 14; a++) {
-    strips[q].setPixelColor(xyToIndex(a, 11), fillColor);
+    strips[q].setPixelColor(bearIndex(a, 11), fillColor);
   }
 
   for(int a = 2; a < 4; a++) {
-    strips[q].setPixelColor(xyToIndex(a, 12), fillColor);
+    strips[q].setPixelColor(bearIndex(a, 12), fillColor);
   }
 
   for(int a = 5; a < 12; a++) {
-    strips[q].setPixelColor(xyToIndex(a, 12), fillColor);
+    strips[q].setPixelColor(bearIndex(a, 12), fillColor);
   }
 
   for(int a = 13; a < 15; a++) {
-    strips[q].setPixelColor(xyToIndex(a, 12), fillColor);
+    strips[q].setPixelColor(bearIndex(a, 12), fillColor);
   }
 
   for(int a = 6; a < 11; a++) {
-    strips[q].setPixelColor(xyToIndex(a, 13), fillColor);
+    strips[q].setPixelColor(bearIndex(a, 13), fillColor);
   }
 
 
 
   for(int a = 2; a < 4; a++) {
-    strips[q].setPixelColor(xyToIndex(a, 14), fillColor);
+    strips[q].setPixelColor(bearIndex(a, 14), fillColor);
   }
 
   for(int a = 5; a < 7; a++) {
-    strips[q].setPixelColor(xyToIndex(a, 14), fillColor);
+    strips[q].setPixelColor(bearIndex(a, 14), fillColor);
   }
 
   for(int a = 10; a < 12; a++) {
-    strips[q].setPixelColor(xyToIndex(a, 14), fillColor);
+    strips[q].setPixelColor(bearIndex(a, 14), fillColor);
   }
 
   for(int a = 13; a < 15; a++) {
-    strips[q].setPixelColor(xyToIndex(a, 14), fillColor);
+    strips[q].setPixelColor(bearIndex(a, 14), fillColor);
   }
 
 
   for(int a = 3; a < 6; a++) {
-    strips[q].setPixelColor(xyToIndex(a, 15), fillColor);
+    strips[q].setPixelColor(bearIndex(a, 15), fillColor);
   }
 
   for(int a = 11; a < 14; a++) {
-    strips[q].setPixelColor(xyToIndex(a, 15), fillColor);
+    strips[q].setPixelColor(bearIndex(a, 15), fillColor);
   }
-  strips[q].show();
+}
+
+// Draws the outline of a bear's face in the specified color
+void drawBearFace(uint8_t q, uint32_t outlineColor, uint32_t fillColor) {
+  if (q >= NUM_STRIPS_CONNECTED) return;
+  paintBearFace(q, outlineColor, fillColor);
+  stripShow(q);
+}
+
+// The X fills the biggest square that fits, centred, so it stays an X on
+// a panel that isn't square
+const uint8_t X_SIZE = QUAD_ROWS < QUAD_COLS ? QUAD_ROWS : QUAD_COLS;
+const uint8_t X_X0 = (QUAD_COLS - X_SIZE) / 2;
+const uint8_t X_Y0 = (QUAD_ROWS - X_SIZE) / 2;
+
+// Is (x, y) on one of the X's diagonals?
+inline bool onRedX(uint8_t x, uint8_t y) {
+  if (x < X_X0 || x >= X_X0 + X_SIZE || y < X_Y0 || y >= X_Y0 + X_SIZE) return false;
+  // Main diagonal: x == y (top-right to bottom-left)
+  // Other diagonal: x + y == X_SIZE - 1 (top-left to bottom-right)
+  int diag1 = (int)(x - X_X0) - (int)(y - X_Y0);
+  int diag2 = (int)(x - X_X0) + (int)(y - X_Y0) - (X_SIZE - 1);
+  return abs(diag1) <= 1 || abs(diag2) <= 1;
 }
 
 // Draw a red 'X' in the quadrant: two diagonal lines 3 LEDs thick
@@ -423,32 +529,33 @@ void drawRedX(uint8_t q) {
   strips[q].clear();
   for (uint8_t y = 0; y < QUAD_ROWS; y++) {
     for (uint8_t x = 0; x < QUAD_COLS; x++) {
-      // Main diagonal: x == y (top-right to bottom-left)
-      // Other diagonal: x + y == QUAD_ROWS - 1 (top-left to bottom-right)
-      int diag1 = (int)x - (int)y;
-      int diag2 = (int)x + (int)y - (QUAD_ROWS - 1);
-      if (abs(diag1) <= 1 || abs(diag2) <= 1) {
+      if (onRedX(x, y)) {
         uint16_t idx = xyToIndex(x, y);
         strips[q].setPixelColor(idx, strips[q].Color(255, 0, 0));
       }
     }
   }
-  strips[q].show();
+  stripShow(q);
 }
 
-// Draw a red 'X' over the current contents (do not clear first).
+// Paint a red 'X' over the current contents (do not clear first).
 // This overwrites any pixels of the bear that intersect the X.
-void drawRedXOver(uint8_t q) {
+// Call show() yourself afterwards.
+void paintRedXOver(uint8_t q) {
   if (q >= NUM_STRIPS_CONNECTED) return;
   for (uint8_t y = 0; y < QUAD_ROWS; y++) {
     for (uint8_t x = 0; x < QUAD_COLS; x++) {
-      int diag1 = (int)x - (int)y;
-      int diag2 = (int)x + (int)y - (QUAD_ROWS - 1);
-      if (abs(diag1) <= 1 || abs(diag2) <= 1) {
+      if (onRedX(x, y)) {
         uint16_t idx = xyToIndex(x, y);
         strips[q].setPixelColor(idx, strips[q].Color(255, 0, 0));
       }
     }
   }
-  strips[q].show();
+}
+
+// Draw a red 'X' over the current contents and show it
+void drawRedXOver(uint8_t q) {
+  if (q >= NUM_STRIPS_CONNECTED) return;
+  paintRedXOver(q);
+  stripShow(q);
 }
\ No newline at end of file
@@ -0,0 +1,351 @@
+#pragma once
+#include "config.h"
+#include "leds.h"
+#include "latency.h"
+#include "link_protocol.h"
+
+// --- MULTI-BOARD LINK ---
+// A bigger wall needs more strips than one board can push in a frame. So
+// the leader keeps everything to do with the game (modes, scores, the
+// remote, the beams) and draws into its strip buffers as usual. It sends
+// only what changed to the followers over Serial1 (format in
+// link_protocol.h), and the followers drive the LEDs. LINK_QUAD_BOARD
+// (config.h) says which board drives which quadrant.
+//
+// Frames: on the leader stripShow() only marks the strip. linkService(),
+// at the end of loop(), sends the changes, waits for the last byte to
+// leave, then toggles LINK_SYNC_PIN. Every follower latches on the toggle,
+// so all panels change together. stripsLatch() does the same straight
+// away, before the game pauses with something on screen.
+//
+// Two things the WS2812 timing forces:
+//   - a follower's show() keeps interrupts off, so its UART can't take
+//     bytes while it runs. The leader works out how long the followers
+//     will be busy and sends nothing until then.
+//   - the leader itself never calls show() for a remote quadrant, so its
+//     interrupts stay on: no garbled remote keys, no lost millis().
+// Every LINK_KEYFRAME_MS one quadrant is resent in full. That brings a
+// follower that was reset, or that lost a packet, back in step.
+//
+// Type "link" in the leader's Serial Monitor for the bandwidth numbers.
+
+const uint16_t LINK_US_PER_LED = 30;        // WS2812: 24 bits at 800 kHz
+const uint16_t LINK_LATCH_US = 300;         // line low before the LEDs latch
+const uint16_t LINK_PARSE_US = 200;         // last byte to sync: followers finish reading
+const uint8_t LINK_SYNC_POLL_US = 2;        // follower: sync pin polling while armed
+const uint32_t LINK_SYNC_TIMEOUT_US = 50000; // armed this long without a sync: give up
+const uint8_t LINK_IDLE_US = 20;            // follower: pause when nothing has arrived
+const uint16_t LINK_KEYFRAME_MS = 1000;
+const uint8_t LINK_FILL_MIN = 4;            // LEDs of one colour worth a fill op
+const uint8_t LINK_SPAN_GAP = 2;            // unchanged LEDs a copy op carries along
+const uint16_t LINK_REPORT_MS = 10000;      // follower: stats line this often
+
+#if LINK_ROLE == LINK_LEADER
+
+uint8_t linkShown[NUM_STRIPS_CONNECTED][LEDS_PER_QUAD * 3]; // what the followers have
+uint8_t linkPending = 0;       // quadrants stripShow() was called for since the last frame
+uint16_t linkFrame = 0;        // frames sent
+uint8_t linkFrameMask = 0;     // quadrants the followers showed in the last one
+static_assert(NUM_STRIPS_CONNECTED <= 8, "linkPending and linkFrameMask have one bit per quadrant");
+uint32_t linkSyncUs = 0;       // when its sync toggle went out
+uint32_t linkQuietAtUs = 0;    // when the followers are done showing it
+uint8_t linkSyncLevel = LOW;
+unsigned long linkNextKeyMs = 0;
+uint8_t linkNextKeyQuad = 0;
+unsigned long linkStatsStartMs = 0;
+LinkStats linkStats;
+
+uint8_t linkBody[LINK_MAX_BODY]; // ops waiting to go out as one packet
+uint8_t linkBodyLen = 0;
+
+// How long the busiest follower spends pushing the quadrants in `mask`
+uint32_t linkShowUs(uint8_t mask) {
+  uint8_t perBoard[NUM_STRIPS_CONNECTED + 1] = {};
+  uint8_t most = 0;
+  for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) {
+    if (!(mask & (1 << q)) || LINK_QUAD_BOARD[q] > NUM_STRIPS_CONNECTED) continue;
+    uint8_t n = ++perBoard[LINK_QUAD_BOARD[q]];
+    if (n > most) most = n;
+  }
+  return most * ((uint32_t)LEDS_PER_QUAD * LINK_US_PER_LED + LINK_LATCH_US);
+}
+
+void linkBegin() {
+  Serial1.begin(LINK_BAUD);
+  pinMode(LINK_SYNC_PIN, OUTPUT);
+  digitalWrite(LINK_SYNC_PIN, linkSyncLevel);
+  // Followers powered up with us are clearing their strips: wait them out
+  linkQuietAtUs = micros() + linkShowUs((1 << NUM_STRIPS_CONNECTED) - 1) + LINK_PARSE_US;
+  linkStatsStartMs = millis();
+  Serial.println("Link: leader");
+}
+
+// stripShow() on the leader: the strip goes out with the next frame
+void linkQueue(uint8_t q) { linkPending |= 1 << q; }
+
+void linkSendPacket(uint8_t type, uint8_t arg, const uint8_t* body, uint8_t len) {
+  uint8_t head[LINK_HEADER_BYTES] = {LINK_SYNC, type, arg, len};
+  Serial1.write(head, LINK_HEADER_BYTES);
+  Serial1.write(body, len);
+  Serial1.write(linkCheck(head, body, len));
+  linkStats.bytes += LINK_HEADER_BYTES + len + 1;
+}
+
+void linkFlushOps(uint8_t q) {
+  if (linkBodyLen) linkSendPacket(LINK_PIXELS, q, linkBody, linkBodyLen);
+  linkBodyLen = 0;
+}
+
+void linkAddOp(uint8_t q, uint16_t first, uint16_t count, bool fill, const uint8_t* grb) {
+  uint8_t dataLen = fill ? 3 : count * 3;
+  if (linkBodyLen + LINK_OP_BYTES + dataLen > LINK_MAX_BODY) linkFlushOps(q);
+  uint16_t c = count | (fill ? LINK_FILL : 0);
+  uint8_t* op = &linkBody[linkBodyLen];
+  op[0] = first; op[1] = first >> 8; op[2] = c; op[3] = c >> 8;
+  memcpy(&op[LINK_OP_BYTES], grb, dataLen);
+  linkBodyLen += LINK_OP_BYTES + dataLen;
+}
+
+// LEDs from i on with the same colour as LED i, counting up to `limit`
+uint16_t linkRunAt(const uint8_t* px, uint16_t i, uint16_t limit) {
+  uint16_t run = 1;
+  while (run < limit && i + run < LEDS_PER_QUAD && memcmp(&px[i * 3], &px[(i + run) * 3], 3) == 0) run++;
+  return run;
+}
+
+// Send what changed in quadrant q since the followers last got it
+// (everything when `full`). False if nothing did.
+bool linkSendQuad(uint8_t q, bool full) {
+  const uint8_t* px = strips[q].getPixels();
+  uint8_t* shown = linkShown[q];
+  bool any = false;
+  uint16_t i = 0;
+  while (i < LEDS_PER_QUAD) {
+    if (!full && memcmp(&px[i * 3], &shown[i * 3], 3) == 0) { i++; continue; }
+    any = true;
+    uint16_t run = linkRunAt(px, i, LEDS_PER_QUAD);
+    if (run >= LINK_FILL_MIN) {
+      linkAddOp(q, i, run, true, &px[i * 3]);
+      i += run;
+      continue;
+    }
+    // A copy: on through changed LEDs and short unchanged gaps, stopping
+    // where a fill would do better
+    uint16_t last = i;
+    for (uint16_t j = i + 1; j < LEDS_PER_QUAD && j - i < LINK_COPY_MAX; j++) {
+      if (full || memcmp(&px[j * 3], &shown[j * 3], 3) != 0) {
+        if (linkRunAt(px, j, LINK_FILL_MIN) >= LINK_FILL_MIN) break;
+        last = j;
+      } else if (j - last > LINK_SPAN_GAP) {
+        break;
+      }
+    }
+    linkAddOp(q, i, last - i + 1, false, &px[i * 3]);
+    i = last + 1;
+  }
+  linkFlushOps(q);
+  memcpy(shown, px, sizeof(linkShown[q]));
+  return any;
+}
+
+// Show everything stripShow() was called for since the last frame, on
+// every board at once. Waits first if the followers are still busy with
+// the last frame.
+void linkLatch() {
+  uint8_t keyQuad = 0xFF;
+  if (millis() >= linkNextKeyMs) {
+    for (uint8_t n = 0; n < NUM_STRIPS_CONNECTED && keyQuad == 0xFF; n++) {
+      uint8_t q = linkNextKeyQuad;
+      linkNextKeyQuad = (linkNextKeyQuad + 1) % NUM_STRIPS_CONNECTED;
+      if (LINK_QUAD_BOARD[q] != 0) keyQuad = q;
+    }
+    linkNextKeyMs = millis() + LINK_KEYFRAME_MS;
+  }
+  if (!linkPending && keyQuad == 0xFF) return;
+
+  uint32_t startUs = micros();
+  int32_t busyUs = (int32_t)(linkQuietAtUs - startUs);
+  if (busyUs > 0) delayMicroseconds(busyUs);
+
+  uint8_t pending = linkPending, show = 0;
+  uint32_t bytesBefore = linkStats.bytes;
+  linkPending = 0;
+  for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) {
+    bool key = q == keyQuad;
+    if (!key && !(pending & (1 << q))) continue;
+    if (LINK_QUAD_BOARD[q] == 0) continue; // shown here, below
+    if (pending & (1 << q)) linkStats.rawBytes += LEDS_PER_QUAD * 3;
+    if (key) linkStats.keyframes++;
+    if (linkSendQuad(q, key)) show |= 1 << q;
+  }
+
+  if (show) {
+    uint8_t body[2] = {(uint8_t)(linkFrame + 1), (uint8_t)((linkFrame + 1) >> 8)};
+    linkSendPacket(LINK_COMMIT, show, body, 2);
+    Serial1.flush(); // every byte on the wire
+    delayMicroseconds(LINK_PARSE_US);
+    linkSyncLevel = !linkSyncLevel;
+    digitalWrite(LINK_SYNC_PIN, linkSyncLevel);
+    linkSyncUs = micros();
+    linkQuietAtUs = linkSyncUs + linkShowUs(show) + LINK_PARSE_US;
+    linkFrame++;
+    linkFrameMask = show;
+    linkStats.frames++;
+    uint16_t frameBytes = linkStats.bytes - bytesBefore;
+    if (frameBytes > linkStats.maxFrameBytes) linkStats.maxFrameBytes = frameBytes;
+  }
+  for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) {
+    if (!(pending & (1 << q))) continue;
+    if (LINK_QUAD_BOARD[q] == 0) strips[q].show();
+    latencyShown(q);
+  }
+  linkStats.waitUs += micros() - startUs;
+}
+
+// Call every loop, after the drawing: sends the frame unless the
+// followers are still showing the last one (then it goes next loop)
+void linkService() {
+  if ((int32_t)((uint32_t)micros() - linkQuietAtUs) >= 0) linkLatch();
+}
+
+void linkPrint() {
+  float secs = (millis() - linkStatsStartMs) / 1000.0f;
+  Serial.print("Link: "); Serial.print(linkStats.frames); Serial.print(" frames (");
+  Serial.print(linkStats.keyframes); Serial.print(" keyframes), ");
+  Serial.print(linkStats.bytes); Serial.print(" bytes in "); Serial.print(secs, 1); Serial.print(" s, ");
+  Serial.print(secs > 0 ? linkStats.bytes * 1000.0f / LINK_BAUD / secs : 0, 1); // 10 bits a byte
+  Serial.println("% of the wire");
+  Serial.print("Link: "); Serial.print(linkStats.rawBytes ? 100.0f * linkStats.bytes / linkStats.rawBytes : 0, 1);
+  Serial.print("% of plain pixels, largest frame "); Serial.print(linkStats.maxFrameBytes);
+  Serial.print(" bytes, waited "); Serial.print(linkStats.waitUs / 1000); Serial.println(" ms");
+}
+
+#else
+inline void linkBegin() {}
+inline void linkService() {}
+#endif
+
+#if LINK_ROLE != LINK_SINGLE
+// --- FOLLOWER ---
+// Collects packets, applies pixel ops to its own quadrants' buffers, and
+// on a commit waits for the sync toggle and shows them. Also built into
+// the leader's host test, which forks follower boards from it.
+
+uint8_t linkBoard = 0;
+uint8_t linkRx[LINK_HEADER_BYTES + LINK_MAX_BODY + 1];
+uint16_t linkRxHave = 0;
+uint16_t linkShowingFrame = 0; // frame of the show() in progress
+int linkSyncSeen = LOW;        // sync level before the frame being waited for
+unsigned long linkReportMs = 0;
+LinkFollowerStats linkFollowerStats;
+
+bool linkOwns(uint8_t q) { return q < NUM_STRIPS_CONNECTED && LINK_QUAD_BOARD[q] == linkBoard; }
+
+void linkFollowerBegin(uint8_t board) {
+  linkBoard = board;
+  Serial1.begin(LINK_BAUD);
+  pinMode(LINK_SYNC_PIN, INPUT);
+  stripsConfigure();
+  for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) {
+    if (!linkOwns(q)) continue;
+    strips[q].begin();
+    strips[q].clear();
+    strips[q].show();
+  }
+  linkSyncSeen = digitalRead(LINK_SYNC_PIN);
+  Serial.print("Link: follower "); Serial.println(board);
+}
+
+// Apply one LINK_PIXELS body to quadrant q. False if an op doesn't fit.
+bool linkApplyOps(uint8_t q, const uint8_t* body, uint8_t len) {
+  uint8_t* px = strips[q].getPixels();
+  uint8_t at = 0;
+  while (at + LINK_OP_BYTES <= len) {
+    uint16_t first = body[at] | body[at + 1] << 8;
+    uint16_t count = body[at + 2] | body[at + 3] << 8;
+    bool fill = count & LINK_FILL;
+    count &= ~LINK_FILL;
+    uint16_t dataLen = fill ? 3 : count * 3;
+    at += LINK_OP_BYTES;
+    if ((uint32_t)first + count > LEDS_PER_QUAD || at + dataLen > len) return false;
+    if (fill) {
+      for (uint16_t i = 0; i < count; i++) memcpy(&px[(first + i) * 3], &body[at], 3);
+    } else {
+      memcpy(&px[first * 3], &body[at], dataLen);
+    }
+    at += dataLen;
+  }
+  return at == len;
+}
+
+// Commit for the quadrants in `mask`: wait for the sync toggle, then show
+// ours. Nothing else arrives meanwhile (the leader is waiting too).
+void linkShowFrame(uint8_t mask, uint16_t frame) {
+  uint8_t ours = 0;
+  for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) if ((mask & (1 << q)) && linkOwns(q)) ours |= 1 << q;
+  uint32_t startUs = micros();
+  while (digitalRead(LINK_SYNC_PIN) == linkSyncSeen) {
+    if (micros() - startUs > LINK_SYNC_TIMEOUT_US) {
+      if (ours) linkFollowerStats.missedSyncs++;
+      return;
+    }
+    delayMicroseconds(LINK_SYNC_POLL_US);
+  }
+  linkSyncSeen = !linkSyncSeen;
+  uint32_t waitedUs = micros() - startUs;
+  if (waitedUs > linkFollowerStats.maxSyncWaitUs) linkFollowerStats.maxSyncWaitUs = waitedUs;
+  if (!ours) return;
+  linkShowingFrame = frame;
+  for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) if (ours & (1 << q)) strips[q].show();
+  linkFollowerStats.frames++;
+}
+
+void linkRxPacket() {
+  uint8_t len = linkRx[3];
+  const uint8_t* body = &linkRx[LINK_HEADER_BYTES];
+  if (linkRx[LINK_HEADER_BYTES + len] != linkCheck(linkRx, body, len)) {
+    linkFollowerStats.badPackets++;
+    return;
+  }
+  uint8_t type = linkRx[1], arg = linkRx[2];
+  if (type == LINK_PIXELS) {
+    if (linkOwns(arg) && !linkApplyOps(arg, body, len)) linkFollowerStats.badPackets++;
+  } else if (type == LINK_COMMIT && len == 2) {
+    linkShowFrame(arg, body[0] | body[1] << 8);
+  }
+}
+
+void linkRxByte(uint8_t c) {
+  if (linkRxHave == 0 && c != LINK_SYNC) return; // between packets: wait for the next one
+  linkRx[linkRxHave++] = c;
+  if (linkRxHave == LINK_HEADER_BYTES && linkRx[3] > LINK_MAX_BODY) {
+    linkFollowerStats.badPackets++;
+    linkRxHave = 0;
+    return;
+  }
+  if (linkRxHave < LINK_HEADER_BYTES || linkRxHave < LINK_HEADER_BYTES + linkRx[3] + 1) return;
+  linkRxHave = 0;
+  linkRxPacket();
+}
+
+void linkFollowerPrint() {
+  Serial.print("Link: "); Serial.print(linkFollowerStats.frames); Serial.print(" frames, ");
+  Serial.print(linkFollowerStats.badPackets); Serial.print(" bad packets, ");
+  Serial.print(linkFollowerStats.missedSyncs); Serial.print(" missed syncs, longest sync wait ");
+  Serial.print(linkFollowerStats.maxSyncWaitUs); Serial.println(" us");
+}
+
+// The follower's whole loop()
+void linkFollowerService() {
+  bool any = false;
+  while (Serial1.available() > 0) {
+    linkRxByte((uint8_t)Serial1.read());
+    any = true;
+  }
+  if (millis() - linkReportMs >= LINK_REPORT_MS) {
+    linkReportMs = millis();
+    linkFollowerPrint();
+  }
+  if (!any) delayMicroseconds(LINK_IDLE_US);
+}
+#endif
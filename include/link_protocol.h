@@ -0,0 +1,52 @@
+#pragma once
+#include <stdint.h>
+
+// --- MULTI-BOARD LINK FORMAT ---
+// Shared by the leader and the followers (link.h) and the host link test
+// (src/test_link.cpp), so all of them agree on the bytes.
+//
+// Every packet goes from the leader to all followers at once:
+//   [0xA5] [type] [arg] [len] [len bytes] [check]
+// check is the sum of the bytes before it, like a telemetry record.
+//   LINK_PIXELS  arg = quadrant, the bytes are ops (below)
+//   LINK_COMMIT  arg = mask of quadrants in the frame, 2 bytes frame number
+//                (little-endian): show them at the next sync toggle
+// An op rewrites part of a strip buffer, in the bytes that go down the LED
+// wire (G R B per LED, brightness already applied):
+//   [first lo] [first hi] [count lo] [count hi]  then count x G R B
+//   with LINK_FILL set in count: a single G R B for all count LEDs
+
+const uint8_t LINK_SYNC = 0xA5;
+const uint8_t LINK_PIXELS = 1;
+const uint8_t LINK_COMMIT = 2;
+const uint8_t LINK_HEADER_BYTES = 4;
+const uint8_t LINK_MAX_BODY = 250;
+const uint16_t LINK_FILL = 0x8000;
+const uint8_t LINK_OP_BYTES = 4;
+// LEDs one copy op can carry and still fit in a packet
+const uint8_t LINK_COPY_MAX = (LINK_MAX_BODY - LINK_OP_BYTES) / 3;
+
+inline uint8_t linkCheck(const uint8_t* head, const uint8_t* body, uint8_t len) {
+  uint8_t sum = 0;
+  for (uint8_t i = 0; i < LINK_HEADER_BYTES; i++) sum += head[i];
+  for (uint8_t i = 0; i < len; i++) sum += body[i];
+  return sum;
+}
+
+// Leader: what the link has carried since linkBegin()
+struct LinkStats {
+  uint32_t frames;        // sync toggles
+  uint32_t keyframes;     // quadrants resent in full
+  uint32_t bytes;         // everything sent
+  uint32_t rawBytes;      // the same frames sent as plain pixels
+  uint16_t maxFrameBytes;
+  uint32_t waitUs;        // time loop() waited for the link
+};
+
+// Follower: what it received and showed
+struct LinkFollowerStats {
+  uint32_t frames;        // frames shown
+  uint32_t badPackets;    // wrong check or impossible op
+  uint32_t missedSyncs;   // armed, but no sync came
+  uint32_t maxSyncWaitUs; // commit to sync toggle, worst seen
+};
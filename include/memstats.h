@@ -0,0 +1,79 @@
+#pragma once
+#include "config.h"
+
+// --- RAM AT RUNTIME ---
+// The build prints where the static RAM goes (scripts/ram_report.py); this
+// covers the part it can't see: how deep the stack has been and how much
+// heap is left after the NeoPixel buffers and IRremote have taken theirs.
+//
+// memBegin() paints the unused stack with a known pattern. Whatever the
+// stack has ever grown into is no longer that pattern, so scanning up from
+// the bottom finds the deepest point so far (the high-water mark). Type
+// "mem" in the Serial Monitor to see it.
+//
+// On the host there is no fixed stack or heap to look at, so the numbers
+// are only available on the board.
+
+struct MemStats {
+  uint32_t stackSize;  // bytes reserved for the stack by the linker
+  uint32_t stackUsed;  // deepest the stack has been since memBegin()
+  uint32_t heapSize;   // bytes reserved for the heap by the linker
+  uint32_t heapFree;   // never handed out plus freed-and-reusable
+};
+
+#if defined(ARDUINO_ARCH_RENESAS)
+#include <malloc.h>
+
+// From the core's linker script (fsp.ld)
+extern "C" uint8_t __StackLimit[], __StackTop[], __HeapBase[], __HeapLimit[];
+extern "C" void* sbrk(ptrdiff_t increment);
+
+const uint32_t MEM_PAINT = 0xC5C5C5C5;
+// Leave this much below the current stack pointer alone: memBegin()'s own
+// frame and anything an interrupt pushes while we paint
+const uint32_t MEM_PAINT_MARGIN = 64;
+
+const bool memAvailable = true;
+
+// Call first thing in setup(), while the stack is still shallow
+void memBegin() {
+  uint32_t* p = (uint32_t*)__StackLimit;
+  uint32_t* end = (uint32_t*)(__get_MSP() - MEM_PAINT_MARGIN);
+  while (p < end) *p++ = MEM_PAINT;
+}
+
+MemStats memRead() {
+  MemStats m;
+  m.stackSize = __StackTop - __StackLimit;
+  const uint32_t* p = (const uint32_t*)__StackLimit;
+  const uint32_t* top = (const uint32_t*)__StackTop;
+  while (p < top && *p == MEM_PAINT) p++;
+  m.stackUsed = (const uint8_t*)top - (const uint8_t*)p;
+
+  m.heapSize = __HeapLimit - __HeapBase;
+  uint8_t* brk = (uint8_t*)sbrk(0);
+  m.heapFree = mallinfo().fordblks + (__HeapLimit - brk);
+  return m;
+}
+
+#else
+
+const bool memAvailable = false;
+inline void memBegin() {}
+inline MemStats memRead() { return {0, 0, 0, 0}; }
+
+#endif
+
+// stack 1312/8192 bytes (high-water), heap 20304/24576 bytes free
+void memPrint() {
+  if (!memAvailable) {
+    Serial.println("RAM numbers are only available on the board");
+    return;
+  }
+  MemStats m = memRead();
+  Serial.print("stack "); Serial.print((unsigned long)m.stackUsed);
+  Serial.print('/'); Serial.print((unsigned long)m.stackSize);
+  Serial.print(" bytes (high-water), heap "); Serial.print((unsigned long)m.heapFree);
+  Serial.print('/'); Serial.print((unsigned long)m.heapSize);
+  Serial.println(" bytes free");
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include "modestate.h"
+#include "leds.h"
+#include "remote.h"
+#include "rounds.h"
+#include "effects.h"
+#include "round3.h"
+#include "patterns.h"
+#include "journal.h"
+
+// --- MODE LIFECYCLE ---
+// Every game mode is described by up to four functions:
+//   enter  - runs exactly once when the mode starts (draw the opening scene)
+//   update - runs every loop while the mode is active
+//   exit   - runs once when another mode takes over
+//   resume - runs instead of enter when the board was reset in the middle
+//            of this mode; rebuilds the scene from the journal (journal.h)
+// The remote only changes `currentMode`; modesUpdate() notices the change,
+// closes the old mode, hands it a fresh (zeroed) modeState and enters the
+// new one.
+
+struct ModeHooks {
+  void (*enter)();
+  void (*update)();
+  void (*exit)();
+  void (*resume)();
+  // IMPORTANT: some modes redraw every loop. If we update LEDs while the
+  // remote is talking, we break the signal, so those modes wait.
+  bool updateOnlyWhenIrIdle;
+};
+
+// Runs when Round 1 / Round 4 ends, before the scores are forgotten
+void round1Exit() {
+  for (int q = 0; q < NUM_STRIPS_CONNECTED; q++) LOG_INFO(TEV_ROUND_OVER, q | r1Rows[q] << 8);
+}
+
+// Indexed by Mode (same order as the enum in config.h)
+const ModeHooks MODE_HOOKS[] = {
+  /* MODE_OFF    */ {ledsAllOff,  nullptr,        nullptr,    nullptr,      false},
+  /* MODE_INTRO  */ {nullptr,     introUpdate,    nullptr,    nullptr,      true},
+  /* MODE_R1     */ {round1Enter, round1Update,   round1Exit, round1Resume, true},
+  /* MODE_R2     */ {round2Enter, effectsUpdate,  nullptr,    round2Resume, false},
+  /* MODE_R3     */ {round3Enter, round3Update,   nullptr,    round3Resume, true},
+  // MODE_R4 reuses Round 1 so it starts with the same jar visuals and
+  // beam scoring; give it its own functions here when it diverges.
+  /* MODE_R4     */ {round1Enter, round1Update,   round1Exit, round1Resume, true},
+  /* MODE_FINALE */ {nullptr,     finaleUpdate,   nullptr,    nullptr,      true},
+};
+
+void modesUpdate() {
+  // 1. Did the remote pick a different mode? Close the old one first.
+  if (currentMode != activeMode) {
+    if (activeModeEntered && MODE_HOOKS[activeMode].exit) MODE_HOOKS[activeMode].exit();
+    activeMode = currentMode;
+    activeModeEntered = false;
+  }
+
+  const ModeHooks& hooks = MODE_HOOKS[activeMode];
+
+  // 2. Enter the mode once. Entering draws a whole new scene, so wait for
+  // the remote to be quiet. This is retried every loop until it happens,
+  // so a busy receiver can delay the entry but never skip it.
+  if (!activeModeEntered) {
+    if (!IrReceiver.isIdle()) return;
+    memset(&modeState, 0, sizeof(modeState));
+    journalLogMode(activeMode);
+    // Coming back from a reset into the mode we were in? Rebuild the scene.
+    bool resume = journalResumePending && journalResumed.mode == activeMode && hooks.resume;
+    journalResumePending = false;
+    latencyModeEntering();
+    if (resume) hooks.resume();
+    else if (hooks.enter) hooks.enter();
+    latencyClose();
+    activeModeEntered = true;
+  }
+
+  // 3. Normal per-loop work
+  if (hooks.updateOnlyWhenIrIdle && !IrReceiver.isIdle()) return;
+  if (hooks.update) hooks.update();
+}
+
+// Print how much RAM each mode's state needs and what the shared arena costs
+void modesReportRam() {
+  size_t sizes[] = {sizeof(IntroState), sizeof(Round1State), sizeof(Round2State),
+                    sizeof(Round3State), sizeof(FinaleState)};
+  const char* names[] = {"Intro", "R1/R4", "R2", "R3", "Finale"};
+  size_t separate = 0;
+  Serial.print("Mode state bytes:");
+  for (int i = 0; i < 5; i++) {
+    Serial.print(' '); Serial.print(names[i]); Serial.print('=');
+    Serial.print((unsigned long)sizes[i]);
+    separate += sizes[i];
+  }
+  Serial.println();
+  Serial.print("Mode arena: "); Serial.print((unsigned long)sizeof(modeState));
+  Serial.print(" bytes shared (separate globals: "); Serial.print((unsigned long)separate);
+  Serial.print(", saved "); Serial.print((unsigned long)(separate - sizeof(modeState)));
+  Serial.println(")");
+}
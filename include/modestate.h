@@ -0,0 +1,123 @@
+#pragma once
+#include "config.h"
+
+// --- MODE STATE ARENA ---
+// Only one game mode runs at a time, so every mode keeps the things it
+// needs to remember in its own struct below, and all of those structs
+// share the same piece of memory (`modeState`). When a mode starts, the
+// arena is wiped and handed to it; when it ends, the next mode reuses it.
+// Rule: only touch `modeState.<mode>` while that mode is running
+// (see modeIsRunning()).
+
+// MODE_INTRO: position on the colour wheel
+struct IntroState {
+  uint16_t hue;
+};
+
+// MODE_R1 / MODE_R4 bursts and the finale confetti: a fixed pool of
+// particles flying across the wall (see particles.h)
+#define PARTICLE_MAX 48
+
+struct Particle {
+  int16_t x, y;    // wall position in 1/256 pixel, (0, 0) at the bottom left
+  int16_t vx, vy;  // movement per frame, same units
+  uint8_t life;    // frames left (0 = free slot)
+  uint8_t kind;    // ParticleKind
+  uint8_t r, g, b;
+};
+
+// A pixel a particle was drawn over, as it was in the strip buffer
+struct ParticleUndo {
+  uint8_t q;
+  uint16_t index;
+  uint8_t grb[3];
+};
+
+struct ParticlePool {
+  Particle slots[PARTICLE_MAX];
+  ParticleUndo undo[PARTICLE_MAX];  // one per particle drawn last frame
+  uint8_t undoCount;
+  uint8_t live;        // particles still flying
+  uint8_t shed;        // quarters of each burst left out (over budget)
+  uint8_t calmFrames;  // cheap frames in a row, towards giving one back
+  uint16_t lastUs;     // what the last frame cost
+};
+
+// MODE_R1 / MODE_R4: how many honey rows are filled in each quadrant
+struct Round1State {
+  uint8_t rows[NUM_STRIPS_CONNECTED];       // score: rows earned
+  uint8_t shownRows[NUM_STRIPS_CONNECTED];  // rows fully painted in the jar
+  uint8_t riseStep[NUM_STRIPS_CONNECTED];   // fade step of the rising row (0 = none)
+  unsigned long riseStartMs[NUM_STRIPS_CONNECTED];
+  ParticlePool particles;  // sparks and honey when a ball scores
+};
+
+// MODE_R2: one effect slot per quadrant (see effects.h)
+enum EffectKind : uint8_t {
+  EFFECT_NONE,          // nothing running, quadrant shows whatever was drawn
+  EFFECT_STEADY,        // bear on, never toggles (CODE_7)
+  EFFECT_FLICKER,       // bear toggles every 300-600 ms (CODE_8)
+  EFFECT_FLICKER_FAST,  // bear toggles every 20-100 ms (CODE_9)
+  EFFECT_LOSE,          // 10 toggles at exactly 50 ms, then a red X (CODE_LOSE)
+  EFFECT_LOST,          // finished lose sequence: bear with a red X over it
+  EFFECT_LOCKED         // bright red X that selectors can't change (CODE_2)
+};
+
+struct QuadEffect {
+  uint8_t kind;            // EffectKind
+  uint8_t phase;           // number of toggles so far (even = bear visible)
+  unsigned long deadline;  // millis() of the next toggle
+};
+
+struct Round2State {
+  QuadEffect effects[NUM_STRIPS_CONNECTED];
+  uint8_t timedMask;  // bit q set while quadrant q has a timed effect
+  static_assert(NUM_STRIPS_CONNECTED <= 8, "timedMask has a bit per quadrant");
+  uint8_t armed;      // effect the next selector key applies
+};
+
+// MODE_R3: the blue/green track across the two top quadrants and the
+// random flashes on top of it
+#define R3_FLASH_QUADS 2  // only Q_TOP_LEFT (0) and Q_TOP_RIGHT (1) flash
+
+struct Round3State {
+  // One bit per track column (see round3.h): set = GREEN, clear = BLUE
+  uint64_t greenMask;       // where the game says the boundary is
+  uint64_t shownGreen;      // what the LEDs show right now
+  unsigned long nextSweepMs; // earliest time the next column may be painted
+  // Flattened flash arrays indexed by (q * LEDS_PER_QUAD + physIndex)
+  bool flashActive[R3_FLASH_QUADS * LEDS_PER_QUAD];
+  unsigned long flashEndTime[R3_FLASH_QUADS * LEDS_PER_QUAD];
+  unsigned long nextFlashTick;
+};
+
+// MODE_FINALE: position on the (slower) colour wheel, and the confetti
+struct FinaleState {
+  uint16_t hue;
+  unsigned long nextConfettiMs;  // 0 until the first frame
+  ParticlePool particles;
+};
+
+union ModeState {
+  IntroState intro;
+  Round1State r1;   // also used by MODE_R4
+  Round2State r2;
+  Round3State r3;
+  FinaleState finale;
+};
+
+// The particle pools ride along in space Round 3 needs anyway
+static_assert(sizeof(Round1State) <= sizeof(Round3State) && sizeof(FinaleState) <= sizeof(Round3State),
+              "particles must not grow the mode arena");
+
+// The arena itself (defined in src/main.cpp)
+extern ModeState modeState;
+
+// Which mode currently owns the arena, and whether its enter step has run
+extern Mode activeMode;
+extern bool activeModeEntered;
+
+// True once `m` has been entered and owns `modeState`
+inline bool modeIsRunning(Mode m) {
+  return activeMode == m && activeModeEntered;
+}
@@ -0,0 +1,223 @@
+#pragma once
+#include <DataFlash.h>
+#include "config.h"
+
+// --- TUNABLE PARAMETERS ---
+// Timings and looks that used to be compile-time constants. They live in
+// one `params` struct so they can be changed over the Serial Monitor while
+// the game is running (see console.h) and, if you like the result, saved
+// to the data flash so they survive a reset.
+//
+// To add one: add a field to Params with its default, then a line in
+// PARAM_TABLE with the name you want to type and the allowed range. If it
+// is one end of a min..max pair, add the pair to PARAM_PAIRS too.
+
+struct Params {
+  uint8_t brightness;        // strip brightness, 0-255
+  uint16_t flickerMinMs;     // CODE_8 flicker: bear toggles every min..max ms
+  uint16_t flickerMaxMs;
+  uint16_t fastMinMs;        // CODE_9 fast flicker: toggles every min..max ms
+  uint16_t fastMaxMs;
+  uint16_t loseToggleMs;     // CODE_LOSE: time between toggles
+  uint8_t loseToggles;       // CODE_LOSE: toggles before the red X
+  uint16_t flashTickMs;      // R3 sparkle: how often new flashes are tried
+  uint16_t flashMs;          // R3 sparkle: how long one flash lasts
+  uint8_t flashAttempts;     // R3 sparkle: candidates tried per tick
+  uint16_t sweepMs;          // R3 track: time per column in a multi-column sweep
+  uint16_t jarRiseMs;        // R1 jar: time for one new row to fade in
+  uint16_t introHueStep;     // Intro rainbow speed (bigger = faster)
+  uint16_t finaleHueStep;    // Finale rainbow speed
+  uint16_t particleBudgetUs; // Particles: frame time before bursts are cut back (0 = none)
+  uint8_t loopDelayMs;       // Pause at the end of every loop (1 ms during CODE_LOSE)
+};
+
+const Params PARAM_DEFAULTS = {
+  BRIGHTNESS,
+  300, 600,  // flicker
+  20, 100,   // fast flicker
+  50, 10,    // lose
+  100, 300, 30,  // sparkle
+  40,        // sweep
+  240,       // jar rise
+  3000,      // intro
+  100,       // finale
+  1000,      // particle budget
+  10         // loop delay
+};
+
+Params params = PARAM_DEFAULTS;
+
+enum ParamType : uint8_t { PARAM_U8, PARAM_U16 };
+
+struct ParamInfo {
+  const char* name;
+  uint8_t type;
+  void* value;
+  uint16_t minValue;
+  uint16_t maxValue;
+  void (*onSet)();  // optional: apply the new value right away
+};
+
+void ledsApplyBrightness(); // leds.h
+
+const ParamInfo PARAM_TABLE[] = {
+  {"brightness",     PARAM_U8,  &params.brightness,    0, 255,   ledsApplyBrightness},
+  {"flicker_min_ms", PARAM_U16, &params.flickerMinMs,  1, 10000, nullptr},
+  {"flicker_max_ms", PARAM_U16, &params.flickerMaxMs,  1, 10000, nullptr},
+  {"fast_min_ms",    PARAM_U16, &params.fastMinMs,     1, 10000, nullptr},
+  {"fast_max_ms",    PARAM_U16, &params.fastMaxMs,     1, 10000, nullptr},
+  {"lose_toggle_ms", PARAM_U16, &params.loseToggleMs,  1, 2000,  nullptr},
+  {"lose_toggles",   PARAM_U8,  &params.loseToggles,   2, 100,   nullptr},
+  {"flash_tick_ms",  PARAM_U16, &params.flashTickMs,   1, 10000, nullptr},
+  {"flash_ms",       PARAM_U16, &params.flashMs,       1, 10000, nullptr},
+  {"flash_attempts", PARAM_U8,  &params.flashAttempts, 0, 200,   nullptr},
+  {"sweep_ms",       PARAM_U16, &params.sweepMs,       0, 2000,  nullptr},
+  {"jar_rise_ms",    PARAM_U16, &params.jarRiseMs,     1, 5000,  nullptr},
+  {"intro_hue_step", PARAM_U16, &params.introHueStep,  0, 65535, nullptr},
+  {"finale_hue_step",PARAM_U16, &params.finaleHueStep, 0, 65535, nullptr},
+  {"particle_budget_us",PARAM_U16, &params.particleBudgetUs, 0, 20000, nullptr},
+  {"loop_delay_ms",  PARAM_U8,  &params.loopDelayMs,   0, 50,    nullptr},
+};
+const uint8_t PARAM_COUNT = sizeof(PARAM_TABLE) / sizeof(PARAM_TABLE[0]);
+
+// min..max pairs: the first may never be above the second (rngRange()
+// needs min <= max)
+struct ParamPair {
+  const char* minName;
+  const char* maxName;
+};
+const ParamPair PARAM_PAIRS[] = {
+  {"flicker_min_ms", "flicker_max_ms"},
+  {"fast_min_ms",    "fast_max_ms"},
+};
+
+// Look a parameter up by name, nullptr if there is none
+const ParamInfo* paramFind(const char* name) {
+  for (uint8_t i = 0; i < PARAM_COUNT; i++) {
+    if (strcmp(PARAM_TABLE[i].name, name) == 0) return &PARAM_TABLE[i];
+  }
+  return nullptr;
+}
+
+uint16_t paramGet(const ParamInfo& p) {
+  if (p.type == PARAM_U8) return *(uint8_t*)p.value;
+  return *(uint16_t*)p.value;
+}
+
+// The values p may take right now: its range in PARAM_TABLE, narrowed by
+// the other end of its pair (if it has one)
+void paramLimits(const ParamInfo& p, uint16_t& lo, uint16_t& hi) {
+  lo = p.minValue;
+  hi = p.maxValue;
+  for (const ParamPair& pair : PARAM_PAIRS) {
+    if (strcmp(p.name, pair.minName) == 0) hi = min(hi, paramGet(*paramFind(pair.maxName)));
+    if (strcmp(p.name, pair.maxName) == 0) lo = max(lo, paramGet(*paramFind(pair.minName)));
+  }
+}
+
+// Change a parameter. Returns false (and changes nothing) if the value is
+// outside paramLimits().
+bool paramSet(const ParamInfo& p, long value) {
+  uint16_t lo, hi;
+  paramLimits(p, lo, hi);
+  if (value < lo || value > hi) return false;
+  if (p.type == PARAM_U8) *(uint8_t*)p.value = (uint8_t)value;
+  else *(uint16_t*)p.value = (uint16_t)value;
+  if (p.onSet) p.onSet();
+  return true;
+}
+
+// True if every parameter is within paramLimits() (pairs included)
+bool paramsInRange() {
+  for (uint8_t i = 0; i < PARAM_COUNT; i++) {
+    uint16_t lo, hi, v = paramGet(PARAM_TABLE[i]);
+    paramLimits(PARAM_TABLE[i], lo, hi);
+    if (v < lo || v > hi) return false;
+  }
+  return true;
+}
+
+// --- SAVED PARAMETERS ---
+// Two data flash blocks right after the journal take turns holding the
+// saved copy, so a reset in the middle of saving still leaves the previous
+// one. Each copy is a small header followed by the Params struct.
+const uint32_t PARAMS_FLASH_OFFSET = 4 * DATA_FLASH_BLOCK_BYTES; // blocks 0-3 are the journal
+const uint16_t PARAMS_MAGIC = 0x5041;
+
+struct ParamsHeader {
+  uint16_t magic;
+  uint16_t size;     // sizeof(Params) when saved; a different build won't match
+  uint16_t sequence; // higher = newer
+  uint16_t check;
+};
+
+uint16_t paramsChecksum(const Params& p, uint16_t sequence) {
+  const uint8_t* b = (const uint8_t*)&p;
+  uint16_t sum = sequence ^ 0x1D0F;
+  for (size_t i = 0; i < sizeof(Params); i++) sum = (uint16_t)((sum << 1 | sum >> 15) + b[i]);
+  return sum;
+}
+
+// Read saved copy `slot` (0 or 1). Returns false if it's missing or damaged.
+bool paramsReadSlot(uint8_t slot, ParamsHeader& h, Params& p) {
+  uint32_t offset = PARAMS_FLASH_OFFSET + slot * DATA_FLASH_BLOCK_BYTES;
+  dataFlashRead(offset, (uint8_t*)&h, sizeof(h));
+  if (h.magic != PARAMS_MAGIC || h.size != sizeof(Params)) return false;
+  dataFlashRead(offset + sizeof(h), (uint8_t*)&p, sizeof(p));
+  return h.check == paramsChecksum(p, h.sequence);
+}
+
+// Find the newest saved copy. Returns the slot, or -1 if there is none.
+int8_t paramsNewestSlot(ParamsHeader& newest, Params& p) {
+  int8_t best = -1;
+  for (uint8_t slot = 0; slot < 2; slot++) {
+    ParamsHeader h;
+    Params candidate;
+    if (!paramsReadSlot(slot, h, candidate)) continue;
+    if (best >= 0 && (int16_t)(h.sequence - newest.sequence) <= 0) continue;
+    best = slot;
+    newest = h;
+    p = candidate;
+  }
+  return best;
+}
+
+// Load the saved parameters (if any). Call from setup() before ledsBegin().
+// A copy with a value out of range (saved by a build with other limits) is
+// ignored as a whole rather than half applied.
+void paramsBegin() {
+  params = PARAM_DEFAULTS;
+  if (!dataFlashBegin()) return;
+  ParamsHeader h;
+  Params saved;
+  if (paramsNewestSlot(h, saved) < 0) return;
+  params = saved;
+  if (!paramsInRange()) {
+    params = PARAM_DEFAULTS;
+    Serial.println("Params: saved values out of range, using defaults");
+    return;
+  }
+  Serial.println("Params: loaded saved values");
+}
+
+// Save the current parameters into the older slot. This erases a flash
+// block (several ms), so it only happens when someone types "save".
+bool paramsSave() {
+  ParamsHeader h;
+  Params old;
+  int8_t newest = paramsNewestSlot(h, old);
+  uint8_t slot = newest == 0 ? 1 : 0;
+  uint16_t sequence = newest < 0 ? 1 : h.sequence + 1;
+
+  uint32_t offset = PARAMS_FLASH_OFFSET + slot * DATA_FLASH_BLOCK_BYTES;
+  if (!dataFlashErase(offset, 1)) return false;
+  ParamsHeader out = {PARAMS_MAGIC, (uint16_t)sizeof(Params), sequence, paramsChecksum(params, sequence)};
+  // Body first, header last: a copy without its header is simply ignored
+  if (!dataFlashWrite(offset + sizeof(out), (const uint8_t*)&params, sizeof(params))) return false;
+  return dataFlashWrite(offset, (const uint8_t*)&out, sizeof(out));
+}
+
+// Forget saved values: erase both slots (defaults apply after the next reset)
+bool paramsForget() {
+  return dataFlashErase(PARAMS_FLASH_OFFSET, 2);
+}
@@ -0,0 +1,196 @@
+#pragma once
+#include "leds.h"
+#include "modestate.h"
+#include "params.h"
+#include "rng.h"
+#include "blend.h"
+
+// --- PARTICLES ---
+// Sparks, honey drips and confetti flying across the whole wall: the four
+// quadrants as one 36x36 picture, (0, 0) at the bottom left. A mode that
+// wants them keeps a ParticlePool (modestate.h) in its own state, so the
+// number of particles is fixed at build time and nothing is allocated.
+//
+// Positions and speeds are 8.8 fixed point (PARTICLE_ONE = one pixel) and
+// move once per loop with integer adds. A particle covers one pixel. When
+// it is drawn, the pixel underneath goes into the pool's undo list, and
+// particlesErase() puts those back before the next frame, so a scene that
+// is drawn once (the jar) never has to be redrawn.
+//
+// Particles never cost a show() of their own: a show() keeps interrupts
+// off for ~11 ms per quadrant, which is what beams and the remote can't
+// afford (test_latency). The mode says which quadrants particles may be
+// drawn on this loop (`canvas`): ones it shows anyway, and will show again
+// later, so a particle is never left behind on the LEDs. Everywhere else
+// they keep moving unseen.
+//
+// Budget: particlesFrame() times itself. A frame over
+// params.particleBudgetUs cuts every new burst back by a quarter (the
+// particles already flying finish normally), down to none at all; after
+// PARTICLE_CALM_FRAMES frames under half the budget a quarter comes back.
+// particle_budget_us 0 turns new particles off.
+//
+// Every loop:
+//   particlesErase(pool);          // then draw whatever changed in the scene
+//   particlesFrame(pool, canvas);  // then stripShow() what changed
+
+const int16_t PARTICLE_ONE = 256;
+const uint8_t WALL_COLS = 2 * QUAD_COLS;
+const uint8_t WALL_ROWS = 2 * QUAD_ROWS;
+const uint8_t PARTICLE_FADE_FRAMES = 8;  // last frames of a life fade out
+const uint8_t PARTICLE_SHED_MAX = 4;     // quarters: 4 = no new particles
+const uint8_t PARTICLE_CALM_FRAMES = 30;
+
+enum ParticleKind : uint8_t {
+  PARTICLE_SPARK,     // quick bright spray that glows on top of the scene
+  PARTICLE_DRIP,      // blob of honey, thrown up and falling back
+  PARTICLE_CONFETTI,  // drifts down from the top, swaying, in any colour
+  PARTICLE_KIND_COUNT
+};
+
+struct ParticleKindInfo {
+  int16_t gravity;           // taken off vy every frame
+  int16_t maxFall;           // vy never drops below -maxFall
+  int16_t sway;              // random change of vx per frame, up to +/- this
+  int16_t maxDrift;          // ... keeping vx within +/- this
+  uint8_t minLife, maxLife;  // frames
+  bool glow;                 // added to the scene instead of covering it
+};
+
+// Indexed by ParticleKind
+const ParticleKindInfo PARTICLE_KINDS[PARTICLE_KIND_COUNT] = {
+  /* SPARK    */ {12, 2 * PARTICLE_ONE, 0,  0,  10, 18,  true},
+  /* DRIP     */ {8,  PARTICLE_ONE / 2, 0,  0,  12, 20,  false},
+  /* CONFETTI */ {2,  PARTICLE_ONE / 5, 12, 64, 80, 160, false},
+};
+
+// Wall pixel (x, y) of pixel (x, y) in quadrant q
+inline uint8_t wallX(uint8_t q, uint8_t x) {
+  return (q == Q_TOP_RIGHT || q == Q_BOTTOM_RIGHT ? QUAD_COLS : 0) + x;
+}
+inline uint8_t wallY(uint8_t q, uint8_t y) {
+  return (q == Q_TOP_LEFT || q == Q_TOP_RIGHT ? QUAD_ROWS : 0) + y;
+}
+
+// Which quadrant shows wall pixel (x, y)
+inline uint8_t wallQuad(uint8_t x, uint8_t y) {
+  if (y >= QUAD_ROWS) return x < QUAD_COLS ? Q_TOP_LEFT : Q_TOP_RIGHT;
+  return x < QUAD_COLS ? Q_BOTTOM_LEFT : Q_BOTTOM_RIGHT;
+}
+
+// Start up to `count` particles of `kind` at wall pixel (x, y): fewer while
+// the pool is over budget, none once it is full. Returns how many started.
+uint8_t particlesBurst(ParticlePool& p, uint8_t kind, uint8_t x, uint8_t y, uint8_t count) {
+  if (params.particleBudgetUs == 0 || kind >= PARTICLE_KIND_COUNT) return 0;
+  count = (uint16_t)count * (PARTICLE_SHED_MAX - p.shed) / PARTICLE_SHED_MAX;
+  const ParticleKindInfo& k = PARTICLE_KINDS[kind];
+  uint8_t started = 0;
+  for (uint8_t i = 0; i < PARTICLE_MAX && started < count; i++) {
+    Particle& s = p.slots[i];
+    if (s.life) continue;
+    s.x = x * PARTICLE_ONE + PARTICLE_ONE / 2;
+    s.y = y * PARTICLE_ONE + PARTICLE_ONE / 2;
+    s.kind = kind;
+    s.life = rngRange(k.minLife, k.maxLife + 1, rngParticleState);
+    uint32_t color;
+    if (kind == PARTICLE_SPARK) {
+      s.vx = rngRange(-160, 161, rngParticleState);
+      s.vy = rngRange(40, 201, rngParticleState);
+      color = Adafruit_NeoPixel::Color(255, 200, 80);
+    } else if (kind == PARTICLE_DRIP) {
+      s.vx = rngRange(-48, 49, rngParticleState);
+      s.vy = rngRange(60, 141, rngParticleState);
+      color = Adafruit_NeoPixel::Color(128, 128, 0); // the jar's honey
+    } else {
+      s.vx = rngRange(-k.maxDrift, k.maxDrift + 1, rngParticleState);
+      s.vy = rngRange(-32, 1, rngParticleState);
+      color = Adafruit_NeoPixel::ColorHSV(rngNext(rngParticleState));
+    }
+    s.r = color >> 16;
+    s.g = color >> 8;
+    s.b = color;
+    started++;
+  }
+  p.live += started;
+  return started;
+}
+
+// Move every particle one frame on; the ones that run out of life or off
+// the wall are gone
+void particlesStep(ParticlePool& p) {
+  uint8_t live = 0;
+  for (uint8_t i = 0; i < PARTICLE_MAX; i++) {
+    Particle& s = p.slots[i];
+    if (!s.life) continue;
+    const ParticleKindInfo& k = PARTICLE_KINDS[s.kind];
+    s.life--;
+    s.vy -= k.gravity;
+    if (s.vy < -k.maxFall) s.vy = -k.maxFall;
+    if (k.sway) s.vx = constrain(s.vx + rngRange(-k.sway, k.sway + 1, rngParticleState), -k.maxDrift, k.maxDrift);
+    s.x += s.vx;
+    s.y += s.vy;
+    if (s.x < 0 || s.y < 0 || s.x >= WALL_COLS * PARTICLE_ONE || s.y >= WALL_ROWS * PARTICLE_ONE) s.life = 0;
+    if (s.life) live++;
+  }
+  p.live = live;
+}
+
+// Draw every particle that is on a quadrant in canvas[] over the scene,
+// remembering what it covered
+void particlesDraw(ParticlePool& p, const bool* canvas) {
+  for (uint8_t i = 0; i < PARTICLE_MAX; i++) {
+    const Particle& s = p.slots[i];
+    if (!s.life) continue;
+    uint8_t x = s.x / PARTICLE_ONE, y = s.y / PARTICLE_ONE;
+    uint8_t q = wallQuad(x, y);
+    if (q >= NUM_STRIPS_CONNECTED || !canvas[q]) continue;
+    uint16_t index = Panel::index(x % QUAD_COLS, y % QUAD_ROWS);
+    uint8_t* px = strips[q].getPixels() + index * 3;
+
+    ParticleUndo& u = p.undo[p.undoCount++];
+    u.q = q;
+    u.index = index;
+    memcpy(u.grb, px, 3);
+
+    // Strip brightness (as the NeoPixel library applies it), then the fade
+    uint8_t level = s.life < PARTICLE_FADE_FRAMES ? (uint16_t)255 * s.life / PARTICLE_FADE_FRAMES : 255;
+    uint16_t w = (uint32_t)blendWeight(level) * (strips[q].getBrightness() + 1) >> 8;
+    uint8_t grb[3] = {blendScaleByte(s.g, w), blendScaleByte(s.r, w), blendScaleByte(s.b, w)};
+    for (uint8_t c = 0; c < 3; c++) px[c] = PARTICLE_KINDS[s.kind].glow ? blendAddByte(px[c], grb[c]) : grb[c];
+  }
+}
+
+// Put back what the particles covered last frame (newest first, so where
+// two overlapped the scene comes back, not the older particle)
+void particlesErase(ParticlePool& p) {
+  while (p.undoCount) {
+    const ParticleUndo& u = p.undo[--p.undoCount];
+    memcpy(strips[u.q].getPixels() + u.index * 3, u.grb, 3);
+  }
+}
+
+// The scene was redrawn from scratch (the finale's rainbow): nothing of
+// last frame is left to put back
+void particlesForget(ParticlePool& p) {
+  p.undoCount = 0;
+}
+
+// Feed one frame's cost into the budget
+void particlesSettle(ParticlePool& p, unsigned long us) {
+  p.lastUs = us > 0xFFFF ? 0xFFFF : us;
+  if (us > params.particleBudgetUs) {
+    if (p.shed < PARTICLE_SHED_MAX) p.shed++;
+    p.calmFrames = 0;
+  } else if (us <= params.particleBudgetUs / 2 && p.shed > 0 && ++p.calmFrames >= PARTICLE_CALM_FRAMES) {
+    p.shed--;
+    p.calmFrames = 0;
+  }
+}
+
+// One frame: move, draw, and charge the time to the budget
+void particlesFrame(ParticlePool& p, const bool* canvas) {
+  unsigned long start = micros();
+  particlesStep(p);
+  particlesDraw(p, canvas);
+  particlesSettle(p, micros() - start);
+}
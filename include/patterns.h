@@ -1,30 +1,50 @@
 #pragma once
 #include "leds.h"
+#include "modestate.h"
+#include "params.h"
+#include "particles.h"
 
-// Variable to track the color wheel position
-uint16_t introHue = 0;
+// A handful of confetti from a random spot along the top, this often
+const unsigned long FINALE_CONFETTI_MS = 500;
+const uint8_t FINALE_CONFETTI_COUNT = 4;
 
 void introUpdate() {
   // 1. LOGIC: Spin the color wheel FASTER
-  // We increased this from 500 to 3000.
+  // We increased this from 500 to 3000 (params.introHueStep).
   // Bigger number = Bigger jumps around the color wheel = "Faster" strobe effect
-  introHue += 3000;
+  uint16_t& introHue = modeState.intro.hue; // color wheel position
+  introHue += params.introHueStep;
 
   // 2. DRAW: Apply the Rainbow to all strips
   for (int q = 0; q < NUM_STRIPS_CONNECTED; q++) {
     strips[q].rainbow(introHue);
-    strips[q].show();
+    stripShow(q);
   }
 }
 
 void finaleUpdate() {
-  static uint16_t hue = 0;
-  
+  FinaleState& finale = modeState.finale;
+
   // Slower, majestic rainbow for the winner
-  hue += 100; 
+  finale.hue += params.finaleHueStep;
+
+  // Confetti starts a moment after the win, then keeps coming
+  unsigned long now = millis();
+  if (finale.nextConfettiMs == 0) {
+    finale.nextConfettiMs = now + FINALE_CONFETTI_MS;
+  } else if (now >= finale.nextConfettiMs) {
+    particlesBurst(finale.particles, PARTICLE_CONFETTI, rngRange(0, WALL_COLS, rngParticleState), WALL_ROWS - 1,
+                   FINALE_CONFETTI_COUNT);
+    finale.nextConfettiMs = now + FINALE_CONFETTI_MS;
+  }
 
+  // Every quadrant is redrawn and shown every loop: confetti goes anywhere
+  bool canvas[NUM_STRIPS_CONNECTED];
   for (int q = 0; q < NUM_STRIPS_CONNECTED; q++) {
-    strips[q].rainbow(hue);
-    strips[q].show();
+    strips[q].rainbow(finale.hue);
+    canvas[q] = true;
   }
+  particlesForget(finale.particles); // the rainbow already covered last frame's
+  particlesFrame(finale.particles, canvas);
+  for (int q = 0; q < NUM_STRIPS_CONNECTED; q++) stripShow(q);
 }
\ No newline at end of file
@@ -0,0 +1,139 @@
+#pragma once
+#include "config.h"
+
+// --- LOOP PROFILER ---
+// Times sections of loop() (reading the remote, the mode update, every
+// show() per strip, the Round 3 sparkle, the journal, the console and the
+// trailing delay) and keeps min/avg/max plus a histogram for each. Type
+// "prof" in the Serial Monitor to see the numbers, "prof reset" to start
+// counting again.
+//
+// Only built in when LOOP_PROFILER is defined (pio run -e profile). In
+// other builds the PROF_* macros are empty and cost nothing.
+//
+// On the board the clock is the Cortex-M4 DWT cycle counter (one tick per
+// CPU cycle). On the host it is std::chrono, so the same macros measure
+// host CPU time there (the virtual clock's show() and delay() costs are
+// not included).
+
+enum ProfSection : uint8_t {
+  PROF_LOOP,      // the whole loop() body, delay included (one frame)
+  PROF_REMOTE,    // readRemote()
+  PROF_MODE,      // modesUpdate() (includes the shows and sparkle below)
+  PROF_SHOW,      // stripShow(0); one section per connected strip follows
+  PROF_SHOW_LAST = PROF_SHOW + NUM_STRIPS_CONNECTED - 1,
+  PROF_SPARKLE,   // randomFlashUpdate()
+  PROF_JOURNAL,   // journalService()
+  PROF_SERIAL,    // consoleService() and telemetryService()
+  PROF_HUD,       // hudUpdate() (only the loops that redraw the matrix)
+  PROF_DELAY,     // the pause at the end of loop()
+  PROF_SECTIONS
+};
+
+#ifdef LOOP_PROFILER
+
+#if defined(ARDUINO_ARCH_RENESAS)
+// DWT->CYCCNT counts CPU cycles and wraps every ~89 s at 48 MHz, which is
+// fine: we only ever subtract two nearby readings.
+inline void profClockBegin() {
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+inline uint32_t profNow() { return DWT->CYCCNT; }
+inline uint32_t profTicksPerUs() { return SystemCoreClock / 1000000UL; }
+#else
+#include <chrono>
+inline void profClockBegin() {}
+inline uint32_t profNow() {
+  using namespace std::chrono;
+  return (uint32_t)duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+inline uint32_t profTicksPerUs() { return 1000; }
+#endif
+
+// Histogram bucket b counts sections that took less than 2^b us (bucket 0:
+// under 1 us); the last bucket takes everything from 2^14 us = 16 ms up.
+const uint8_t PROF_BUCKETS = 16;
+
+struct ProfStats {
+  uint32_t count;
+  uint32_t minTicks;
+  uint32_t maxTicks;
+  uint64_t totalTicks;
+  uint32_t buckets[PROF_BUCKETS];
+};
+
+ProfStats profStats[PROF_SECTIONS];
+
+// The show sections share one name, printed with the strip number
+const char* const PROF_NAMES[PROF_SECTIONS - NUM_STRIPS_CONNECTED + 1] = {
+  "loop", "remote", "mode", "show", "sparkle", "journal", "serial", "hud", "delay"
+};
+
+void profReset() {
+  memset(profStats, 0, sizeof(profStats));
+  for (uint8_t s = 0; s < PROF_SECTIONS; s++) profStats[s].minTicks = UINT32_MAX;
+}
+
+void profBegin() {
+  profClockBegin();
+  profReset();
+}
+
+void profRecord(uint8_t section, uint32_t ticks) {
+  ProfStats& st = profStats[section];
+  st.count++;
+  st.totalTicks += ticks;
+  if (ticks < st.minTicks) st.minTicks = ticks;
+  if (ticks > st.maxTicks) st.maxTicks = ticks;
+  uint32_t us = ticks / profTicksPerUs();
+  uint8_t b = us ? 32 - __builtin_clz(us) : 0;
+  st.buckets[b < PROF_BUCKETS ? b : PROF_BUCKETS - 1]++;
+}
+
+// Print a tick count as microseconds with one decimal (e.g. "12.3")
+void profPrintUs(uint64_t ticks) {
+  uint64_t tenths = ticks * 10 / profTicksPerUs();
+  Serial.print((unsigned long)(tenths / 10));
+  Serial.print('.');
+  Serial.print((unsigned long)(tenths % 10));
+}
+
+// One line per section: count, min/avg/max in us, then the non-empty
+// histogram buckets as "<limit us:count"
+void profPrintSection(uint8_t section) {
+  const ProfStats& st = profStats[section];
+  if (section < PROF_SHOW) Serial.print(PROF_NAMES[section]);
+  else if (section > PROF_SHOW_LAST) Serial.print(PROF_NAMES[section - NUM_STRIPS_CONNECTED + 1]);
+  else { Serial.print(PROF_NAMES[PROF_SHOW]); Serial.print(section - PROF_SHOW); }
+  Serial.print(" n="); Serial.print((unsigned long)st.count);
+  if (st.count) {
+    Serial.print(" min="); profPrintUs(st.minTicks);
+    Serial.print(" avg="); profPrintUs(st.totalTicks / st.count);
+    Serial.print(" max="); profPrintUs(st.maxTicks);
+    Serial.print(" us |");
+    for (uint8_t b = 0; b < PROF_BUCKETS; b++) {
+      if (!st.buckets[b]) continue;
+      Serial.print(b == PROF_BUCKETS - 1 ? " >=" : " <");
+      Serial.print(1UL << (b == PROF_BUCKETS - 1 ? b - 1 : b));
+      Serial.print(':'); Serial.print((unsigned long)st.buckets[b]);
+    }
+  }
+  Serial.println();
+}
+
+#define PROF_BEGIN(section) uint32_t profStart_##section = profNow()
+#define PROF_END(section) profRecord(section, profNow() - profStart_##section)
+// Close a section timed as `section` but record it under `section + index`
+// (used for the per-strip show() timings)
+#define PROF_END_AT(section, index) profRecord((section) + (index), profNow() - profStart_##section)
+
+#else
+
+inline void profBegin() {}
+#define PROF_BEGIN(section) ((void)0)
+#define PROF_END(section) ((void)0)
+#define PROF_END_AT(section, index) ((void)(index))
+
+#endif
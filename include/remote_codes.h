@@ -0,0 +1,22 @@
+#pragma once
+
+// --- REMOTE CODES ---
+// These hex codes match the specific remote control being used. Kept on
+// their own so the host tests and the scenario runner press the same keys
+// the game listens for (remote.h).
+#define CODE_CH_MINUS  0xBA45FF00
+#define CODE_CH_PLUS   0xB847FF00
+#define CODE_0  0xE916FF00
+#define CODE_1  0xF30CFF00
+#define CODE_2  0xE718FF00
+#define CODE_3  0xA15EFF00
+#define CODE_4  0xF708FF00
+#define CODE_5  0xE31CFF00
+#define CODE_7  0xBD42FF00
+#define CODE_8  0xAD52FF00
+#define CODE_9  0xB54AFF00
+#define CODE_PREV  0xBB44FF00
+#define CODE_NEXT  0xBF40FF00
+#define CODE_PAUSE 0xBC43FF00
+#define CODE_LOSE  0xE619FF00
+#define CODE_WIN 0xF20DFF00
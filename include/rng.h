@@ -0,0 +1,37 @@
+#pragma once
+#include <stdint.h>
+
+// --- GAME RANDOMNESS ---
+// The flicker timing (effects.h) and the Round 3 flashes (round3.h) draw
+// from this generator instead of Arduino's random(), so a run can be
+// repeated exactly: the host scenario runner seeds it per scenario and
+// gets the same frames every time. On the board setup() seeds it from the
+// boot clock, like randomSeed() did before.
+//
+// xorshift32: a few shifts per number, plenty for lighting effects.
+//
+// The particles (particles.h) draw from a stream of their own, so how many
+// sparks fly never moves the flicker and flash timing a scenario was
+// written against.
+
+uint32_t rngState = 1;
+uint32_t rngParticleState = 1;
+
+void rngSeed(uint32_t seed) {
+  rngState = seed ? seed : 1;
+  rngParticleState = rngState ^ 0x9E3779B9;
+  if (!rngParticleState) rngParticleState = 1;
+}
+
+uint32_t rngNext(uint32_t& state = rngState) {
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
+
+// A number from lo up to (not including) hi, like random(lo, hi)
+long rngRange(long lo, long hi, uint32_t& state = rngState) {
+  if (hi <= lo) return lo;
+  return lo + (long)(rngNext(state) % (uint32_t)(hi - lo));
+}
@@ -0,0 +1,233 @@
+#pragma once
+#include "leds.h"
+#include "modestate.h"
+#include "journal.h"
+#include "rng.h"
+
+// --- ROUND 3 ---
+// Top-left starts blue, top-right starts green. CODE_NEXT turns the first
+// green column (from the left) blue, CODE_PREV turns the last blue column
+// (from the right) green, so the boundary walks across both top quadrants.
+// The bottom quadrants show red X's, and the top quadrants sparkle with
+// random short flashes.
+
+// --- TRACK ---
+// The two top quadrants form one 36-column track: columns 0-17 are the
+// top-left quadrant, 18-35 the top-right. Each column's colour is one bit
+// of a 64-bit mask, so finding the boundary is a single count-zeros
+// instruction instead of a scan, and a press only has to repaint the one
+// column that changed.
+#define TRACK_COLS (2 * QUAD_COLS)
+static_assert(TRACK_COLS < 64, "the track is one bit per column of a 64-bit mask");
+const uint64_t TRACK_ALL = (1ULL << TRACK_COLS) - 1;
+// Columns that start green (the whole top-right quadrant)
+const uint64_t TRACK_START_GREEN = TRACK_ALL & ~((1ULL << QUAD_COLS) - 1);
+// When several columns have to change at once they are painted one at a
+// time, params.sweepMs apart, so the boundary visibly sweeps instead of
+// jumping
+
+uint32_t trackBlue() { return strips[0].Color(0, 0, 255); }
+uint32_t trackGreen() { return strips[0].Color(0, 255, 0); }
+
+// First green column from the left, or TRACK_COLS if there is none
+uint8_t trackFirstGreen(uint64_t greenMask) {
+  return greenMask ? __builtin_ctzll(greenMask) : TRACK_COLS;
+}
+
+// Last blue column from the left, or -1 if there is none
+int8_t trackLastBlue(uint64_t greenMask) {
+  uint64_t blue = ~greenMask & TRACK_ALL;
+  return blue ? 63 - __builtin_clzll(blue) : -1;
+}
+
+// Paint one column of the LEDs towards greenMask. Columns turning blue are
+// painted left to right and columns turning green right to left, so a
+// multi-column move sweeps in the direction the boundary travels.
+// Returns false when the LEDs already match.
+bool trackStep() {
+  Round3State& r3 = modeState.r3;
+  uint64_t toBlue = r3.shownGreen & ~r3.greenMask;
+  uint64_t toGreen = r3.greenMask & ~r3.shownGreen;
+  uint8_t col;
+  uint32_t color;
+  if (toBlue) {
+    col = __builtin_ctzll(toBlue);
+    color = trackBlue();
+  } else if (toGreen) {
+    col = 63 - __builtin_clzll(toGreen);
+    color = trackGreen();
+  } else {
+    return false;
+  }
+
+  r3.shownGreen ^= 1ULL << col;
+  uint8_t q = col < QUAD_COLS ? Q_TOP_LEFT : Q_TOP_RIGHT;
+  drawColumn(q, col % QUAD_COLS, color);
+  latencyTarget(q);
+  stripShow(q);
+  r3.nextSweepMs = millis() + params.sweepMs;
+  return true;
+}
+
+// Paint straight away unless a sweep is still in progress; round3Update()
+// finishes whatever is left.
+void trackRefresh() {
+  if (millis() >= modeState.r3.nextSweepMs) trackStep();
+}
+
+// How many columns (from the left) are blue
+uint8_t trackBlueCols() {
+  return trackFirstGreen(modeState.r3.greenMask);
+}
+
+// Move the boundary so the first `blueCols` columns are blue. Big moves
+// sweep across the track one column per params.sweepMs.
+void trackSetBoundary(uint8_t blueCols) {
+  if (blueCols > TRACK_COLS) blueCols = TRACK_COLS;
+  modeState.r3.greenMask = TRACK_ALL & ~((1ULL << blueCols) - 1);
+  journalLogBoundary(blueCols);
+  trackRefresh();
+}
+
+// Put the boundary at `blueCols` and repaint the whole track at once
+// (no sweep). Used when resuming after a reset.
+void trackJumpTo(uint8_t blueCols) {
+  Round3State& r3 = modeState.r3;
+  if (blueCols > TRACK_COLS) blueCols = TRACK_COLS;
+  r3.greenMask = TRACK_ALL & ~((1ULL << blueCols) - 1);
+  r3.shownGreen = r3.greenMask;
+  for (uint8_t col = 0; col < TRACK_COLS; col++) {
+    uint8_t q = col < QUAD_COLS ? Q_TOP_LEFT : Q_TOP_RIGHT;
+    drawColumn(q, col % QUAD_COLS, col < blueCols ? trackBlue() : trackGreen());
+  }
+  stripShow(Q_TOP_LEFT);
+  stripShow(Q_TOP_RIGHT);
+  journalLogBoundary(blueCols);
+}
+
+// Colour the track says pixel physIdx of top quadrant q should have
+// (the turn LEDs are always off)
+uint32_t trackColorAt(uint8_t q, uint16_t physIdx) {
+  uint8_t x, y;
+  if (!Panel::pixelAt(physIdx, x, y)) return 0;
+  uint8_t col = (q == Q_TOP_LEFT ? 0 : QUAD_COLS) + x;
+  return (modeState.r3.shownGreen >> col) & 1 ? trackGreen() : trackBlue();
+}
+
+// --- Random transient flashes (independent of CODE_PREV/CODE_NEXT) ---
+// These randomly pick LEDs in the top quadrants and flash them a random
+// color for a short duration, then restore the track colour underneath.
+// How often, how long and how many: params.flashTickMs, flashMs and
+// flashAttempts (see params.h)
+
+// Pick random candidate LEDs in top quadrants and possibly start flashes
+void randomFlashTryStart() {
+  Round3State& r3 = modeState.r3;
+  if (millis() < r3.nextFlashTick) return;
+  r3.nextFlashTick = millis() + params.flashTickMs;
+
+  for (int a = 0; a < params.flashAttempts; a++) {
+    // choose top-left or top-right
+    int q = (rngRange(0, 2) == 0) ? Q_TOP_LEFT : Q_TOP_RIGHT;
+    // choose a usable coordinate inside QUAD_COLS x QUAD_ROWS
+    int x = rngRange(0, QUAD_COLS);
+    int y = rngRange(0, QUAD_ROWS);
+    uint16_t physIdx = xyToIndex(x, y);
+    int flat = q * LEDS_PER_QUAD + physIdx;
+
+    if (r3.flashActive[flat]) continue; // already flashing
+
+    // 1/10 chance to start a flash for this candidate
+    if (rngRange(0, 8) != 0) continue;
+
+    // Start the flash with a random color
+    uint8_t r = rngRange(0, 256);
+    uint8_t g = rngRange(0, 256);
+    uint8_t b = rngRange(0, 256);
+    uint32_t newc = strips[q].Color(r, g, b);
+    strips[q].setPixelColor(physIdx, newc);
+    r3.flashActive[flat] = true;
+    r3.flashEndTime[flat] = millis() + params.flashMs;
+  }
+}
+
+// Update active flashes and restore colors when their duration ends.
+// The colour comes from the track, so a column that changed while one of
+// its pixels was flashing still ends up right.
+void randomFlashUpdate() {
+  Round3State& r3 = modeState.r3;
+  bool dirty[NUM_STRIPS_CONNECTED] = {};
+  unsigned long now = millis();
+  for (int q = Q_TOP_LEFT; q <= Q_TOP_RIGHT; q++) {
+    for (uint16_t physIdx = 0; physIdx < LEDS_PER_QUAD; physIdx++) {
+      int flat = q * LEDS_PER_QUAD + physIdx;
+      if (!r3.flashActive[flat]) continue;
+      if (now >= r3.flashEndTime[flat]) {
+        strips[q].setPixelColor(physIdx, trackColorAt(q, physIdx));
+        r3.flashActive[flat] = false;
+        r3.flashEndTime[flat] = 0;
+        dirty[q] = true;
+      }
+    }
+  }
+  // Push updates for quadrants that changed
+  for (int q = Q_TOP_LEFT; q <= Q_TOP_RIGHT; q++) if (dirty[q]) stripShow(q);
+}
+
+// Enter MODE_R3: set up the two top colours and the bottom X's
+void round3Enter() {
+  Round3State& r3 = modeState.r3;
+  // Clear and set quadrant visuals for MODE_R3
+  ledsAllOff();
+  // Top-left: blue, Top-right: green (changed for R3 start)
+  fillQuad(Q_TOP_LEFT, trackBlue());
+  fillQuad(Q_TOP_RIGHT, trackGreen());
+
+  // Bottom-left and bottom-right: draw the same 3-pixel-wide red X as MODE_R2
+  drawRedX(Q_BOTTOM_LEFT);
+  drawRedX(Q_BOTTOM_RIGHT);
+
+  r3.greenMask = TRACK_START_GREEN;
+  r3.shownGreen = TRACK_START_GREEN;
+}
+
+void round3Update() {
+  // Finish any multi-column sweep, one column per params.sweepMs
+  trackRefresh();
+
+  // Random transient flashes (independent of CODE_PREV/CODE_NEXT)
+  // Try to start new flashes and update active ones
+  randomFlashTryStart();
+  PROF_BEGIN(PROF_SPARKLE);
+  randomFlashUpdate();
+  PROF_END(PROF_SPARKLE);
+}
+
+// CODE_NEXT: turn the first GREEN column from the left BLUE
+void round3Next() {
+  Round3State& r3 = modeState.r3;
+  uint8_t col = trackFirstGreen(r3.greenMask);
+  if (col >= TRACK_COLS) return; // already all blue
+  r3.greenMask &= ~(1ULL << col);
+  journalLogBoundary(trackBlueCols());
+  trackRefresh();
+}
+
+// CODE_PREV: turn the last BLUE column from the left (first from the
+// right) GREEN
+void round3Prev() {
+  Round3State& r3 = modeState.r3;
+  int8_t col = trackLastBlue(r3.greenMask);
+  if (col < 0) return; // already all green
+  r3.greenMask |= 1ULL << col;
+  journalLogBoundary(trackBlueCols());
+  trackRefresh();
+}
+
+// Resume MODE_R3 after a reset: same scene as round3Enter() but with the
+// boundary where it was, and without the ledsAllOff() pause
+void round3Resume() {
+  drawRedX(Q_BOTTOM_LEFT);
+  drawRedX(Q_BOTTOM_RIGHT);
+  trackJumpTo(journalResumed.r3BlueCols);
+}
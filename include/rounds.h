@@ -1,33 +1,133 @@
 #pragma once
 #include "leds.h"
 #include "beams.h"
+#include "modestate.h"
+#include "journal.h"
+#include "particles.h"
 
 // Score tracking: How many rows are filled in each quadrant?
-uint8_t r1Rows[4] = {0,0,0,0};
+// (Lives in the mode arena while MODE_R1 or MODE_R4 runs)
+uint8_t* const r1Rows = modeState.r1.rows;
+
+// --- JAR RENDERING ---
+// The jar border is drawn once when the round starts. After that a point
+// only repaints the single interior row that changed: the new row of honey
+// fades in over params.jarRiseMs. Points that arrive while a row is still
+// rising wait their turn, so every ball gets its own visible rise.
+const uint8_t JAR_RISE_STEPS = 6;            // brightness steps during a rise
+const uint8_t JAR_MAX_ROWS = QUAD_ROWS - 2;  // interior can hold up to (QUAD_ROWS - 2) rows
+
+// Brighter fuchsia border
+uint32_t jarBorderColor() {
+  return strips[0].Color(255, 120, 255);
+}
+
+// Honey colour at a fade step (JAR_RISE_STEPS = full honey)
+uint32_t jarHoneyColor(uint8_t step) {
+  uint8_t level = (uint16_t)128 * step / JAR_RISE_STEPS;
+  return strips[0].Color(level, level, 0);
+}
+
+// Move the rising row of quadrant q one step along, if it's time.
+// Returns true if a pixel actually changed (the strip needs a show()).
+bool jarAnimate(uint8_t q) {
+  Round1State& r1 = modeState.r1;
+  if (r1.shownRows[q] >= r1.rows[q]) return false; // jar already shows the score
+
+  unsigned long now = millis();
+  if (r1.riseStep[q] == 0) r1.riseStartMs[q] = now; // start the next queued row
+  unsigned long elapsed = now - r1.riseStartMs[q];
+  unsigned long step = 1 + elapsed * JAR_RISE_STEPS / params.jarRiseMs;
+  if (step > JAR_RISE_STEPS) step = JAR_RISE_STEPS;
+  if (step == r1.riseStep[q]) return false; // nothing new to show yet
+
+  drawJarRow(q, r1.shownRows[q], jarHoneyColor(step));
+  r1.riseStep[q] = step;
+  if (step == JAR_RISE_STEPS) {
+    // Row finished rising; the next queued row (if any) starts next loop
+    r1.shownRows[q]++;
+    r1.riseStep[q] = 0;
+  }
+  return true;
+}
+
+// Sparks and a few honey drips fly up from where the new row will be
+void jarBurst(uint8_t q) {
+  uint8_t x = wallX(q, QUAD_COLS / 2), y = wallY(q, 1 + r1Rows[q]);
+  particlesBurst(modeState.r1.particles, PARTICLE_SPARK, x, y, 10);
+  particlesBurst(modeState.r1.particles, PARTICLE_DRIP, x, y, 4);
+}
 
 void round1Update() {
+  // Each quadrant is shown at most once, after the particles are drawn.
+  // They only ride along on the shows of a rising jar (see particles.h).
+  bool dirty[NUM_STRIPS_CONNECTED] = {};
+  bool canvas[NUM_STRIPS_CONNECTED] = {};
+  ParticlePool& particles = modeState.r1.particles;
+  particlesErase(particles);
+
   for (int q = 0; q < NUM_STRIPS_CONNECTED; q++) {
     
     // 1. Check if a ball passed through the beam
     if (beamBroken(q)) {
-      // Interior can hold up to (QUAD_ROWS - 2) rows
-      int maxInteriorRows = QUAD_ROWS - 2;
-      if (r1Rows[q] < maxInteriorRows) {
+      latencyOpen(LAT_BEAM, latencyBeamClearUs(q));
+      if (r1Rows[q] < JAR_MAX_ROWS) {
         r1Rows[q]++; // Increase score
-        Serial.print("Point for Quad "); Serial.println(q);
+        latencyTarget(q);
+        journalLogRows(q, r1Rows[q]);
+        LOG_INFO(TEV_POINT, q | r1Rows[q] << 8);
+        jarBurst(q);
       }
     }
 
-    // 2. Draw the jar border (fuchsia) and interior honey gradient in a single pass
-    // Use a brighter fuchsia border and specified top honey color for gradient
-    drawJarWithProgress(q, r1Rows[q], strips[q].Color(255, 120, 255), 240, 240, 150); // Brighter fuchsia border, top honey (240,240,150)
+    // 2. Grow the honey towards the score (only touches the rising row).
+    // Once the jar has caught up this is its last show, so no particles.
+    if (jarAnimate(q)) {
+      dirty[q] = true;
+      canvas[q] = modeState.r1.shownRows[q] < r1Rows[q];
+    }
+    latencyClose();
   }
+
+  // 3. Particles over the rising jars, then push every quadrant that changed
+  particlesFrame(particles, canvas);
+  for (int q = 0; q < NUM_STRIPS_CONNECTED; q++) if (dirty[q]) stripShow(q);
 }
 
-// Reset Round 1 scores
+// Reset Round 1 scores (and forget any rows still waiting to rise)
 void round1Reset() {
-  for (int i = 0; i < 4; i++) {
+  for (int i = 0; i < NUM_STRIPS_CONNECTED; i++) {
     r1Rows[i] = 0;
+    modeState.r1.shownRows[i] = 0;
+    modeState.r1.riseStep[i] = 0;
   }
   Serial.println("Round 1: Scores Reset");
-}
\ No newline at end of file
+}
+
+// Enter MODE_R1 (and MODE_R4): start from an empty board and empty jars
+void round1Enter() {
+  ledsAllOff();
+  round1Reset();
+  beamsReset();
+  // The border never changes during the round, so draw it once here
+  for (int q = 0; q < NUM_STRIPS_CONNECTED; q++) {
+    drawJarBorder(q, jarBorderColor());
+  }
+}
+
+// Resume MODE_R1 / MODE_R4 after a reset: draw each jar at its saved level
+// straight away (no rise animation)
+void round1Resume() {
+  round1Reset();
+  beamsReset();
+  for (int q = 0; q < NUM_STRIPS_CONNECTED; q++) {
+    uint8_t rows = journalResumed.r1Rows[q];
+    if (rows > JAR_MAX_ROWS) rows = JAR_MAX_ROWS;
+    drawJarBorder(q, jarBorderColor()); // clears and shows the border
+    for (uint8_t row = 0; row < rows; row++) drawJarRow(q, row, jarHoneyColor(JAR_RISE_STEPS));
+    if (rows > 0) stripShow(q);
+    r1Rows[q] = rows;
+    modeState.r1.shownRows[q] = rows;
+    journalLogRows(q, rows);
+  }
+}
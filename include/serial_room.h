@@ -0,0 +1,33 @@
+#pragma once
+#include <Arduino.h>
+
+// --- ROOM IN THE SERIAL OUTPUT ---
+// telemetry.h, feed.h, console.h and boot.h never write more in one loop
+// than serialRoom() says Serial can take without write() waiting, so a
+// slow link never holds up the lights.
+//
+// On the UNO R4 WiFi, Serial is the core's UART class: write() waits until
+// each byte is out (it has no transmit buffer) and availableForWrite() is
+// Print's default, which is always 0. There 0 means "not known", not
+// "full", so serialRoom() hands out SERIAL_LOOP_BYTES instead: about 3.5 ms
+// of waiting at 115200 baud, enough for a console line or any one record.
+// Where Serial reports real room (TinyUSB CDC on the R4 Minima, the host
+// shim) 0 really is full and nothing is written. A host test that charges
+// the UART like the WiFi board's builds with -D SERIAL_REPORTS_ROOM=0.
+#ifndef SERIAL_REPORTS_ROOM
+#if defined(ARDUINO_UNOR4_WIFI)
+#define SERIAL_REPORTS_ROOM 0
+#else
+#define SERIAL_REPORTS_ROOM 1
+#endif
+#endif
+
+const uint8_t SERIAL_LOOP_BYTES = 40;
+
+int serialRoom() {
+#if SERIAL_REPORTS_ROOM
+  return Serial.availableForWrite();
+#else
+  return SERIAL_LOOP_BYTES;
+#endif
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include "config.h"
+#include "telemetry_events.h"
+#include "serial_room.h"
+
+// --- TELEMETRY ---
+// Game events (beam broken, point scored, mode switched, ...) used to be
+// printed as text at 9600 baud, about 1 ms per character, right when a
+// point was scored. Now they are 9-byte binary records (telemetry_events.h)
+// queued in RAM and sent a couple at a time from loop() by
+// telemetryService(). Turn the stream back into readable lines with the
+// decoder: pio run -e decode_telemetry (see README).
+//
+// Log levels are chosen at compile time: calls above LOG_LEVEL are removed
+// entirely. Build with e.g. -D LOG_LEVEL=LOG_LEVEL_DEBUG to see every beam.
+#define LOG_LEVEL_NONE  0
+#define LOG_LEVEL_WARN  1
+#define LOG_LEVEL_INFO  2
+#define LOG_LEVEL_DEBUG 3
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+// Queued records waiting to go out (a power of two)
+const uint16_t TELEMETRY_BUFFER_BYTES = 256;
+// Sent per loop: two records is ~1.6 ms of wire time at 115200 baud
+const uint8_t TELEMETRY_DRAIN_BYTES = 2 * TELEMETRY_FRAME_BYTES;
+
+uint8_t telemetryBuf[TELEMETRY_BUFFER_BYTES];
+uint16_t telemetryHead = 0;     // next byte to write
+uint16_t telemetryTail = 0;     // next byte to send
+uint16_t telemetryDropped = 0;  // records lost since the last TEV_DROPPED
+
+uint16_t telemetryQueued() {
+  return (telemetryHead - telemetryTail) & (TELEMETRY_BUFFER_BYTES - 1);
+}
+
+uint16_t telemetryFree() {
+  return TELEMETRY_BUFFER_BYTES - 1 - telemetryQueued();
+}
+
+void telemetryPush(uint8_t event, uint16_t arg) {
+  uint32_t now = millis();
+  uint8_t frame[TELEMETRY_FRAME_BYTES] = {
+    TELEMETRY_SYNC, event, (uint8_t)arg, (uint8_t)(arg >> 8),
+    (uint8_t)now, (uint8_t)(now >> 8), (uint8_t)(now >> 16), (uint8_t)(now >> 24), 0
+  };
+  frame[TELEMETRY_FRAME_BYTES - 1] = telemetryCheck(frame);
+  for (uint8_t i = 0; i < TELEMETRY_FRAME_BYTES; i++) {
+    telemetryBuf[telemetryHead] = frame[i];
+    telemetryHead = (telemetryHead + 1) & (TELEMETRY_BUFFER_BYTES - 1);
+  }
+}
+
+// Queue one record. Never waits: if the buffer is full the record is
+// counted and a TEV_DROPPED record says how many went missing.
+void telemetryLog(uint8_t event, uint16_t arg) {
+  if (telemetryDropped) {
+    if (telemetryFree() < 2 * TELEMETRY_FRAME_BYTES) { telemetryDropped++; return; }
+    telemetryPush(TEV_DROPPED, telemetryDropped);
+    telemetryDropped = 0;
+  }
+  if (telemetryFree() < TELEMETRY_FRAME_BYTES) { telemetryDropped = 1; return; }
+  telemetryPush(event, arg);
+}
+
+// Call every loop: sends a few queued bytes, never more than the UART has
+// room for (serial_room.h) nor TELEMETRY_DRAIN_BYTES per loop. With no
+// room at all it sends nothing and tries again next loop.
+void telemetryService() {
+  uint16_t n = telemetryQueued();
+  if (n == 0) return;
+  if (n > TELEMETRY_DRAIN_BYTES) n = TELEMETRY_DRAIN_BYTES;
+  int room = serialRoom();
+  if (room <= 0) return;
+  if ((uint16_t)room < n) n = room;
+  while (n--) {
+    Serial.write(telemetryBuf[telemetryTail]);
+    telemetryTail = (telemetryTail + 1) & (TELEMETRY_BUFFER_BYTES - 1);
+  }
+}
+
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_WARN(event, arg) telemetryLog(event, arg)
+#else
+#define LOG_WARN(event, arg) ((void)0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(event, arg) telemetryLog(event, arg)
+#else
+#define LOG_INFO(event, arg) ((void)0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(event, arg) telemetryLog(event, arg)
+#else
+#define LOG_DEBUG(event, arg) ((void)0)
+#endif
@@ -0,0 +1,89 @@
+#pragma once
+#include <stdio.h>
+#include <string.h>
+#include "telemetry_events.h"
+
+// --- TELEMETRY DECODER (host only) ---
+// Turns the board's Serial stream back into readable lines:
+//   [   12.345] point      quad 2, rows 5
+// Bytes that are not part of a valid record (startup messages, console
+// replies) are passed through as they are. Used by src/decode_telemetry.cpp
+// and the host tests.
+
+const char* const TELEMETRY_EVENT_NAMES[TEV_COUNT] = {
+  "dropped", "beam", "point", "mode", "round_over",
+  "r2_locked", "r2_armed", "r2_lose", "unknown_key", "latency"
+};
+
+// Same order as Mode in config.h
+const char* const TELEMETRY_MODE_NAMES[] = {
+  "MODE_OFF", "MODE_INTRO", "MODE_R1", "MODE_R2", "MODE_R3", "MODE_R4", "MODE_FINALE"
+};
+
+// Same order as EffectKind in modestate.h
+const char* const TELEMETRY_EFFECT_NAMES[] = {
+  "none", "steady", "flicker", "flicker_fast", "lose", "lost", "locked"
+};
+
+struct TelemetryDecoder {
+  uint8_t frame[TELEMETRY_FRAME_BYTES];
+  uint8_t have;          // bytes of a possible record collected so far
+  unsigned long records; // good records decoded
+  unsigned long bad;     // sync bytes that didn't start a valid record
+};
+
+// Format one record's event and argument (no timestamp, no newline)
+void telemetryDescribe(uint8_t event, uint16_t arg, char* out, size_t len) {
+  const char* name = event < TEV_COUNT ? TELEMETRY_EVENT_NAMES[event] : "?";
+  uint8_t lo = arg & 0xFF, hi = arg >> 8;
+  switch (event) {
+    case TEV_POINT:
+    case TEV_ROUND_OVER:
+      snprintf(out, len, "%-11s quad %u, rows %u", name, lo, hi);
+      break;
+    case TEV_MODE:
+      snprintf(out, len, "%-11s %s", name, arg < 7 ? TELEMETRY_MODE_NAMES[arg] : "?");
+      break;
+    case TEV_R2_ARMED:
+      snprintf(out, len, "%-11s %s", name, arg < 7 ? TELEMETRY_EFFECT_NAMES[arg] : "?");
+      break;
+    case TEV_UNKNOWN_KEY:
+      snprintf(out, len, "%-11s 0x%04XFF00", name, arg);
+      break;
+    case TEV_LATENCY:
+      snprintf(out, len, "%-11s %u ms", name, arg);
+      break;
+    case TEV_DROPPED:
+      snprintf(out, len, "%-11s %u records lost", name, arg);
+      break;
+    default:
+      snprintf(out, len, "%-11s %u", name, arg);
+      break;
+  }
+}
+
+// Feed one byte. Complete records go to onRecord(millis, event, arg);
+// anything else goes to onText(byte).
+void telemetryDecodeByte(TelemetryDecoder& d, uint8_t c,
+                         void (*onRecord)(uint32_t ms, uint8_t event, uint16_t arg),
+                         void (*onText)(uint8_t c)) {
+  if (d.have == 0 && c != TELEMETRY_SYNC) { onText(c); return; }
+  d.frame[d.have++] = c;
+  if (d.have < TELEMETRY_FRAME_BYTES) return;
+
+  if (d.frame[TELEMETRY_FRAME_BYTES - 1] == telemetryCheck(d.frame) && d.frame[1] < TEV_COUNT) {
+    uint16_t arg = d.frame[2] | d.frame[3] << 8;
+    uint32_t ms = d.frame[4] | d.frame[5] << 8 | d.frame[6] << 16 | (uint32_t)d.frame[7] << 24;
+    d.have = 0;
+    d.records++;
+    onRecord(ms, d.frame[1], arg);
+    return;
+  }
+  // Not a record after all: the first byte was text, try again from the next
+  d.bad++;
+  onText(d.frame[0]);
+  uint8_t rest[TELEMETRY_FRAME_BYTES - 1];
+  memcpy(rest, d.frame + 1, sizeof(rest));
+  d.have = 0;
+  for (uint8_t i = 0; i < sizeof(rest); i++) telemetryDecodeByte(d, rest[i], onRecord, onText);
+}
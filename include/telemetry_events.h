@@ -0,0 +1,34 @@
+#pragma once
+#include <stdint.h>
+
+// --- TELEMETRY RECORD FORMAT ---
+// Shared by the game (telemetry.h) and the host decoder
+// (telemetry_decode.h), so both always agree on the bytes.
+//
+// Every record is 9 bytes:
+//   [0xA5] [event] [arg lo] [arg hi] [millis, 4 bytes little-endian] [check]
+// check is the sum of the 8 bytes before it. Plain text (startup messages,
+// console replies) can sit between records; the decoder passes it through.
+
+const uint8_t TELEMETRY_SYNC = 0xA5;
+const uint8_t TELEMETRY_FRAME_BYTES = 9;
+
+enum TelemetryEvent : uint8_t {
+  TEV_DROPPED,      // arg: records lost because the buffer was full
+  TEV_BEAM,         // arg: beam that was broken
+  TEV_POINT,        // arg: quad | rows << 8 (Round 1 score)
+  TEV_MODE,         // arg: Mode the remote switched to
+  TEV_ROUND_OVER,   // arg: quad | rows << 8 (one per quad when Round 1/4 ends)
+  TEV_R2_LOCKED,    // arg: quad locked red
+  TEV_R2_ARMED,     // arg: EffectKind the selectors will apply
+  TEV_R2_LOSE,      // arg: quad running the lose sequence
+  TEV_UNKNOWN_KEY,  // arg: top 16 bits of the remote code (command byte + inverse)
+  TEV_LATENCY,      // arg: ms from an input until it was fully shown (latency.h)
+  TEV_COUNT
+};
+
+inline uint8_t telemetryCheck(const uint8_t* frame) {
+  uint8_t sum = 0;
+  for (uint8_t i = 0; i < TELEMETRY_FRAME_BYTES - 1; i++) sum += frame[i];
+  return sum;
+}
@@ -0,0 +1,49 @@
+// RA4M1 data flash through the FSP low-power flash driver that ships with
+// the UNO R4 core. Blocking mode: every call returns when the flash is done.
+#include "DataFlash.h"
+#include "r_flash_lp.h"
+
+// Where the data flash sits in the RA4M1 memory map
+static const uint32_t DATA_FLASH_BASE = 0x40100000;
+
+static flash_lp_instance_ctrl_t flashCtrl;
+static flash_cfg_t flashCfg;
+static bool flashOpen = false;
+
+bool dataFlashBegin() {
+  if (flashOpen) return true;
+  flashCfg.data_flash_bgo = false; // no background operation, no interrupts needed
+  flashCfg.p_callback = nullptr;
+  flashCfg.p_context = nullptr;
+  flashCfg.p_extend = nullptr;
+  flashCfg.irq = FSP_INVALID_VECTOR;
+  flashCfg.err_irq = FSP_INVALID_VECTOR;
+  flashCfg.ipl = 0;
+  flashCfg.err_ipl = 0;
+  flashOpen = R_FLASH_LP_Open(&flashCtrl, &flashCfg) == FSP_SUCCESS;
+  return flashOpen;
+}
+
+void dataFlashRead(uint32_t offset, uint8_t* dst, uint32_t len) {
+  if (offset + len > DATA_FLASH_BYTES) return;
+  // Data flash is memory mapped, so reading is a plain copy
+  memcpy(dst, (const void*)(DATA_FLASH_BASE + offset), len);
+}
+
+bool dataFlashIsBlank(uint32_t offset, uint32_t len) {
+  if (!flashOpen || offset + len > DATA_FLASH_BYTES) return false;
+  flash_result_t result;
+  if (R_FLASH_LP_BlankCheck(&flashCtrl, DATA_FLASH_BASE + offset, len, &result) != FSP_SUCCESS) return false;
+  return result == FLASH_RESULT_BLANK;
+}
+
+bool dataFlashWrite(uint32_t offset, const uint8_t* src, uint32_t len) {
+  if (!flashOpen || offset + len > DATA_FLASH_BYTES) return false;
+  return R_FLASH_LP_Write(&flashCtrl, (uint32_t)src, DATA_FLASH_BASE + offset, len) == FSP_SUCCESS;
+}
+
+bool dataFlashErase(uint32_t offset, uint32_t blocks) {
+  if (!flashOpen || offset % DATA_FLASH_BLOCK_BYTES != 0) return false;
+  if (offset + blocks * DATA_FLASH_BLOCK_BYTES > DATA_FLASH_BYTES) return false;
+  return R_FLASH_LP_Erase(&flashCtrl, DATA_FLASH_BASE + offset, blocks) == FSP_SUCCESS;
+}
@@ -0,0 +1,28 @@
+#pragma once
+// Access to the 8 KB data flash of the UNO R4's RA4M1.
+// Flash can only be programmed from erased (0xFF) to the value you want;
+// to change it again the whole 1 KB block has to be erased first.
+// Offsets are relative to the start of the data flash.
+// (The host benchmarks use an emulator with the same API, see lib/HostShim.)
+#include <Arduino.h>
+
+#define DATA_FLASH_BYTES       8192
+#define DATA_FLASH_BLOCK_BYTES 1024
+
+// Open the flash driver. Call once from setup(); false if it failed.
+bool dataFlashBegin();
+
+// Copy `len` bytes starting at `offset` into `dst`
+void dataFlashRead(uint32_t offset, uint8_t* dst, uint32_t len);
+
+// True if every byte in the range is still erased
+bool dataFlashIsBlank(uint32_t offset, uint32_t len);
+
+// Program `len` bytes at `offset`. The range must be blank.
+// Blocks until the flash is done (tens of us per byte).
+bool dataFlashWrite(uint32_t offset, const uint8_t* src, uint32_t len);
+
+// Erase the block(s) starting at `offset` (must be block aligned).
+// Blocks until done (several ms per block), so call it when nothing
+// time-critical is going on.
+bool dataFlashErase(uint32_t offset, uint32_t blocks);
@@ -0,0 +1,51 @@
+#pragma once
+// Host stand-in for Adafruit_NeoPixel.
+// Keeps the same byte layout (GRB, brightness applied on write) so pixel
+// buffers match what the real library would push down the wire.
+#include <Arduino.h>
+#include <vector>
+
+#define NEO_GRB    ((1 << 6) | (1 << 4) | (0 << 2) | (2))
+#define NEO_KHZ800 0x0000
+
+class Adafruit_NeoPixel {
+public:
+  Adafruit_NeoPixel(uint16_t n, int16_t pin, uint16_t type = NEO_GRB + NEO_KHZ800);
+  // Empty strip, sized and wired up later with the setters below
+  Adafruit_NeoPixel() : numLEDs(0), pin(-1) {}
+
+  void updateLength(uint16_t n) { numLEDs = n; pixels.assign(n * 3, 0); }
+  void updateType(uint16_t type) { (void)type; }
+  void setPin(int16_t p) { pin = p; }
+
+  void begin() {}
+  void show();
+  void clear();
+  void setBrightness(uint8_t b);
+  uint8_t getBrightness() const { return (uint8_t)(brightness - 1); }
+
+  void setPixelColor(uint16_t n, uint8_t r, uint8_t g, uint8_t b);
+  void setPixelColor(uint16_t n, uint32_t c);
+  uint32_t getPixelColor(uint16_t n) const;
+
+  uint8_t* getPixels() { return pixels.data(); }
+  uint16_t numPixels() const { return numLEDs; }
+  int16_t getPin() const { return pin; }
+  bool canShow() const { return true; }
+
+  void rainbow(uint16_t first_hue = 0, int8_t reps = 1, uint8_t saturation = 255,
+               uint8_t brightness = 255, bool gammify = true);
+
+  static uint32_t Color(uint8_t r, uint8_t g, uint8_t b) {
+    return ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+  }
+  static uint32_t ColorHSV(uint16_t hue, uint8_t sat = 255, uint8_t val = 255);
+  static uint8_t gamma8(uint8_t x);
+  static uint32_t gamma32(uint32_t x);
+
+private:
+  uint16_t numLEDs;
+  int16_t pin;
+  uint8_t brightness = 0;        // stored as value + 1, 0 = no scaling
+  std::vector<uint8_t> pixels;   // 3 bytes per LED, G R B
+};
@@ -0,0 +1,110 @@
+#pragma once
+// Host stand-in for the Arduino core.
+// Only the calls this project actually uses are provided. Time is virtual:
+// it only moves when the sketch waits (delay), pushes LEDs (show) or prints
+// to Serial. See HostShim.h for the knobs benchmarks use to drive pins,
+// the IR receiver and the cost model.
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define HIGH 1
+#define LOW  0
+
+#define INPUT        0
+#define OUTPUT       1
+#define INPUT_PULLUP 2
+
+#define LED_BUILTIN 13
+
+#define DEC 10
+#define HEX 16
+#define BIN 2
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+// --- TIME ---
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+// --- PINS ---
+void pinMode(uint8_t pin, uint8_t mode);
+int digitalRead(uint8_t pin);
+void digitalWrite(uint8_t pin, uint8_t val);
+
+// --- INTERRUPTS ---
+void noInterrupts();
+void interrupts();
+
+// --- MATH ---
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+
+template <class T, class L>
+auto min(const T& a, const L& b) -> decltype((b < a) ? b : a) { return (b < a) ? b : a; }
+template <class T, class L>
+auto max(const T& a, const L& b) -> decltype((b < a) ? b : a) { return (a < b) ? b : a; }
+template <class T, class L, class H>
+T constrain(const T& x, const L& lo, const H& hi) { return x < lo ? lo : (hi < x ? hi : x); }
+
+// --- SERIAL ---
+// Mirrors the Print API the sketches use. Output goes to stdout (unless
+// muted) and, when the cost model asks for it, each byte costs the time
+// the real UART would need at the configured baud rate.
+// Serial1 is the UART on pins 0 and 1, wired to other boards (link.h).
+// Its bytes always take their wire time and go to the boards joined with
+// hostLinkOutput() (HostShim.h); what it receives comes from
+// hostLinkInput().
+const uint8_t HOST_PORT_USB = 0;
+const uint8_t HOST_PORT_UART = 1;
+
+class HostSerial {
+public:
+  explicit HostSerial(uint8_t port = HOST_PORT_USB) : port(port) {}
+  void begin(unsigned long baud);
+  void end() {}
+  operator bool() const;
+
+  size_t write(uint8_t c);
+  size_t write(const uint8_t* buf, size_t len);
+  int available();
+  int read();
+  int peek();
+  int availableForWrite();
+  void flush();
+
+  size_t print(const char* s);
+  size_t print(char c);
+  size_t print(int n, int base = DEC)                { return printNumber((long long)n, base); }
+  size_t print(unsigned int n, int base = DEC)       { return printNumber((unsigned long long)n, base); }
+  size_t print(long n, int base = DEC)               { return printNumber((long long)n, base); }
+  size_t print(unsigned long n, int base = DEC)      { return printNumber((unsigned long long)n, base); }
+  size_t print(long long n, int base = DEC)          { return printNumber(n, base); }
+  size_t print(unsigned long long n, int base = DEC) { return printNumber(n, base); }
+  size_t print(double n, int digits = 2);
+
+  size_t println();
+  template <class T> size_t println(T v) { size_t n = print(v); return n + println(); }
+  template <class T> size_t println(T v, int fmt) { size_t n = print(v, fmt); return n + println(); }
+
+  unsigned long baud = 9600;
+
+private:
+  size_t printNumber(long long n, int base);
+  size_t printNumber(unsigned long long n, int base);
+  unsigned long queueByte(uint16_t bufferBytes);
+
+  uint8_t port;
+  unsigned long txIdleAt = 0; // when the UART finishes what it has queued
+};
+
+extern HostSerial Serial;
+extern HostSerial Serial1;
@@ -0,0 +1,12 @@
+#pragma once
+// Host stand-in for the UNO R4 WiFi's 12x8 LED matrix library.
+// Keeps the last frame instead of lighting anything; read it back with
+// hostMatrixPixel() from HostShim.h.
+#include <Arduino.h>
+
+class ArduinoLEDMatrix {
+public:
+  void begin() {}
+  // 96 bits, row by row from the top left, most significant bit first
+  void loadFrame(const uint32_t buffer[3]);
+};
@@ -0,0 +1,17 @@
+#pragma once
+// Host stand-in for lib/DataFlash: an 8 KB buffer that behaves like the
+// RA4M1 data flash. Programming can only clear bits (writes onto bytes that
+// are not erased are counted in hostFlashBadWrites), erases work on whole
+// 1 KB blocks, and both cost virtual time when the cost model says so.
+// The contents survive a simulated reset (running setup() again), just like
+// real flash does.
+#include <Arduino.h>
+
+#define DATA_FLASH_BYTES       8192
+#define DATA_FLASH_BLOCK_BYTES 1024
+
+bool dataFlashBegin();
+void dataFlashRead(uint32_t offset, uint8_t* dst, uint32_t len);
+bool dataFlashIsBlank(uint32_t offset, uint32_t len);
+bool dataFlashWrite(uint32_t offset, const uint8_t* src, uint32_t len);
+bool dataFlashErase(uint32_t offset, uint32_t blocks);
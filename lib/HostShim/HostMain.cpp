@@ -0,0 +1,12 @@
+// Host entry point: behaves like the Arduino core's main().
+// Kept in its own file (and weak) so host tools can bring their own main().
+#include "HostShim.h"
+
+void setup();
+void loop();
+
+__attribute__((weak)) int main() {
+  setup();
+  while (!hostStopRequested()) loop();
+  return 0;
+}
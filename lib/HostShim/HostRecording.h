@@ -0,0 +1,131 @@
+#pragma once
+// --- FRAME RECORDINGS (host only) ---
+// hostRecordStart() (HostShim.h) writes every show() of a simulated run to
+// a file; src/view_recording.cpp plays it back. Only the LEDs that changed
+// since the strip's previous show() are stored, so an hour of show stays a
+// few MB. Layout (all numbers little-endian):
+//
+//   "HREC" u8 version
+//   'S' u8 strip u8 pin u16 leds            a strip's first show()
+//   'F' u8 strip u32 sinceUs u32 showUs u16 spans
+//       spans x (u16 first u16 count, count x 3 bytes G R B)
+//                                           one show(): sinceUs after the
+//                                           previous show() started (the
+//                                           first: after the recording did),
+//                                           showUs on the wire
+//   'E' u64 atUs u8 len, len chars          an input or note from the
+//                                           driver, atUs after the start
+//
+// Pixel bytes are the strip buffer as it goes down the wire (brightness
+// applied), the same bytes getPixels() returns.
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+const char HOST_REC_MAGIC[4] = {'H', 'R', 'E', 'C'};
+const uint8_t HOST_REC_VERSION = 1;
+const uint8_t HOST_REC_STRIP = 'S';
+const uint8_t HOST_REC_FRAME = 'F';
+const uint8_t HOST_REC_EVENT = 'E';
+// Unchanged LEDs between two changed ones that still go in the same span:
+// a new span header costs 4 bytes, a little more than one LED
+const uint8_t HOST_REC_SPAN_GAP = 2;
+
+struct HostRecStrip {
+  uint8_t pin;
+  uint16_t leds;
+  std::vector<uint8_t> pixels; // G R B per LED
+};
+
+// Apply a frame's spans (as HostRecReader::spans holds them) to its strip
+inline bool hostRecApply(HostRecStrip& s, const uint8_t* spans, size_t len) {
+  size_t at = 0;
+  while (at + 4 <= len) {
+    uint16_t first = spans[at] | spans[at + 1] << 8, count = spans[at + 2] | spans[at + 3] << 8;
+    at += 4;
+    if ((size_t)(first + count) * 3 > s.pixels.size() || at + count * 3 > len) return false;
+    memcpy(&s.pixels[first * 3], &spans[at], count * 3);
+    at += count * 3;
+  }
+  return at == len;
+}
+
+// Reads a recording one record at a time. Frames are not applied to the
+// strips: keep or apply `spans` with hostRecApply().
+struct HostRecReader {
+  FILE* f = nullptr;
+  std::vector<HostRecStrip> strips; // pin and size; pixels start dark
+  // The last record read
+  uint64_t frameUs = 0;       // frame: when its show() started
+  uint8_t strip = 0;
+  uint32_t showUs = 0;        // frame: time on the wire
+  uint16_t changed = 0;       // frame: LEDs in its spans
+  std::vector<uint8_t> spans; // frame: span records as stored
+  uint64_t eventUs = 0;
+  std::string eventText;
+
+  ~HostRecReader() { if (f) fclose(f); }
+
+  bool open(const char* path) {
+    f = fopen(path, "rb");
+    char magic[4];
+    return f && fread(magic, 1, 4, f) == 4 && memcmp(magic, HOST_REC_MAGIC, 4) == 0 &&
+           fgetc(f) == HOST_REC_VERSION;
+  }
+
+  uint64_t get(int bytes) {
+    uint64_t v = 0;
+    for (int i = 0; i < bytes; i++) {
+      int c = fgetc(f);
+      if (c == EOF) throw 0;
+      v |= (uint64_t)c << (8 * i);
+    }
+    return v;
+  }
+
+  // The next record's tag (HOST_REC_*), 0 at the end, -1 if the file is
+  // damaged
+  int next() {
+    int tag = fgetc(f);
+    if (tag == EOF) return 0;
+    try {
+      if (tag == HOST_REC_STRIP) {
+        uint8_t id = get(1);
+        HostRecStrip s;
+        s.pin = get(1);
+        s.leds = get(2);
+        s.pixels.assign(s.leds * 3, 0);
+        if (id != strips.size()) return -1;
+        strips.push_back(s);
+      } else if (tag == HOST_REC_FRAME) {
+        strip = get(1);
+        frameUs += get(4);
+        showUs = get(4);
+        uint16_t count = get(2);
+        if (strip >= strips.size()) return -1;
+        spans.clear();
+        changed = 0;
+        for (uint16_t n = 0; n < count; n++) {
+          uint16_t first = get(2), leds = get(2);
+          size_t at = spans.size();
+          spans.resize(at + 4 + leds * 3);
+          spans[at] = first; spans[at + 1] = first >> 8;
+          spans[at + 2] = leds; spans[at + 3] = leds >> 8;
+          if (fread(&spans[at + 4], 3, leds, f) != leds) return -1;
+          changed += leds;
+        }
+      } else if (tag == HOST_REC_EVENT) {
+        eventUs = get(8);
+        eventText.assign(get(1), ' ');
+        if (!eventText.empty() && fread(&eventText[0], 1, eventText.size(), f) != eventText.size()) return -1;
+      } else {
+        return -1;
+      }
+    } catch (int) {
+      return -1;
+    }
+    return tag;
+  }
+};
@@ -0,0 +1,694 @@
+// Implementation of the host shim: virtual clock, pins, Serial, IR receiver
+// and the NeoPixel buffer. Everything here is deliberately simple; the
+// point is to run the real game headers, not to emulate the MCU.
+#include "HostShim.h"
+#include "Adafruit_NeoPixel.h"
+#include "IRremote.hpp"
+#include "DataFlash.h"
+#include "Arduino_LED_Matrix.h"
+#include "HostRecording.h"
+#include <stdio.h>
+#include <algorithm>
+#include <deque>
+
+HostCostModel hostCosts = {0, 0, false, 0, 0, 0, false};
+unsigned long hostShowCount = 0;
+unsigned long hostPixelWrites = 0;
+unsigned long hostIrLost = 0;
+unsigned long hostIrCorrupted = 0;
+unsigned long hostIrqOffUs = 0;
+unsigned long hostTicksLost = 0;
+
+static unsigned long nowUs = 0;
+static unsigned long lostUs = 0; // millis() ticks the board missed, in us
+static bool stopRequested = false;
+
+// Board link (below): tell the other boards how far our clock has got,
+// and carry link pin levels both ways
+static void linkTick();
+static void linkPinWritten(uint8_t pin, int level);
+static int linkPinRead(uint8_t pin);
+
+unsigned long hostNowUs() { return nowUs; }
+void hostAdvanceUs(unsigned long us) { nowUs += us; linkTick(); }
+void hostResetClock() { nowUs = 0; lostUs = 0; }
+void hostStop() { stopRequested = true; }
+bool hostStopRequested() { return stopRequested; }
+
+// --- TIME ---
+unsigned long millis() { return (nowUs - lostUs) / 1000; }
+unsigned long micros() { return nowUs - lostUs; }
+void delay(unsigned long ms) { nowUs += ms * 1000UL; linkTick(); }
+void delayMicroseconds(unsigned int us) { nowUs += us; linkTick(); }
+
+// --- PINS ---
+static int pinLevel[64] = {0};
+static HostPinFn pinFn = nullptr;
+
+void hostSetPinFn(HostPinFn fn) { pinFn = fn; }
+void hostSetPin(uint8_t pin, int level) { if (pin < 64) pinLevel[pin] = level; }
+
+void pinMode(uint8_t pin, uint8_t mode) { (void)pin; (void)mode; }
+void digitalWrite(uint8_t pin, uint8_t val) {
+  hostSetPin(pin, val);
+  linkPinWritten(pin, val);
+}
+int digitalRead(uint8_t pin) {
+  int linked = linkPinRead(pin);
+  if (linked >= 0) return linked;
+  if (pinFn) {
+    int level = pinFn(pin, nowUs);
+    if (level >= 0) return level;
+  }
+  return pin < 64 ? pinLevel[pin] : LOW;
+}
+
+void noInterrupts() {}
+void interrupts() {}
+
+void hostUseWs2812Timing() {
+  hostCosts.showUsPerLed = HOST_WS2812_US_PER_LED;
+  hostCosts.showLatchUs = HOST_WS2812_LATCH_US;
+  hostCosts.showMasksIrq = true;
+}
+
+// --- MATH ---
+// Small xorshift so runs are reproducible on every host libc.
+static uint32_t rngState = 1;
+void randomSeed(unsigned long seed) { rngState = seed ? (uint32_t)seed : 1; }
+long random(long howbig) {
+  if (howbig <= 0) return 0;
+  rngState ^= rngState << 13;
+  rngState ^= rngState >> 17;
+  rngState ^= rngState << 5;
+  return (long)(rngState % (uint32_t)howbig);
+}
+long random(long howsmall, long howbig) {
+  if (howsmall >= howbig) return howsmall;
+  return random(howbig - howsmall) + howsmall;
+}
+long map(long x, long in_min, long in_max, long out_min, long out_max) {
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+// --- SERIAL ---
+HostSerial Serial;
+HostSerial Serial1(HOST_PORT_UART);
+static bool serialEcho = true;
+static std::deque<uint8_t> serialRx;      // typed but not read yet
+static HostSerialFn serialFn = nullptr;
+static unsigned long serialConnectAtUs = 0;
+unsigned long hostSerialBlockedUs = 0;
+
+void hostSerialEcho(bool on) { serialEcho = on; }
+void hostSetSerialFn(HostSerialFn fn) { serialFn = fn; }
+void hostSerialConnectAt(unsigned long us) { serialConnectAtUs = us; }
+void hostSerialType(const char* text) {
+  while (*text) serialRx.push_back((uint8_t)*text++);
+}
+
+void HostSerial::begin(unsigned long b) { baud = b ? b : 9600; }
+HostSerial::operator bool() const { return port == HOST_PORT_UART || nowUs >= serialConnectAtUs; }
+
+// Put one byte in a transmit buffer of `bufferBytes` that drains at the
+// baud rate, waiting for room first. Returns when the byte is off the wire.
+unsigned long HostSerial::queueByte(uint16_t bufferBytes) {
+  // 10 bits per byte on the wire (start + 8 data + stop)
+  unsigned long usPerByte = 10000000UL / baud;
+  unsigned long bufferUs = (unsigned long)bufferBytes * usPerByte;
+  if (txIdleAt < nowUs) txIdleAt = nowUs;
+  if (txIdleAt > nowUs + bufferUs) nowUs = txIdleAt - bufferUs;
+  txIdleAt += usPerByte;
+  if (bufferBytes == 0) nowUs = txIdleAt;
+  return txIdleAt;
+}
+
+static void linkSendByte(uint8_t c, unsigned long arrivesUs);
+static int linkRxAvailable();
+static int linkRxRead(bool take);
+
+size_t HostSerial::write(uint8_t c) {
+  if (port == HOST_PORT_UART) {
+    linkSendByte(c, queueByte(HOST_UART_TX_BUFFER));
+    linkTick();
+    return 1;
+  }
+  if (nowUs < serialConnectAtUs) return 1; // nobody listening: the byte is gone
+  if (hostCosts.serialAtBaud) {
+    unsigned long before = nowUs;
+    queueByte(hostCosts.serialFifoBytes);
+    hostSerialBlockedUs += nowUs - before;
+  }
+  if (serialFn) serialFn(c);
+  if (serialEcho) fputc(c, stdout);
+  return 1;
+}
+size_t HostSerial::write(const uint8_t* buf, size_t len) {
+  for (size_t i = 0; i < len; i++) write(buf[i]);
+  return len;
+}
+int HostSerial::available() {
+  if (port == HOST_PORT_UART) return linkRxAvailable();
+  return (int)serialRx.size();
+}
+int HostSerial::read() {
+  if (port == HOST_PORT_UART) return linkRxRead(true);
+  if (serialRx.empty()) return -1;
+  int c = serialRx.front();
+  serialRx.pop_front();
+  return c;
+}
+int HostSerial::peek() {
+  if (port == HOST_PORT_UART) return linkRxRead(false);
+  return serialRx.empty() ? -1 : serialRx.front();
+}
+int HostSerial::availableForWrite() {
+  uint16_t bufferBytes = port == HOST_PORT_UART ? HOST_UART_TX_BUFFER : hostCosts.serialFifoBytes;
+  if (port == HOST_PORT_USB && !hostCosts.serialAtBaud) return 256; // free output: always room
+  unsigned long usPerByte = 10000000UL / baud;
+  long queued = txIdleAt > nowUs ? (long)((txIdleAt - nowUs + usPerByte - 1) / usPerByte) : 0;
+  long room = (long)bufferBytes - queued;
+  return room > 0 ? (int)room : 0;
+}
+void HostSerial::flush() {
+  if (txIdleAt > nowUs) nowUs = txIdleAt;
+  if (port == HOST_PORT_UART) linkTick();
+  else if (serialEcho) fflush(stdout);
+}
+
+size_t HostSerial::print(const char* s) {
+  size_t n = 0;
+  while (*s) n += write((uint8_t)*s++);
+  return n;
+}
+size_t HostSerial::print(char c) { return write((uint8_t)c); }
+size_t HostSerial::print(double n, int digits) {
+  char buf[48];
+  snprintf(buf, sizeof(buf), "%.*f", digits, n);
+  return print(buf);
+}
+size_t HostSerial::println() { return print("\r\n"); }
+
+size_t HostSerial::printNumber(long long n, int base) {
+  if (n < 0 && base == DEC) return print('-') + printNumber((unsigned long long)(-n), base);
+  return printNumber((unsigned long long)n, base);
+}
+size_t HostSerial::printNumber(unsigned long long n, int base) {
+  char buf[66];
+  char* p = &buf[sizeof(buf) - 1];
+  *p = '\0';
+  if (base < 2) base = 10;
+  do {
+    int d = (int)(n % base);
+    *--p = (char)(d < 10 ? '0' + d : 'A' + d - 10);
+    n /= base;
+  } while (n);
+  return print(p);
+}
+
+// --- BOARD LINK ---
+// One record per Serial1 byte or link pin change, plus clock-only records
+// so a receiver knows nothing earlier is still on its way. Both ends are
+// processes on the same machine, so records go down the pipe as they are.
+struct HostLinkRecord {
+  uint8_t kind;       // 'B' Serial1 byte, 'P' pin level, 'T' clock only
+  uint8_t pin;
+  uint8_t value;
+  uint64_t atUs;      // when the byte has arrived / the pin changes
+  uint64_t senderUs;  // the sender's clock: nothing still to come is earlier
+};
+// How far a sender's clock moves before it tells its receivers
+static const unsigned long HOST_LINK_TICK_US = 1000;
+
+struct HostLinkByte { unsigned long atUs; uint8_t c; };
+struct HostLinkLevel { unsigned long atUs; uint8_t pin; uint8_t level; };
+static std::vector<FILE*> linkOuts;
+static FILE* linkIn = nullptr;
+static bool linkInEnded = false;
+static unsigned long linkPeerUs = 0;     // every record up to here has been read
+static unsigned long linkLastTickUs = 0;
+static std::deque<HostLinkByte> linkRx;  // Serial1 bytes, arrived or on the way
+static size_t linkRxReady = 0;           // how many of them have arrived
+static std::deque<HostLinkLevel> linkLevels;
+static bool linkPins[64];
+static int linkLevel[64];
+unsigned long hostLinkRxLost = 0;
+
+void hostLinkOutput(int fd) {
+  FILE* f = fdopen(fd, "wb");
+  if (f) linkOuts.push_back(f);
+}
+void hostLinkInput(int fd) {
+  linkIn = fdopen(fd, "rb");
+  linkInEnded = !linkIn;
+}
+void hostLinkPin(uint8_t pin) { if (pin < 64) linkPins[pin] = true; }
+void hostLinkClose() {
+  for (FILE* f : linkOuts) fclose(f);
+  linkOuts.clear();
+}
+bool hostLinkEnded() { return !linkIn || (linkInEnded && nowUs > linkPeerUs); }
+
+static void linkSend(uint8_t kind, uint8_t pin, uint8_t value, unsigned long atUs) {
+  HostLinkRecord r = {kind, pin, value, atUs, nowUs};
+  for (FILE* f : linkOuts) fwrite(&r, sizeof(r), 1, f);
+}
+
+static void linkTick() {
+  if (linkOuts.empty() || nowUs - linkLastTickUs < HOST_LINK_TICK_US) return;
+  linkSend('T', 0, 0, nowUs);
+  for (FILE* f : linkOuts) fflush(f);
+  linkLastTickUs = nowUs;
+}
+
+static void linkSendByte(uint8_t c, unsigned long arrivesUs) {
+  if (!linkOuts.empty()) linkSend('B', 0, c, arrivesUs);
+}
+
+static void linkPinWritten(uint8_t pin, int level) {
+  if (pin < 64 && linkPins[pin] && !linkOuts.empty()) linkSend('P', pin, (uint8_t)level, nowUs);
+}
+
+// Read records until the sender's clock is past `us`: then everything
+// that happens up to `us` is known. Blocks while the sender catches up.
+static void linkPump(unsigned long us) {
+  while (linkIn && !linkInEnded && linkPeerUs <= us) {
+    HostLinkRecord r;
+    if (fread(&r, sizeof(r), 1, linkIn) != 1) {
+      linkInEnded = true;
+      break;
+    }
+    if (r.kind == 'B') linkRx.push_back({(unsigned long)r.atUs, r.value});
+    if (r.kind == 'P') linkLevels.push_back({(unsigned long)r.atUs, r.pin, r.value});
+    linkPeerUs = r.senderUs;
+  }
+}
+
+static int linkPinRead(uint8_t pin) {
+  if (pin >= 64 || !linkPins[pin] || !linkIn) return -1;
+  linkPump(nowUs);
+  while (!linkLevels.empty() && linkLevels.front().atUs <= nowUs) {
+    linkLevel[linkLevels.front().pin] = linkLevels.front().level;
+    linkLevels.pop_front();
+  }
+  return linkLevel[pin];
+}
+
+static int linkRxAvailable() {
+  if (!linkIn) return 0;
+  linkPump(nowUs);
+  while (linkRxReady < linkRx.size() && linkRx[linkRxReady].atUs <= nowUs) linkRxReady++;
+  return (int)linkRxReady;
+}
+
+static int linkRxRead(bool take) {
+  if (linkRxAvailable() == 0) return -1;
+  int c = linkRx.front().c;
+  if (take) {
+    linkRx.pop_front();
+    linkRxReady--;
+  }
+  return c;
+}
+
+// Interrupts off from startUs to endUs: Serial1 bytes arriving meanwhile
+// wait in the UART's FIFO, and once that is full the rest are lost
+static void linkRxMasked(unsigned long startUs, unsigned long endUs) {
+  if (!linkIn) return;
+  linkPump(endUs);
+  uint8_t held = 0;
+  for (auto it = linkRx.begin(); it != linkRx.end();) {
+    if (it->atUs <= startUs) { ++it; continue; } // the interrupt already took it
+    if (it->atUs > endUs) break;
+    if (held < HOST_UART_RX_FIFO) { held++; ++it; continue; }
+    it = linkRx.erase(it);
+    hostLinkRxLost++;
+  }
+}
+
+// --- IR RECEIVER ---
+// NEC frames: a full code takes ~67.5 ms on air, a repeat ~11.8 ms.
+static const unsigned long IR_FRAME_US  = 67500;
+static const unsigned long IR_REPEAT_US = 11800;
+// The receiver times marks and spaces by counting 50 us timer interrupts,
+// so time with interrupts off goes missing from whatever it was timing.
+// Every frame opens with a 9 ms leader mark, which survives losing up to
+// 40% (the decoder tolerance, remote.h); anywhere else a 200 us gap
+// stretches a bit past recognition.
+static const unsigned long IR_LEADER_US = 9000;
+static const unsigned long IR_LEADER_SLACK_US = IR_LEADER_US * 40 / 100;
+static const unsigned long IR_BIT_SLACK_US = 200;
+
+struct HostIrFrame {
+  unsigned long startUs;
+  unsigned long endUs;
+  uint32_t raw;
+  bool repeat;
+  unsigned long leaderOffUs; // leader mark time with interrupts off
+  unsigned long bitsOffUs;   // the same for the rest of the frame
+};
+static std::deque<HostIrFrame> irQueue;
+static bool irArmed = true;              // false between decode() and resume()
+static unsigned long irArmedSinceUs = 0;
+
+IRrecv IrReceiver;
+
+void hostIrSendAt(unsigned long startUs, uint32_t rawCode, bool repeat) {
+  HostIrFrame f = {startUs, startUs + (repeat ? IR_REPEAT_US : IR_FRAME_US), rawCode, repeat, 0, 0};
+  auto it = irQueue.begin();
+  while (it != irQueue.end() && it->startUs <= startUs) ++it;
+  irQueue.insert(it, f);
+}
+void hostIrSend(uint32_t rawCode, bool repeat) { hostIrSendAt(nowUs, rawCode, repeat); }
+
+void IRrecv::begin(uint8_t pin, bool ledFeedback) {
+  (void)pin; (void)ledFeedback;
+  irArmed = true;
+  irArmedSinceUs = nowUs;
+}
+
+bool IRrecv::decode() {
+  if (!irArmed) return false;
+  // Frames that started while the receiver was not listening are gone
+  while (!irQueue.empty() && irQueue.front().startUs < irArmedSinceUs) {
+    irQueue.pop_front();
+    hostIrLost++;
+  }
+  if (irQueue.empty() || irQueue.front().endUs > nowUs) return false;
+  HostIrFrame f = irQueue.front();
+  irQueue.pop_front();
+  decodedIRData.decodedRawData = f.repeat ? 0 : f.raw;
+  decodedIRData.flags = f.repeat ? IRDATA_FLAGS_IS_REPEAT : 0;
+  if (f.leaderOffUs > IR_LEADER_SLACK_US || f.bitsOffUs > IR_BIT_SLACK_US) {
+    // No protocol matches the mangled timings: IRremote hands back a hash
+    // of them as the code, which no button has
+    decodedIRData.decodedRawData = ((f.raw ^ f.startUs) * 2654435761UL) | 1;
+    decodedIRData.flags = 0;
+    hostIrCorrupted++;
+  }
+  irArmed = false;
+  return true;
+}
+
+void IRrecv::resume() {
+  irArmed = true;
+  irArmedSinceUs = nowUs;
+}
+
+// Interrupts were off from startUs to endUs (a show()): charge the frames on
+// air and the millis() tick
+static void irqOff(unsigned long startUs, unsigned long endUs) {
+  hostIrqOffUs += endUs - startUs;
+  for (HostIrFrame& f : irQueue) {
+    if (f.startUs >= endUs) break;
+    unsigned long leaderEnd = f.startUs + IR_LEADER_US;
+    if (startUs < leaderEnd) f.leaderOffUs += std::min(endUs, leaderEnd) - std::max(startUs, f.startUs);
+    if (endUs > leaderEnd && startUs < f.endUs) f.bitsOffUs += std::min(endUs, f.endUs) - std::max(startUs, leaderEnd);
+  }
+  linkRxMasked(startUs, endUs);
+  // Ticks due in the window: the first still fires late, the rest are lost
+  unsigned long ticks = endUs / 1000 - startUs / 1000;
+  if (ticks > 1) {
+    hostTicksLost += ticks - 1;
+    lostUs += (ticks - 1) * 1000;
+  }
+}
+
+bool IRrecv::isIdle() {
+  if (!irArmed) return true;
+  for (const HostIrFrame& f : irQueue) {
+    if (f.startUs > nowUs) break;
+    if (f.startUs >= irArmedSinceUs && f.endUs > nowUs) return false;
+  }
+  return true;
+}
+
+// --- LED MATRIX ---
+static uint32_t matrixFrame[3];
+unsigned long hostMatrixLoads = 0;
+
+void ArduinoLEDMatrix::loadFrame(const uint32_t buffer[3]) {
+  memcpy(matrixFrame, buffer, sizeof(matrixFrame));
+  hostMatrixLoads++;
+}
+
+bool hostMatrixPixel(uint8_t row, uint8_t col) {
+  uint8_t i = row * 12 + col;
+  return (matrixFrame[i / 32] >> (31 - i % 32)) & 1;
+}
+
+// --- DATA FLASH ---
+static uint8_t flashMem[DATA_FLASH_BYTES];
+static bool flashWiped = false;
+static unsigned long flashEraseCount[DATA_FLASH_BYTES / DATA_FLASH_BLOCK_BYTES];
+static long flashPowerBytes = -1; // bytes left before the power "fails"
+unsigned long hostFlashBadWrites = 0;
+unsigned long hostFlashBusyUs = 0;
+
+void hostFlashWipe() {
+  memset(flashMem, 0xFF, sizeof(flashMem));
+  memset(flashEraseCount, 0, sizeof(flashEraseCount));
+  hostFlashBadWrites = 0;
+  flashWiped = true;
+}
+void hostFlashPowerFailAfter(long bytes) { flashPowerBytes = bytes; }
+unsigned long hostFlashErases(uint32_t block) {
+  return block < DATA_FLASH_BYTES / DATA_FLASH_BLOCK_BYTES ? flashEraseCount[block] : 0;
+}
+
+static void flashCharge(unsigned long us) {
+  nowUs += us;
+  hostFlashBusyUs += us;
+}
+
+bool dataFlashBegin() {
+  if (!flashWiped) hostFlashWipe();
+  return true;
+}
+
+void dataFlashRead(uint32_t offset, uint8_t* dst, uint32_t len) {
+  if (offset + len > DATA_FLASH_BYTES) return;
+  memcpy(dst, &flashMem[offset], len);
+}
+
+bool dataFlashIsBlank(uint32_t offset, uint32_t len) {
+  if (offset + len > DATA_FLASH_BYTES) return false;
+  for (uint32_t i = 0; i < len; i++) if (flashMem[offset + i] != 0xFF) return false;
+  return true;
+}
+
+bool dataFlashWrite(uint32_t offset, const uint8_t* src, uint32_t len) {
+  if (offset + len > DATA_FLASH_BYTES) return false;
+  for (uint32_t i = 0; i < len; i++) {
+    if (flashPowerBytes == 0) break;
+    if (flashPowerBytes > 0) flashPowerBytes--;
+    if (flashMem[offset + i] != 0xFF) hostFlashBadWrites++;
+    flashMem[offset + i] &= src[i]; // programming only clears bits
+  }
+  flashCharge(len * hostCosts.flashWriteUsPerByte);
+  return true;
+}
+
+bool dataFlashErase(uint32_t offset, uint32_t blocks) {
+  if (offset % DATA_FLASH_BLOCK_BYTES != 0) return false;
+  if (offset + blocks * DATA_FLASH_BLOCK_BYTES > DATA_FLASH_BYTES) return false;
+  if (flashPowerBytes == 0) return true;
+  memset(&flashMem[offset], 0xFF, blocks * DATA_FLASH_BLOCK_BYTES);
+  for (uint32_t b = 0; b < blocks; b++) flashEraseCount[offset / DATA_FLASH_BLOCK_BYTES + b]++;
+  flashCharge(blocks * hostCosts.flashEraseUsPerBlock);
+  return true;
+}
+
+// --- NEOPIXEL ---
+Adafruit_NeoPixel::Adafruit_NeoPixel(uint16_t n, int16_t p, uint16_t type)
+  : numLEDs(n), pin(p), pixels(n * 3, 0) {
+  (void)type;
+}
+
+static HostShowFn showFn = nullptr;
+void hostSetShowFn(HostShowFn fn) { showFn = fn; }
+
+static void recordShow(Adafruit_NeoPixel& strip, unsigned long startUs, unsigned long endUs);
+
+void Adafruit_NeoPixel::show() {
+  hostShowCount++;
+  unsigned long startUs = nowUs;
+  unsigned long wireUs = (unsigned long)numLEDs * hostCosts.showUsPerLed;
+  if (hostCosts.showMasksIrq) irqOff(startUs, startUs + wireUs);
+  nowUs += wireUs + hostCosts.showLatchUs;
+  recordShow(*this, startUs, nowUs);
+  if (showFn) showFn(*this, startUs, nowUs);
+}
+
+void Adafruit_NeoPixel::clear() { memset(pixels.data(), 0, pixels.size()); }
+
+void Adafruit_NeoPixel::setBrightness(uint8_t b) {
+  // Same approach as the real library: rescale what is already in the buffer
+  uint8_t newBrightness = b + 1;
+  if (newBrightness == brightness) return;
+  uint8_t oldBrightness = brightness - 1;
+  uint16_t scale;
+  if (oldBrightness == 0) scale = 0;
+  else if (b == 255) scale = 65535 / oldBrightness;
+  else scale = (((uint16_t)newBrightness << 8) - 1) / oldBrightness;
+  for (uint8_t& c : pixels) c = (uint8_t)((c * scale) >> 8);
+  brightness = newBrightness;
+}
+
+void Adafruit_NeoPixel::setPixelColor(uint16_t n, uint8_t r, uint8_t g, uint8_t b) {
+  if (n >= numLEDs) return;
+  hostPixelWrites++;
+  if (brightness) {
+    r = (r * brightness) >> 8;
+    g = (g * brightness) >> 8;
+    b = (b * brightness) >> 8;
+  }
+  uint8_t* p = &pixels[n * 3];
+  p[0] = g;
+  p[1] = r;
+  p[2] = b;
+}
+
+void Adafruit_NeoPixel::setPixelColor(uint16_t n, uint32_t c) {
+  setPixelColor(n, (uint8_t)(c >> 16), (uint8_t)(c >> 8), (uint8_t)c);
+}
+
+uint32_t Adafruit_NeoPixel::getPixelColor(uint16_t n) const {
+  if (n >= numLEDs) return 0;
+  const uint8_t* p = &pixels[n * 3];
+  uint32_t g = p[0], r = p[1], b = p[2];
+  if (brightness) {
+    r = (r << 8) / brightness;
+    g = (g << 8) / brightness;
+    b = (b << 8) / brightness;
+  }
+  return (r << 16) | (g << 8) | b;
+}
+
+uint32_t Adafruit_NeoPixel::ColorHSV(uint16_t hue, uint8_t sat, uint8_t val) {
+  uint8_t r, g, b;
+  hue = (hue * 1530L + 32768) / 65536;
+  if (hue < 510) {
+    b = 0;
+    if (hue < 255) { r = 255; g = hue; } else { r = 510 - hue; g = 255; }
+  } else if (hue < 1020) {
+    r = 0;
+    if (hue < 765) { g = 255; b = hue - 510; } else { g = 1020 - hue; b = 255; }
+  } else if (hue < 1530) {
+    g = 0;
+    if (hue < 1275) { r = hue - 1020; b = 255; } else { r = 255; b = 1530 - hue; }
+  } else {
+    r = 255; g = b = 0;
+  }
+  uint32_t v1 = 1 + val;
+  uint16_t s1 = 1 + sat;
+  uint8_t s2 = 255 - sat;
+  return ((((((r * s1) >> 8) + s2) * v1) & 0xff00) << 8) |
+         (((((g * s1) >> 8) + s2) * v1) & 0xff00) |
+         (((((b * s1) >> 8) + s2) * v1) >> 8);
+}
+
+uint8_t Adafruit_NeoPixel::gamma8(uint8_t x) {
+  static uint8_t table[256];
+  static bool built = false;
+  if (!built) {
+    for (int i = 0; i < 256; i++) table[i] = (uint8_t)(pow(i / 255.0, 2.6) * 255.0 + 0.5);
+    built = true;
+  }
+  return table[x];
+}
+
+uint32_t Adafruit_NeoPixel::gamma32(uint32_t x) {
+  uint8_t* y = (uint8_t*)&x;
+  for (uint8_t i = 0; i < 4; i++) y[i] = gamma8(y[i]);
+  return x;
+}
+
+void Adafruit_NeoPixel::rainbow(uint16_t first_hue, int8_t reps, uint8_t saturation,
+                                uint8_t bright, bool gammify) {
+  for (uint16_t i = 0; i < numLEDs; i++) {
+    uint16_t hue = first_hue + (i * reps * 65536) / numLEDs;
+    uint32_t color = ColorHSV(hue, saturation, bright);
+    if (gammify) color = gamma32(color);
+    setPixelColor(i, color);
+  }
+}
+
+// --- FRAME RECORDER ---
+// Keeps a copy of what each strip showed last, so only the changes are written
+struct RecordedStrip {
+  const Adafruit_NeoPixel* strip;
+  std::vector<uint8_t> shown;
+};
+static FILE* recFile = nullptr;
+static unsigned long recStartUs = 0, recLastShowUs = 0;
+static std::vector<RecordedStrip> recStrips;
+
+static void recPut(uint64_t v, int bytes) {
+  for (int i = 0; i < bytes; i++) fputc((int)(v >> (8 * i)) & 0xFF, recFile);
+}
+
+bool hostRecordStart(const char* path) {
+  hostRecordStop();
+  recFile = fopen(path, "wb");
+  if (!recFile) return false;
+  fwrite(HOST_REC_MAGIC, 1, 4, recFile);
+  fputc(HOST_REC_VERSION, recFile);
+  recStartUs = recLastShowUs = nowUs;
+  recStrips.clear();
+  return true;
+}
+
+void hostRecordStop() {
+  if (recFile) fclose(recFile);
+  recFile = nullptr;
+}
+
+void hostRecordEvent(unsigned long atUs, const char* text) {
+  if (!recFile) return;
+  size_t len = strlen(text) > 255 ? 255 : strlen(text);
+  fputc(HOST_REC_EVENT, recFile);
+  recPut(atUs > recStartUs ? atUs - recStartUs : 0, 8);
+  fputc((int)len, recFile);
+  fwrite(text, 1, len, recFile);
+}
+
+static void recordShow(Adafruit_NeoPixel& strip, unsigned long startUs, unsigned long endUs) {
+  if (!recFile) return;
+  size_t id = 0;
+  while (id < recStrips.size() && recStrips[id].strip != &strip) id++;
+  if (id == recStrips.size()) {
+    recStrips.push_back({&strip, std::vector<uint8_t>(strip.numPixels() * 3, 0)});
+    fputc(HOST_REC_STRIP, recFile);
+    recPut(id, 1);
+    recPut((uint8_t)strip.getPin(), 1);
+    recPut(strip.numPixels(), 2);
+  }
+
+  // Changed LEDs, merged into spans across short unchanged gaps
+  std::vector<uint8_t>& shown = recStrips[id].shown;
+  const uint8_t* px = strip.getPixels();
+  uint16_t n = strip.numPixels();
+  std::vector<std::pair<uint16_t, uint16_t>> spans; // first, count
+  for (uint16_t i = 0; i < n; i++) {
+    if (memcmp(&px[i * 3], &shown[i * 3], 3) == 0) continue;
+    if (!spans.empty() && i - (spans.back().first + spans.back().second) <= HOST_REC_SPAN_GAP) {
+      spans.back().second = i + 1 - spans.back().first;
+    } else {
+      spans.push_back({i, 1});
+    }
+  }
+
+  fputc(HOST_REC_FRAME, recFile);
+  recPut(id, 1);
+  recPut(startUs - recLastShowUs, 4);
+  recPut(endUs - startUs, 4);
+  recPut(spans.size(), 2);
+  for (const auto& sp : spans) {
+    recPut(sp.first, 2);
+    recPut(sp.second, 2);
+    fwrite(&px[sp.first * 3], 3, sp.second, recFile);
+  }
+  memcpy(shown.data(), px, shown.size());
+  recLastShowUs = startUs;
+}
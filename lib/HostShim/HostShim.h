@@ -0,0 +1,130 @@
+#pragma once
+// Controls for the host simulation.
+// Benchmarks include this next to the normal game headers to move the
+// virtual clock, feed beam pins and IR frames, and choose how expensive
+// show() and Serial are allowed to be.
+#include <Arduino.h>
+
+// --- VIRTUAL CLOCK ---
+// hostNowUs() is real time. millis()/micros() are the board's own clock,
+// which falls behind it when show() keeps interrupts off long enough to
+// swallow timer ticks (see showMasksIrq below).
+unsigned long hostNowUs();
+void hostAdvanceUs(unsigned long us);
+void hostResetClock();
+
+// --- PINS ---
+// Optional callback that decides what digitalRead() returns for a pin at
+// a given moment. Lets a benchmark describe a whole pulse train up front
+// instead of poking pins from inside the loop. Return -1 to fall back to
+// the level set with hostSetPin().
+typedef int (*HostPinFn)(uint8_t pin, unsigned long nowUs);
+void hostSetPinFn(HostPinFn fn);
+void hostSetPin(uint8_t pin, int level);
+
+// --- COST MODEL ---
+// Everything is free by default. Benchmarks fill these in to charge the
+// virtual clock for the work real hardware has to do.
+struct HostCostModel {
+  unsigned long showUsPerLed;   // wire time per LED pushed by show()
+  unsigned long showLatchUs;    // reset/latch gap added after each show()
+  bool serialAtBaud;            // charge each Serial byte at the begin() baud
+  uint16_t serialFifoBytes;     // bytes the UART can queue before print() blocks
+  unsigned long flashWriteUsPerByte;  // data flash programming time per byte
+  unsigned long flashEraseUsPerBlock; // data flash erase time per 1 KB block
+  bool showMasksIrq;            // show() sends with interrupts off, like the board
+};
+extern HostCostModel hostCosts;
+
+// WS2812 at 800 kHz: 24 bits of 1.25 us per LED, then at least 280 us low
+// to latch. The NeoPixel library sends with interrupts off, and while they
+// are off:
+//   - the 1 ms millis() tick is held; when they come back one pending tick
+//     fires and the rest are gone, so a 10 ms show() costs millis() 9 ms
+//   - the IR receiver stops sampling, and a frame on air at the time
+//     decodes as garbage (an unknown code, see hostIrCorrupted)
+//   - beam pins are only polled with digitalRead(), so a ball isn't lost,
+//     just seen once show() returns
+// hostUseWs2812Timing() turns all of that on.
+const unsigned long HOST_WS2812_US_PER_LED = 30;
+const unsigned long HOST_WS2812_LATCH_US = 280;
+void hostUseWs2812Timing();
+extern unsigned long hostIrqOffUs;  // time show() has kept interrupts off
+extern unsigned long hostTicksLost; // millis() ticks lost to it
+
+// --- SERIAL ---
+void hostSerialEcho(bool on);   // false = keep stdout quiet, costs still apply
+void hostSerialType(const char* text); // bytes the Serial Monitor sends to the board
+// The Serial Monitor opens at this time (default 0: always open). Until
+// then `Serial` is false and everything printed is lost.
+void hostSerialConnectAt(unsigned long us);
+// Called with every byte the board sends, e.g. to decode telemetry
+typedef void (*HostSerialFn)(uint8_t c);
+void hostSetSerialFn(HostSerialFn fn);
+extern unsigned long hostSerialBlockedUs; // time write() waited for the UART
+
+// --- BOARD LINK ---
+// Several simulated boards, one process each, wired together through pipes
+// (src/test_link.cpp forks them). A board's Serial1 output and the levels
+// it writes to its link pins go to every hostLinkOutput(); Serial1 input
+// and link pin levels come from hostLinkInput(). Each record carries the
+// sender's clock, and a receiving board waits for its sender to catch up
+// before it reads anything, so every board sees its inputs at the right
+// virtual time even though the processes run at their own pace.
+// Closing the outputs (or the sender exiting) ends the link.
+const uint16_t HOST_UART_TX_BUFFER = 512; // Serial1 bytes queued before write() blocks
+const uint8_t HOST_UART_RX_FIFO = 16;     // bytes the UART holds while interrupts are off
+void hostLinkOutput(int fd);
+void hostLinkInput(int fd);
+void hostLinkPin(uint8_t pin);      // this pin's level travels over the link
+void hostLinkClose();               // flush and close every output
+bool hostLinkEnded();               // the input is closed and everything on it is past
+extern unsigned long hostLinkRxLost; // Serial1 bytes lost while show() had interrupts off
+
+// --- IR RECEIVER ---
+// Queue a remote frame that starts arriving at `startUs`. It decodes once
+// the whole frame has been received; frames that arrive while the receiver
+// is waiting for resume() are lost, just like on the board.
+void hostIrSendAt(unsigned long startUs, uint32_t rawCode, bool repeat = false);
+void hostIrSend(uint32_t rawCode, bool repeat = false);
+extern unsigned long hostIrLost;
+extern unsigned long hostIrCorrupted; // frames garbled by show() (showMasksIrq)
+
+// --- LED MATRIX ---
+// The last frame loaded into the on-board 12x8 matrix (row 0 at the top)
+bool hostMatrixPixel(uint8_t row, uint8_t col);
+extern unsigned long hostMatrixLoads;     // loadFrame() calls
+
+// --- DATA FLASH ---
+// Lose power after `bytes` more bytes have been programmed: the rest of
+// that write and everything after it is silently dropped, erases included.
+// Pass -1 to restore power. Used to test torn journal records.
+void hostFlashPowerFailAfter(long bytes);
+void hostFlashWipe();                              // back to a factory-blank chip
+extern unsigned long hostFlashBadWrites;           // programs onto non-erased bytes
+extern unsigned long hostFlashBusyUs;              // total time spent writing/erasing
+unsigned long hostFlashErases(uint32_t block);     // erase count of one 1 KB block
+
+// --- STATS ---
+extern unsigned long hostShowCount;
+extern unsigned long hostPixelWrites;   // setPixelColor() calls
+
+// Called after every show() with the frame that was pushed and when the
+// wire transfer started and finished.
+class Adafruit_NeoPixel;
+typedef void (*HostShowFn)(Adafruit_NeoPixel& strip, unsigned long startUs, unsigned long endUs);
+void hostSetShowFn(HostShowFn fn);
+
+// --- FRAME RECORDER ---
+// Write every show() from now on to `path` (format in HostRecording.h,
+// played back by src/view_recording.cpp). Returns false if the file can't
+// be created. Events are inputs or notes to show alongside the frames, at
+// any time after the start (a remote key queued for later, say).
+bool hostRecordStart(const char* path);
+void hostRecordEvent(unsigned long atUs, const char* text);
+void hostRecordStop();
+
+// --- RUN CONTROL ---
+// The host main() runs setup() and then loop() until this is requested.
+void hostStop();
+bool hostStopRequested();
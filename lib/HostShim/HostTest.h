@@ -0,0 +1,64 @@
+#pragma once
+#include <HostShim.h>
+#include "config.h"
+#include "remote_codes.h"
+
+// --- HOST TEST HELPERS ---
+// What every host test of the real game (src/test_*.cpp, built together
+// with src/main.cpp) shares: PASS/FAIL lines and the closing banner,
+// running the game for a while, pressing remote keys (CODE_* from
+// remote_codes.h, the same ones remote.h listens for) and dropping balls
+// through the beams.
+//
+//   press(CODE_1);
+//   ball(0);
+//   check(modeState.r1.rows[0] == 1, "one row");
+//   return hostTestFinish("JOURNAL TEST");
+
+// --- From the game (src/main.cpp) ---
+void setup();
+void loop();
+
+// How long press() lets the game run after a key
+inline unsigned long hostTestKeyMs = 300;
+
+inline int failures = 0;
+
+inline void check(bool ok, const char* what) {
+  printf("  %s  %s\n", ok ? "PASS" : "FAIL", what);
+  if (!ok) failures++;
+}
+
+// Called after every loop() runMs() runs, for a test that watches the
+// game loop by loop
+inline void (*hostTestEachLoop)() = nullptr;
+
+inline void runMs(unsigned long ms) {
+  unsigned long end = millis() + ms;
+  while (millis() < end) {
+    loop();
+    if (hostTestEachLoop) hostTestEachLoop();
+  }
+}
+
+inline void press(uint32_t code, unsigned long ms = hostTestKeyMs) {
+  hostIrSend(code);
+  runMs(ms);
+}
+
+// Break beam q once (long enough for any loop to notice). Returns when it
+// happened (ms).
+inline unsigned long ball(uint8_t q) {
+  unsigned long at = millis();
+  hostSetPin(BEAM_PINS[q], HIGH);
+  runMs(60);
+  hostSetPin(BEAM_PINS[q], LOW);
+  runMs(60);
+  return at;
+}
+
+// The closing banner. Returns the exit code for main().
+inline int hostTestFinish(const char* name) {
+  printf("\n--- %s %s --- (%d failed)\n", name, failures ? "FAILED" : "PASSED", failures);
+  return failures ? 1 : 0;
+}
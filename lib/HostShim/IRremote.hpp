@@ -0,0 +1,24 @@
+#pragma once
+// Host stand-in for the IRremote receiver API used by remote.h.
+// Frames are queued with hostIrSend()/hostIrSendAt() from HostShim.h.
+#include <Arduino.h>
+
+#define ENABLE_LED_FEEDBACK true
+#define DISABLE_LED_FEEDBACK false
+#define IRDATA_FLAGS_IS_REPEAT 0x01
+
+struct IRData {
+  uint32_t decodedRawData = 0;
+  uint8_t flags = 0;
+};
+
+class IRrecv {
+public:
+  void begin(uint8_t pin, bool ledFeedback = false);
+  bool decode();
+  void resume();
+  bool isIdle();
+  IRData decodedIRData;
+};
+
+extern IRrecv IrReceiver;
@@ -0,0 +1,176 @@
+# --- RAM BUDGET REPORT ---
+# Runs after every board build (extra_scripts in platformio.ini) and prints
+# where the static RAM goes:
+#   - per object / library, from the linker map file
+#   - per game header (leds.h, round3.h, ...), from the symbols' debug line
+#     info, because the whole game is one translation unit (main.cpp)
+# The build fails if less than `custom_ram_headroom` bytes of RAM are left
+# after static data and the linker's heap/stack reservations.
+#
+# Also works on its own, e.g. on a host build:
+#   python3 scripts/ram_report.py firmware.elf firmware.map [headroom] [nm]
+import os
+import re
+import subprocess
+import sys
+from collections import defaultdict
+
+DEFAULT_HEADROOM = 2048
+TOP_ROWS = 12
+
+
+def parse_memory_regions(lines):
+    """{name: (origin, length)} from the map's "Memory Configuration" table."""
+    regions = {}
+    inside = False
+    for line in lines:
+        if line.startswith("Memory Configuration"):
+            inside = True
+            continue
+        if inside and line.startswith("Linker script and memory map"):
+            break
+        m = re.match(r"^(\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)", line)
+        if inside and m and m.group(1) != "Name":
+            regions[m.group(1)] = (int(m.group(2), 16), int(m.group(3), 16))
+    return regions
+
+
+def object_name(path):
+    """main.cpp.o, or libFrameworkArduino.a for anything inside an archive."""
+    m = re.match(r"^(.*\.a)\((.*)\)$", path)
+    return os.path.basename(m.group(1)) if m else os.path.basename(path)
+
+
+RAM_SECTIONS = (".data", ".bss", ".noinit", ".heap", ".stack", ".tbss", ".tdata")
+
+
+def in_ram(output, addr, ram_origin, ram_length):
+    """By address when the map names a RAM region, else by section name."""
+    if ram_origin is not None:
+        return ram_origin <= addr < ram_origin + ram_length
+    return bool(output) and output.startswith(RAM_SECTIONS)
+
+
+def parse_map(path, ram_origin, ram_length):
+    """Static RAM per object, plus the heap/stack reservations by name."""
+    with open(path, errors="replace") as f:
+        lines = f.read().splitlines()
+    if ram_origin is None:
+        regions = parse_memory_regions(lines)
+        ram = regions.get("RAM")
+        if ram:
+            ram_origin, ram_length = ram
+
+    per_object = defaultdict(int)
+    reserved = defaultdict(int)
+    output = None
+    pending = None  # input section whose address/size is on the next line
+    started = False
+    for line in lines:
+        if line.startswith("Linker script and memory map"):
+            started = True
+            continue
+        if not started or not line.strip():
+            continue
+        # Output section: starts in column 0 ("  .bss  0x2000...  0x1234")
+        m = re.match(r"^(\.\S+)(?:\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+))?", line)
+        if m:
+            output = m.group(1)
+            pending = None
+            continue
+        # Input section, address/size/object on the same or the next line
+        m = re.match(r"^ (\.\S+|COMMON)\s*$", line)
+        if m:
+            pending = m.group(1)
+            continue
+        m = re.match(r"^ (?:(\.\S+|COMMON)\s+)?\s*0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$", line)
+        if not m or not (m.group(1) or pending):
+            continue
+        pending = None
+        addr, size, obj = int(m.group(2), 16), int(m.group(3), 16), m.group(4).strip()
+        if size == 0 or not in_ram(output, addr, ram_origin, ram_length):
+            continue
+        if output and ("heap" in output or "stack" in output):
+            reserved[output] += size
+        else:
+            per_object[object_name(obj)] += size
+    return per_object, reserved, ram_origin, ram_length
+
+
+def per_source(elf, nm, ram_origin, ram_length):
+    """Static RAM per source file (header) from `nm -S -l`."""
+    out = subprocess.run([nm, "-S", "-l", "--size-sort", elf], capture_output=True, text=True)
+    per_file = defaultdict(int)
+    for line in out.stdout.splitlines():
+        m = re.match(r"^([0-9a-fA-F]+) ([0-9a-fA-F]+) ([bBdD]) (\S+)(?:\t(.*):\d+)?$", line)
+        if not m:
+            continue
+        addr, size = int(m.group(1), 16), int(m.group(2), 16)
+        if ram_origin is not None and not (ram_origin <= addr < ram_origin + ram_length):
+            continue  # (no RAM region known: bBdD symbols are all RAM anyway)
+        per_file[os.path.basename(m.group(5)) if m.group(5) else "(no line info)"] += size
+    return per_file
+
+
+def print_table(title, sizes):
+    print(title)
+    rows = sorted(sizes.items(), key=lambda kv: -kv[1])
+    for name, size in rows[:TOP_ROWS]:
+        print("  %-32s %7d" % (name, size))
+    rest = sum(size for _, size in rows[TOP_ROWS:])
+    if rest:
+        print("  %-32s %7d" % ("(%d more)" % (len(rows) - TOP_ROWS), rest))
+
+
+def report(elf, map_path, headroom, nm, ram_origin=None, ram_length=None):
+    """Print the report. Returns False if the headroom is not met."""
+    per_object, reserved, ram_origin, ram_length = parse_map(map_path, ram_origin, ram_length)
+    static = sum(per_object.values())
+    reservations = sum(reserved.values())
+
+    print("\n--- RAM BUDGET ---")
+    print_table("Static RAM by object:", per_object)
+    print_table("Static RAM by game file:", per_source(elf, nm, ram_origin, ram_length))
+    for name, size in sorted(reserved.items()):
+        print("Reserved %-23s %7d" % (name, size))
+    if ram_origin is None:
+        print("Static %d bytes (no RAM region in the map: headroom not checked)" % static)
+        return True
+    free = ram_length - static - reservations
+    print("RAM %d bytes: static %d, reserved %d, free %d (need %d)"
+          % (ram_length, static, reservations, free, headroom))
+    if free < headroom:
+        print("RAM report: only %d bytes left, below custom_ram_headroom = %d" % (free, headroom))
+        return False
+    return True
+
+
+def platformio_hook(env):
+    map_path = os.path.join(env.subst("$BUILD_DIR"), "firmware.map")
+    env.Append(LINKFLAGS=["-Wl,-Map," + map_path])
+    headroom = int(env.GetProjectOption("custom_ram_headroom", DEFAULT_HEADROOM))
+    nm = env.subst("$CC").replace("gcc", "nm")
+    ram_length = int(env.BoardConfig().get("upload.maximum_ram_size", 0)) or None
+
+    def after_link(target, source, env):
+        elf = str(target[0])
+        # The RAM origin comes from the map; the board's RAM size wins if set
+        _, _, origin, length = parse_map(map_path, None, None)
+        if not report(elf, map_path, headroom, nm, origin, ram_length or length):
+            env.Exit(1)
+
+    env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", after_link)
+
+
+try:
+    Import("env")  # noqa: F821 (provided by PlatformIO/SCons)
+    platformio_hook(env)  # noqa: F821
+except NameError:
+    if __name__ == "__main__":
+        if len(sys.argv) < 3:
+            print(__doc__ or "usage: ram_report.py firmware.elf firmware.map [headroom] [nm]")
+            sys.exit(2)
+        ok = report(sys.argv[1], sys.argv[2],
+                    int(sys.argv[3]) if len(sys.argv) > 3 else DEFAULT_HEADROOM,
+                    sys.argv[4] if len(sys.argv) > 4 else "nm")
+        sys.exit(0 if ok else 1)
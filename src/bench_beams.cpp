@@ -0,0 +1,332 @@
+// --- BEAM SCORING THROUGHPUT BENCHMARK (host only) ---
+// How fast can balls go through a beam before MODE_R1 stops counting them?
+//
+// beamBroken() only looks at the sensor once per loop, so a ball is missed
+// if it enters and leaves the beam between two looks, or if two balls come
+// so close together that the beam never looks "clear" in between. This
+// sketch feeds simulated pulse trains into all four beam pins at once, runs
+// the real round1Update() with show() and Serial charged at hardware cost,
+// and prints what fraction of balls were scored.
+//
+// A second section compares the jar renderers: the old full redraw on
+// every loop against the incremental one in rounds.h. It reports how much
+// LED work each hit costs and how long it takes to become visible.
+//
+// Run with:  pio run -e bench_beams -t exec
+#include "config.h"
+#include "leds.h"
+#include "beams.h"
+#include "rounds.h"
+#include <HostShim.h>
+
+// Round 1 keeps its scores in the mode arena, normally defined in main.cpp
+ModeState modeState;
+
+// WS2812 at 800 kHz: 24 bits x 1.25 us per LED, plus the reset gap
+const unsigned long WIRE_US_PER_LED = 30;
+const unsigned long WIRE_LATCH_US = 300;
+// Rough cost of the rest of loop() (readRemote(), mode dispatch) per pass
+const unsigned long LOOP_BODY_US = 50;
+
+// How many balls go through each beam per measurement
+const int BALLS_PER_RUN = 40;
+// Drain r1Rows into the tally before the jar caps the score
+const uint8_t DRAIN_AT_ROWS = 8;
+
+struct BenchConfig {
+  const char* name;
+  unsigned long baud;        // 0 = Serial is free
+  bool modelShow;            // charge show() at wire speed
+  unsigned long loopDelayMs; // trailing delay() in loop()
+};
+
+const BenchConfig CONFIGS[] = {
+  {"shipped: 115200 baud, show() modelled, delay(10)", 115200, true, 10},
+  {"9600 baud, show() modelled, delay(10)", 9600, true, 10},
+  {"9600 baud, show() modelled, no delay", 9600, true, 0},
+  {"ideal: free show() and Serial, delay(10)", 0, false, 10},
+};
+const int NUM_CONFIGS = sizeof(CONFIGS) / sizeof(CONFIGS[0]);
+
+// Ball "shadow" length on the beam, in ms (long = slow ball, short = fast)
+const unsigned long WIDTHS_MS[] = {100, 50, 20, 10, 5, 2};
+const int NUM_WIDTHS = sizeof(WIDTHS_MS) / sizeof(WIDTHS_MS[0]);
+// Balls per second through a single beam
+const unsigned long RATES_HZ[] = {1, 2, 4, 6, 8, 12, 16};
+const int NUM_RATES = sizeof(RATES_HZ) / sizeof(RATES_HZ[0]);
+
+// --- Pulse train shared with the pin callback ---
+unsigned long trainStartUs = 0;
+unsigned long trainPeriodUs = 0;
+unsigned long trainWidthUs = 0;
+
+// Repeatable "random" offset for ball k on quadrant q, so balls don't line
+// up perfectly with the loop period (which would hide or exaggerate misses)
+unsigned long ballJitterUs(int q, int k) {
+  uint32_t h = (uint32_t)(q * 7919 + k * 104729 + 12345);
+  h ^= h << 13; h ^= h >> 17; h ^= h << 5;
+  unsigned long room = (trainPeriodUs - trainWidthUs) / 2;
+  return room ? h % room : 0;
+}
+
+int beamPinLevel(uint8_t pin, unsigned long nowUs) {
+  int q = -1;
+  for (int i = 0; i < NUM_STRIPS_CONNECTED; i++) if (BEAM_PINS[i] == pin) q = i;
+  if (q < 0) return -1;
+  if (trainPeriodUs == 0) return LOW; // no balls right now
+  // Stagger the quadrants by a quarter period each
+  unsigned long start = trainStartUs + (unsigned long)q * trainPeriodUs / 4;
+  if (nowUs < start) return LOW;
+  unsigned long k = (nowUs - start) / trainPeriodUs;
+  if (k >= (unsigned long)BALLS_PER_RUN) return LOW;
+  unsigned long ballStart = start + k * trainPeriodUs + ballJitterUs(q, (int)k);
+  bool broken = nowUs >= ballStart && nowUs < ballStart + trainWidthUs;
+  return broken ? HIGH : LOW; // HIGH = beam broken
+}
+
+void applyConfig(const BenchConfig& cfg) {
+  hostCosts.showUsPerLed = cfg.modelShow ? WIRE_US_PER_LED : 0;
+  hostCosts.showLatchUs = cfg.modelShow ? WIRE_LATCH_US : 0;
+  hostCosts.serialAtBaud = cfg.baud != 0;
+  hostCosts.serialFifoBytes = 0; // R4 UART write() blocks until sent
+  Serial.begin(cfg.baud ? cfg.baud : 9600);
+}
+
+// One pass of the MODE_R1 loop body. readRemote() is skipped: with no IR
+// traffic it returns straight away.
+void benchLoopOnce(const BenchConfig& cfg) {
+  delayMicroseconds(LOOP_BODY_US);
+  round1Update();
+  telemetryService(); // send the point records (charged at cfg.baud)
+  delay(cfg.loopDelayMs);
+}
+
+// Average loop period with nobody scoring
+float idleLoopMs(const BenchConfig& cfg) {
+  trainPeriodUs = 0;
+  round1Reset();
+  beamsReset();
+  const int iterations = 50;
+  unsigned long t0 = hostNowUs();
+  for (int i = 0; i < iterations; i++) benchLoopOnce(cfg);
+  return (hostNowUs() - t0) / 1000.0f / iterations;
+}
+
+// Percentage of balls scored across all four quadrants
+float measure(const BenchConfig& cfg, unsigned long widthMs, unsigned long rateHz) {
+  trainPeriodUs = 1000000UL / rateHz;
+  trainWidthUs = widthMs * 1000UL;
+  round1Reset();
+  beamsReset();
+  trainStartUs = hostNowUs() + 5000;
+
+  unsigned long endUs = trainStartUs + (unsigned long)(BALLS_PER_RUN + 1) * trainPeriodUs + 200000UL;
+  unsigned long scored = 0;
+  while (hostNowUs() < endUs) {
+    benchLoopOnce(cfg);
+    for (int q = 0; q < NUM_STRIPS_CONNECTED; q++) {
+      if (r1Rows[q] >= DRAIN_AT_ROWS) {
+        scored += r1Rows[q];
+        r1Rows[q] = 0;
+        modeState.r1.shownRows[q] = 0;
+        modeState.r1.riseStep[q] = 0;
+      }
+    }
+  }
+  for (int q = 0; q < NUM_STRIPS_CONNECTED; q++) scored += r1Rows[q];
+  trainPeriodUs = 0;
+  return 100.0f * scored / (BALLS_PER_RUN * NUM_STRIPS_CONNECTED);
+}
+
+// --- JAR RENDER COST ---
+// The renderer rounds.h used to have: clear and redraw every jar, border
+// and all, on every loop, whether or not anything changed.
+void legacyRound1Update() {
+  for (int q = 0; q < NUM_STRIPS_CONNECTED; q++) {
+    if (beamBroken(q)) {
+      if (r1Rows[q] < JAR_MAX_ROWS) {
+        r1Rows[q]++;
+        Serial.print("Point for Quad "); Serial.println(q);
+      }
+    }
+    drawJarWithProgress(q, r1Rows[q], strips[q].Color(255, 120, 255), 240, 240, 150);
+  }
+}
+
+struct RendererConfig {
+  const char* name;
+  void (*update)();
+};
+
+const RendererConfig RENDERERS[] = {
+  {"full redraw every loop (old)", legacyRound1Update},
+  {"incremental rows (rounds.h)", round1Update},
+};
+const int NUM_RENDERERS = sizeof(RENDERERS) / sizeof(RENDERERS[0]);
+
+// Points are handed straight to quadrant 0 (the beams stay clear), so this
+// measures drawing only; the table above covers beam detection.
+const int MAX_HITS = 8;
+unsigned long hitUs[MAX_HITS]; // when each point was scored
+
+// What the strip on quadrant 0 actually showed, row by row
+unsigned long rowVisibleUs[MAX_HITS]; // first frame with any honey in the row
+unsigned long rowFullUs[MAX_HITS];    // first frame with the row at full honey
+int fullRowsShown = 0;                // rows at full honey in the last frame
+int fullRowJumps = 0;                 // frames where 2+ rows filled at once
+unsigned long wireUs = 0;             // time spent inside show(), all strips
+uint32_t fullHoney = 0;               // full honey as read back from a strip
+
+void recordShow(Adafruit_NeoPixel& strip, unsigned long startUs, unsigned long endUs) {
+  wireUs += endUs - startUs;
+  if (&strip != &strips[0]) return;
+  int fullRows = 0;
+  for (int row = 0; row < MAX_HITS; row++) {
+    uint32_t c = strip.getPixelColor(xyToIndex(2, 2 + row));
+    if (c != 0 && rowVisibleUs[row] == 0) rowVisibleUs[row] = endUs;
+    if (c == fullHoney) {
+      if (rowFullUs[row] == 0) rowFullUs[row] = endUs;
+      fullRows++;
+    }
+  }
+  if (fullRows > fullRowsShown + 1) fullRowJumps++;
+  fullRowsShown = fullRows;
+}
+
+// Plays `hits` balls `spacingMs` apart through beam 0 and prints the cost
+void measureRender(const RendererConfig& r, int hits, unsigned long spacingMs) {
+  hostSerialEcho(false);
+  round1Enter();
+  memset(rowVisibleUs, 0, sizeof(rowVisibleUs));
+  memset(rowFullUs, 0, sizeof(rowFullUs));
+  fullRowsShown = 0;
+  fullRowJumps = 0;
+
+  unsigned long t0 = hostNowUs() + 5000;
+  unsigned long endUs = t0 + (hits - 1) * spacingMs * 1000UL + 2000000UL; // let the queue drain
+  int scored = 0;
+
+  unsigned long shows0 = hostShowCount;
+  unsigned long writes0 = hostPixelWrites;
+  wireUs = 0;
+  hostSetShowFn(recordShow);
+  while (hostNowUs() < endUs) {
+    while (scored < hits && hostNowUs() >= t0 + scored * spacingMs * 1000UL) {
+      hitUs[scored++] = hostNowUs();
+      r1Rows[0]++;
+    }
+    delayMicroseconds(LOOP_BODY_US);
+    r.update();
+    delay(10);
+  }
+  hostSetShowFn(nullptr);
+  hostSerialEcho(true);
+
+  unsigned long worstVisibleUs = 0, worstFullUs = 0;
+  int rises = 0;
+  for (int k = 0; k < hits; k++) {
+    if (rowVisibleUs[k] && rowVisibleUs[k] - hitUs[k] > worstVisibleUs) worstVisibleUs = rowVisibleUs[k] - hitUs[k];
+    if (rowFullUs[k] && rowFullUs[k] - hitUs[k] > worstFullUs) worstFullUs = rowFullUs[k] - hitUs[k];
+    if (rowFullUs[k]) rises++;
+  }
+
+  char buf[96];
+  snprintf(buf, sizeof(buf), "  shows/hit %5.1f  pixel writes/hit %6.0f  wire time/hit %6.1f ms",
+           (float)(hostShowCount - shows0) / hits, (float)(hostPixelWrites - writes0) / hits,
+           wireUs / 1000.0f / hits);
+  Serial.println(buf);
+  snprintf(buf, sizeof(buf), "  worst time to visible %5.1f ms  to full %5.1f ms  rows shown %d/%d  merged frames %d",
+           worstVisibleUs / 1000.0f, worstFullUs / 1000.0f, rises, hits, fullRowJumps);
+  Serial.println(buf);
+}
+
+void printPadded(const char* s, int width) {
+  int len = strlen(s);
+  for (int i = len; i < width; i++) Serial.print(' ');
+  Serial.print(s);
+}
+
+void setup() {
+  Serial.begin(9600);
+  ledsBegin();
+  beamsBegin();
+  hostSetPinFn(beamPinLevel);
+
+  Serial.println("\n--- BEAM SCORING THROUGHPUT ---");
+  Serial.print("Balls per beam per cell: "); Serial.println(BALLS_PER_RUN);
+  Serial.println("Cells show % of balls scored (all 4 beams busy at once).");
+
+  for (int c = 0; c < NUM_CONFIGS; c++) {
+    const BenchConfig& cfg = CONFIGS[c];
+    float results[NUM_WIDTHS][NUM_RATES];
+
+    hostSerialEcho(false);
+    applyConfig(cfg);
+    float idleMs = idleLoopMs(cfg);
+    for (int w = 0; w < NUM_WIDTHS; w++) {
+      for (int r = 0; r < NUM_RATES; r++) {
+        bool fits = WIDTHS_MS[w] * RATES_HZ[r] < 1000; // ball must clear before the next
+        results[w][r] = fits ? measure(cfg, WIDTHS_MS[w], RATES_HZ[r]) : -1;
+      }
+    }
+    hostCosts.serialAtBaud = false;
+    hostSerialEcho(true);
+
+    char buf[32];
+    Serial.print("\nConfig: "); Serial.println(cfg.name);
+    Serial.print("Idle loop period: "); Serial.print(idleMs, 1); Serial.println(" ms");
+    printPadded("width", 8);
+    for (int r = 0; r < NUM_RATES; r++) {
+      snprintf(buf, sizeof(buf), "%lu Hz", RATES_HZ[r]);
+      printPadded(buf, 7);
+    }
+    printPadded("max@100%", 10);
+    Serial.println();
+
+    for (int w = 0; w < NUM_WIDTHS; w++) {
+      snprintf(buf, sizeof(buf), "%lu ms", WIDTHS_MS[w]);
+      printPadded(buf, 8);
+      unsigned long best = 0;
+      bool stillPerfect = true;
+      for (int r = 0; r < NUM_RATES; r++) {
+        if (results[w][r] < 0) {
+          printPadded("--", 7);
+          continue;
+        }
+        snprintf(buf, sizeof(buf), "%.0f%%", results[w][r]);
+        printPadded(buf, 7);
+        if (stillPerfect && results[w][r] >= 99.99f) best = RATES_HZ[r];
+        else stillPerfect = false;
+      }
+      snprintf(buf, sizeof(buf), best ? "%lu Hz" : "none", best);
+      printPadded(buf, 10);
+      Serial.println();
+    }
+  }
+  // Jar renderers: one hit per second, then a burst of 5 hits in 125 ms
+  hostCosts.showUsPerLed = WIRE_US_PER_LED;
+  hostCosts.showLatchUs = WIRE_LATCH_US;
+  hostCosts.serialAtBaud = false;
+  {
+    Adafruit_NeoPixel probe(1, LED_PINS[0], NEO_GRB + NEO_KHZ800);
+    probe.setBrightness(params.brightness);
+    probe.setPixelColor(0, jarHoneyColor(JAR_RISE_STEPS));
+    fullHoney = probe.getPixelColor(0);
+  }
+  Serial.println("\n--- JAR RENDER COST PER HIT ---");
+  Serial.print("show() modelled, delay(10) loop, rise time "); Serial.print(params.jarRiseMs);
+  Serial.println(" ms");
+  for (int i = 0; i < NUM_RENDERERS; i++) {
+    Serial.print("\nRenderer: "); Serial.println(RENDERERS[i].name);
+    Serial.println(" 4 hits, 1 s apart:");
+    measureRender(RENDERERS[i], 4, 1000);
+    Serial.println(" burst of 5 hits, 25 ms apart:");
+    measureRender(RENDERERS[i], 5, 25);
+  }
+
+  Serial.println("\n--- BENCHMARK COMPLETE ---");
+  hostStop();
+}
+
+void loop() {
+}
@@ -0,0 +1,257 @@
+// --- PIXEL BLEND KERNEL BENCHMARK (host only) ---
+// Times the blend kernels (blend.h) against the obvious per-channel way of
+// doing the same thing through the NeoPixel API: getPixelColor(), split
+// into R G B, do the sum, Color(), setPixelColor(), for every LED of every
+// quadrant. Also checks that the word-at-a-time kernels give exactly the
+// same bytes as doing each channel on its own.
+//
+// The times are host CPU times: compare the two columns with each other,
+// not with the board. On the board the per-channel version also pays for
+// the brightness divide in getPixelColor() on every LED, like here.
+//
+// Run with:  pio run -e bench_blend -t exec
+#include <HostShim.h>
+#include <Adafruit_NeoPixel.h>
+#include <chrono>
+#include "config.h"
+#include "blend.h"
+
+const uint8_t BENCH_BRIGHTNESS = 60; // roughly what the show runs at
+const int REPEATS = 2000;            // frames timed per operation
+
+Adafruit_NeoPixel scene[NUM_STRIPS_CONNECTED];  // what is on the wall
+Adafruit_NeoPixel target[NUM_STRIPS_CONNECTED]; // cross-fade to / layer to add
+Adafruit_NeoPixel work[NUM_STRIPS_CONNECTED];   // result
+
+uint32_t rngState = 12345;
+uint8_t rngByte() {
+  rngState ^= rngState << 13; rngState ^= rngState >> 17; rngState ^= rngState << 5;
+  return (uint8_t)rngState;
+}
+
+void fillRandom(Adafruit_NeoPixel* strips) {
+  for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) {
+    for (uint16_t i = 0; i < LEDS_PER_QUAD; i++) strips[q].setPixelColor(i, rngByte(), rngByte(), rngByte());
+  }
+}
+
+void copyStrips(Adafruit_NeoPixel* to, Adafruit_NeoPixel* from) {
+  for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) memcpy(to[q].getPixels(), from[q].getPixels(), LEDS_PER_QUAD * 3);
+}
+
+// --- The per-channel way ---
+uint8_t chan(uint32_t c, uint8_t shift) { return (c >> shift) & 0xFF; }
+
+void naiveScale(uint8_t level) {
+  for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) {
+    for (uint16_t i = 0; i < LEDS_PER_QUAD; i++) {
+      uint32_t c = work[q].getPixelColor(i);
+      work[q].setPixelColor(i, work[q].Color(chan(c, 16) * level / 255, chan(c, 8) * level / 255,
+                                             chan(c, 0) * level / 255));
+    }
+  }
+}
+
+void naiveLerp(uint8_t mix) {
+  for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) {
+    for (uint16_t i = 0; i < LEDS_PER_QUAD; i++) {
+      uint32_t a = scene[q].getPixelColor(i), b = target[q].getPixelColor(i);
+      uint8_t rgb[3];
+      for (uint8_t k = 0; k < 3; k++) {
+        int from = chan(a, 16 - 8 * k), to = chan(b, 16 - 8 * k);
+        rgb[k] = from + (to - from) * mix / 255;
+      }
+      work[q].setPixelColor(i, work[q].Color(rgb[0], rgb[1], rgb[2]));
+    }
+  }
+}
+
+void naiveAddScaled(uint8_t level) {
+  for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) {
+    for (uint16_t i = 0; i < LEDS_PER_QUAD; i++) {
+      uint32_t a = work[q].getPixelColor(i), b = target[q].getPixelColor(i);
+      uint8_t rgb[3];
+      for (uint8_t k = 0; k < 3; k++) {
+        int sum = chan(a, 16 - 8 * k) + chan(b, 16 - 8 * k) * level / 255;
+        rgb[k] = sum > 255 ? 255 : sum;
+      }
+      work[q].setPixelColor(i, work[q].Color(rgb[0], rgb[1], rgb[2]));
+    }
+  }
+}
+
+void naiveAdd(uint8_t) {
+  for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) {
+    for (uint16_t i = 0; i < LEDS_PER_QUAD; i++) {
+      uint32_t a = work[q].getPixelColor(i), b = target[q].getPixelColor(i);
+      uint8_t rgb[3];
+      for (uint8_t k = 0; k < 3; k++) {
+        int sum = chan(a, 16 - 8 * k) + chan(b, 16 - 8 * k);
+        rgb[k] = sum > 255 ? 255 : sum;
+      }
+      work[q].setPixelColor(i, work[q].Color(rgb[0], rgb[1], rgb[2]));
+    }
+  }
+}
+
+// --- The kernels, over whole quadrants ---
+void kernelScale(uint8_t level) {
+  for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) blendScale(work[q].getPixels(), LEDS_PER_QUAD, level);
+}
+
+void kernelLerp(uint8_t mix) {
+  for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) {
+    blendLerp(work[q].getPixels(), scene[q].getPixels(), target[q].getPixels(), LEDS_PER_QUAD, mix);
+  }
+}
+
+void kernelAddScaled(uint8_t level) {
+  for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) {
+    blendAddScaled(work[q].getPixels(), target[q].getPixels(), LEDS_PER_QUAD, level);
+  }
+}
+
+void kernelAdd(uint8_t) {
+  for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) blendAdd(work[q].getPixels(), target[q].getPixels(), LEDS_PER_QUAD);
+}
+
+// Microseconds per whole-wall frame; the level walks so nothing is constant
+double timeFrames(void (*op)(uint8_t)) {
+  copyStrips(work, scene);
+  auto t0 = std::chrono::steady_clock::now();
+  for (int r = 0; r < REPEATS; r++) {
+    op((uint8_t)(r * 7));
+    if (r % 8 == 7) copyStrips(work, scene); // don't fade to black
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::micro>(t1 - t0).count() / REPEATS;
+}
+
+// --- Exactness: word-at-a-time against one byte at a time ---
+int failures = 0;
+
+void check(bool ok, const char* what) {
+  Serial.print(ok ? "  PASS  " : "  FAIL  ");
+  Serial.println(what);
+  if (!ok) failures++;
+}
+
+bool scaleExact() {
+  uint8_t px[LEDS_PER_QUAD * 3], ref[LEDS_PER_QUAD * 3];
+  for (int level = 0; level < 256; level++) {
+    for (uint16_t i = 0; i < sizeof(px); i++) px[i] = ref[i] = rngByte();
+    uint16_t w = blendWeight(level);
+    for (uint16_t i = 0; i < sizeof(ref); i++) ref[i] = blendScaleByte(ref[i], w);
+    blendScale(px, LEDS_PER_QUAD, level);
+    if (memcmp(px, ref, sizeof(px)) != 0) return false;
+    if (level == 255) {
+      // 255 leaves every byte as it was
+      for (uint16_t i = 0; i < 256; i++) px[i] = i;
+      blendScale(px, 85, 255);
+      for (uint16_t i = 0; i < 255; i++) if (px[i] != i) return false;
+    }
+  }
+  return true;
+}
+
+bool lerpExact() {
+  uint8_t a[LEDS_PER_QUAD * 3], b[LEDS_PER_QUAD * 3], out[LEDS_PER_QUAD * 3];
+  for (int mix = 0; mix < 256; mix++) {
+    for (uint16_t i = 0; i < sizeof(a); i++) { a[i] = rngByte(); b[i] = rngByte(); }
+    blendLerp(out, a, b, LEDS_PER_QUAD, mix);
+    uint16_t wb = blendWeight(mix), wa = 256 - wb;
+    for (uint16_t i = 0; i < sizeof(out); i++) if (out[i] != blendLerpByte(a[i], b[i], wa, wb)) return false;
+    if (mix == 0 && memcmp(out, a, sizeof(a)) != 0) return false;
+    if (mix == 255 && memcmp(out, b, sizeof(b)) != 0) return false;
+  }
+  return true;
+}
+
+bool addExact() {
+  // Every pair of byte values, in every byte of the word
+  for (int x = 0; x < 256; x++) {
+    for (int y = 0; y < 256; y++) {
+      uint8_t out[4] = {(uint8_t)x, (uint8_t)y, (uint8_t)(255 - x), (uint8_t)(x ^ y)};
+      uint8_t src[4] = {(uint8_t)y, (uint8_t)x, (uint8_t)(255 - y), (uint8_t)(x + y)};
+      uint32_t r = blendAddWord(blendLoad(out), blendLoad(src));
+      uint8_t got[4];
+      blendStore(got, r);
+      for (uint8_t k = 0; k < 4; k++) if (got[k] != blendAddByte(out[k], src[k])) return false;
+    }
+  }
+  uint8_t a[LEDS_PER_QUAD * 3], b[LEDS_PER_QUAD * 3], ref[LEDS_PER_QUAD * 3];
+  for (int level = 0; level < 256; level += 15) {
+    for (uint16_t i = 0; i < sizeof(a); i++) { a[i] = ref[i] = rngByte(); b[i] = rngByte(); }
+    uint16_t w = blendWeight(level);
+    for (uint16_t i = 0; i < sizeof(ref); i++) ref[i] = blendAddByte(ref[i], blendScaleByte(b[i], w));
+    blendAddScaled(a, b, LEDS_PER_QUAD, level);
+    if (memcmp(a, ref, sizeof(a)) != 0) return false;
+  }
+  return true;
+}
+
+// Odd spans: start and length anywhere, bytes around them untouched
+bool spansExact() {
+  uint8_t px[64], ref[64];
+  for (uint8_t first = 0; first < 4; first++) {
+    for (uint8_t count = 0; count < 17; count++) {
+      for (uint8_t i = 0; i < sizeof(px); i++) px[i] = ref[i] = rngByte();
+      for (uint16_t i = first * 3; i < (first + count) * 3; i++) ref[i] = blendScaleByte(ref[i], blendWeight(100));
+      blendScale(&px[first * 3], count, 100);
+      if (memcmp(px, ref, sizeof(px)) != 0) return false;
+    }
+  }
+  return true;
+}
+
+struct BenchOp {
+  const char* name;
+  void (*naive)(uint8_t);
+  void (*kernel)(uint8_t);
+};
+
+const BenchOp OPS[] = {
+  {"fade (scale)", naiveScale, kernelScale},
+  {"cross-fade (lerp)", naiveLerp, kernelLerp},
+  {"additive blend", naiveAddScaled, kernelAddScaled},
+  {"saturating add", naiveAdd, kernelAdd},
+};
+
+void setup() {
+  Serial.begin(9600);
+  Adafruit_NeoPixel* sets[] = {scene, target, work};
+  for (Adafruit_NeoPixel* set : sets) {
+    for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) {
+      set[q].updateLength(LEDS_PER_QUAD);
+      set[q].setBrightness(BENCH_BRIGHTNESS);
+    }
+  }
+  fillRandom(scene);
+  fillRandom(target);
+
+  Serial.println("\n--- PIXEL BLEND KERNELS ---");
+  Serial.print(NUM_STRIPS_CONNECTED * LEDS_PER_QUAD); Serial.print(" LEDs per frame, ");
+  Serial.print(REPEATS); Serial.println(" frames per number (host CPU time)");
+  Serial.println("Operation              per-channel    kernel   speed-up");
+  char buf[96];
+  for (const BenchOp& op : OPS) {
+    double kernelUs = timeFrames(op.kernel);
+    double naiveUs = timeFrames(op.naive);
+    snprintf(buf, sizeof(buf), "%-20s %9.1f us %7.1f us %8.1fx", op.name, naiveUs, kernelUs, naiveUs / kernelUs);
+    Serial.println(buf);
+  }
+
+  Serial.println("\nSame bytes as one channel at a time:");
+  check(scaleExact(), "scale, every level (255 = unchanged)");
+  check(lerpExact(), "lerp, every mix (0 = from, 255 = to)");
+  check(addExact(), "saturating add, every pair of values; additive blend");
+  check(spansExact(), "spans of any start and length leave their neighbours alone");
+
+  Serial.print("\n--- BLEND BENCHMARK ");
+  Serial.print(failures ? "FAILED" : "COMPLETE");
+  Serial.print(" --- ("); Serial.print(failures); Serial.println(" failed)");
+  hostStop();
+}
+
+void loop() {
+}
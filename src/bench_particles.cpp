@@ -0,0 +1,273 @@
+// --- PARTICLE BENCHMARK (host only) ---
+// How much does a frame of particles (particles.h) cost, and what does the
+// budget do when frames get too expensive?
+//
+// 1. Particles per frame against frame time: the pool is kept at N live
+//    particles over the Round 1 jars, and each frame is put back with the
+//    undo list (particlesErase) and drawn again. The second column does the
+//    same by redrawing all four jars first, which is what it would take
+//    without the undo list.
+// 2. The budget: a small burst is asked for every frame while the frame
+//    cost is fed back into particlesSettle(). Host time is scaled by
+//    BOARD_SLOWDOWN as a stand-in for the board's 48 MHz Cortex-M4, so read
+//    the numbers as "how the budget reacts", not as board timings.
+// 3. Checks: the scene comes back byte for byte, particles only go on the
+//    quadrants they are allowed on, and the budget steps bursts down a
+//    quarter at a time and back up again.
+//
+// Run with:  pio run -e bench_particles -t exec
+#include <HostShim.h>
+#include <chrono>
+#include "config.h"
+#include "leds.h"
+#include "particles.h"
+
+const uint8_t BENCH_BRIGHTNESS = 60;  // roughly what the show runs at
+const int FRAMES = 20000;             // frames timed per row
+const uint8_t JAR_ROWS = 8;           // honey in every jar behind the particles
+const double BOARD_SLOWDOWN = 40;     // board us per host us (section 2 only)
+
+ParticlePool pool;
+bool ALL_QUADS[NUM_STRIPS_CONNECTED];  // every quadrant may be drawn on
+uint8_t scene[NUM_STRIPS_CONNECTED][LEDS_PER_QUAD * 3];  // the jars without particles
+
+int failures = 0;
+
+void check(bool ok, const char* what) {
+  Serial.print(ok ? "  PASS  " : "  FAIL  ");
+  Serial.println(what);
+  if (!ok) failures++;
+}
+
+void drawJars() {
+  for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) {
+    drawJarBorder(q, strips[q].Color(255, 120, 255));
+    for (uint8_t row = 0; row < JAR_ROWS; row++) drawJarRow(q, row, strips[q].Color(128, 128, 0));
+  }
+}
+
+void saveScene() {
+  for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) memcpy(scene[q], strips[q].getPixels(), sizeof(scene[q]));
+}
+
+bool sceneIntact() {
+  for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) {
+    if (memcmp(scene[q], strips[q].getPixels(), sizeof(scene[q])) != 0) return false;
+  }
+  return true;
+}
+
+void resetPool() {
+  memset(&pool, 0, sizeof(pool));
+  rngSeed(7);
+}
+
+// Top the pool back up to n with a mix of all three kinds, from spots all
+// over the wall
+void refill(uint8_t n) {
+  while (pool.live < n) {
+    uint8_t kind = rngRange(0, PARTICLE_KIND_COUNT);
+    uint8_t x = rngRange(0, WALL_COLS), y = rngRange(0, WALL_ROWS);
+    if (particlesBurst(pool, kind, x, y, n - pool.live) == 0) break;
+  }
+}
+
+// --- 1. Frame time against particle count ---
+struct Cost {
+  double undoUs, redrawUs;  // host us per frame
+  double pixels;            // pixels drawn per frame
+  double quads;             // quadrants with a particle on them per frame
+};
+
+Cost timeCount(uint8_t n) {
+  Cost c = {};
+  unsigned long pixels = 0, quads = 0;
+  resetPool();
+  drawJars();
+  auto t0 = std::chrono::steady_clock::now();
+  for (int f = 0; f < FRAMES; f++) {
+    particlesErase(pool);
+    refill(n);
+    particlesFrame(pool, ALL_QUADS);
+    pixels += pool.undoCount;
+    uint8_t touched = 0;
+    for (uint8_t i = 0; i < pool.undoCount; i++) touched |= 1 << pool.undo[i].q;
+    for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) quads += touched >> q & 1;
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  particlesErase(pool);
+
+  resetPool();
+  auto t2 = std::chrono::steady_clock::now();
+  for (int f = 0; f < FRAMES / 10; f++) {
+    drawJars();
+    refill(n);
+    particlesForget(pool);
+    particlesFrame(pool, ALL_QUADS);
+  }
+  auto t3 = std::chrono::steady_clock::now();
+
+  c.undoUs = std::chrono::duration<double, std::micro>(t1 - t0).count() / FRAMES;
+  c.redrawUs = std::chrono::duration<double, std::micro>(t3 - t2).count() / (FRAMES / 10);
+  c.pixels = (double)pixels / FRAMES;
+  c.quads = (double)quads / FRAMES;
+  return c;
+}
+
+// --- 2. The budget at work ---
+struct BudgetRun {
+  double frameUs;   // modelled board us per frame
+  double live;      // particles flying per frame
+  double asked, got; // particles per burst
+  unsigned long overFrames;
+};
+
+BudgetRun runBudget(uint16_t budgetUs, uint8_t burst) {
+  BudgetRun r = {};
+  params.particleBudgetUs = budgetUs;
+  resetPool();
+  drawJars();
+  unsigned long asked = 0, got = 0;
+  for (int f = 0; f < FRAMES; f++) {
+    auto t0 = std::chrono::steady_clock::now();
+    particlesErase(pool);
+    asked += burst;
+    got += particlesBurst(pool, PARTICLE_SPARK, rngRange(0, WALL_COLS), rngRange(0, WALL_ROWS), burst);
+    particlesStep(pool);
+    particlesDraw(pool, ALL_QUADS);
+    auto t1 = std::chrono::steady_clock::now();
+    double us = std::chrono::duration<double, std::micro>(t1 - t0).count() * BOARD_SLOWDOWN;
+    particlesSettle(pool, (unsigned long)us);
+    r.frameUs += us;
+    r.live += pool.live;
+    if (us > budgetUs) r.overFrames++;
+  }
+  particlesErase(pool);
+  r.frameUs /= FRAMES;
+  r.live /= FRAMES;
+  r.asked = asked;
+  r.got = got;
+  params.particleBudgetUs = PARAM_DEFAULTS.particleBudgetUs;
+  return r;
+}
+
+// --- 3. Checks ---
+bool eraseRestores() {
+  resetPool();
+  drawJars();
+  saveScene();
+  for (int f = 0; f < 500; f++) {
+    particlesErase(pool);
+    refill(PARTICLE_MAX);
+    particlesFrame(pool, ALL_QUADS);
+  }
+  bool drewSomething = !sceneIntact();
+  particlesErase(pool);
+  return drewSomething && sceneIntact();
+}
+
+bool onlyOnCanvas() {
+  resetPool();
+  drawJars();
+  saveScene();
+  bool canvas[NUM_STRIPS_CONNECTED] = {};
+  canvas[Q_BOTTOM_LEFT] = true;
+  bool ok = true, drew = false;
+  for (int f = 0; f < 500; f++) {
+    particlesErase(pool);
+    refill(PARTICLE_MAX);
+    particlesFrame(pool, canvas);
+    for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) {
+      bool same = memcmp(scene[q], strips[q].getPixels(), sizeof(scene[q])) == 0;
+      if (q == Q_BOTTOM_LEFT) drew |= !same;
+      else ok &= same;
+    }
+  }
+  particlesErase(pool);
+  return ok && drew && sceneIntact();
+}
+
+// How many of a burst of 8 start at each step of the budget (pool emptied
+// in between so only the budget decides)
+uint8_t burstNow() {
+  uint8_t shed = pool.shed, calm = pool.calmFrames;
+  resetPool();
+  pool.shed = shed;
+  pool.calmFrames = calm;
+  return particlesBurst(pool, PARTICLE_SPARK, 10, 10, 8);
+}
+
+bool budgetSteps() {
+  resetPool();
+  uint16_t budget = params.particleBudgetUs;
+  bool ok = burstNow() == 8;
+  const uint8_t down[] = {6, 4, 2, 0, 0};
+  for (uint8_t expect : down) {
+    particlesSettle(pool, budget + 1);
+    ok &= burstNow() == expect;
+  }
+  // Not cheap enough to count as calm: stays shed
+  for (int f = 0; f < 2 * PARTICLE_CALM_FRAMES; f++) particlesSettle(pool, budget);
+  ok &= burstNow() == 0;
+  // Calm frames bring a quarter back at a time
+  for (int f = 0; f < PARTICLE_CALM_FRAMES; f++) particlesSettle(pool, budget / 2);
+  ok &= burstNow() == 2;
+  for (int f = 0; f < 3 * PARTICLE_CALM_FRAMES; f++) particlesSettle(pool, 0);
+  ok &= burstNow() == 8;
+  return ok;
+}
+
+bool budgetZeroIsOff() {
+  resetPool();
+  params.particleBudgetUs = 0;
+  bool ok = particlesBurst(pool, PARTICLE_CONFETTI, 10, 30, 8) == 0 && pool.live == 0;
+  params.particleBudgetUs = PARAM_DEFAULTS.particleBudgetUs;
+  return ok;
+}
+
+void setup() {
+  Serial.begin(9600);
+  stripsConfigure();
+  for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) {
+    strips[q].begin();
+    strips[q].setBrightness(BENCH_BRIGHTNESS);
+    ALL_QUADS[q] = true;
+  }
+
+  char buf[128];
+  Serial.println("\n--- PARTICLES ---");
+  Serial.print("Pool of "); Serial.print(PARTICLE_MAX); Serial.print(" ("); Serial.print((unsigned long)sizeof(ParticlePool));
+  Serial.print(" bytes); "); Serial.print(FRAMES); Serial.println(" frames per row (host CPU time)");
+  Serial.println("Particles   undo list   full redraw   pixels drawn   quadrants touched");
+  const uint8_t COUNTS[] = {0, 6, 12, 24, 36, PARTICLE_MAX};
+  for (uint8_t n : COUNTS) {
+    Cost c = timeCount(n);
+    snprintf(buf, sizeof(buf), "%9u %9.2f us %10.2f us %14.1f %19.1f", n, c.undoUs, c.redrawUs, c.pixels, c.quads);
+    Serial.println(buf);
+  }
+
+  Serial.print("\nBudget: a burst of 3 sparks asked for every frame (host time x");
+  Serial.print((int)BOARD_SLOWDOWN); Serial.println(" as board time)");
+  Serial.println("Budget        frame   over budget   flying   burst got");
+  const uint16_t BUDGETS[] = {20000, 80, 60, 40, 20};
+  for (uint16_t budget : BUDGETS) {
+    BudgetRun r = runBudget(budget, 3);
+    snprintf(buf, sizeof(buf), "%6u us %7.1f us %12.1f%% %8.1f %8.1f of 3", budget, r.frameUs,
+             100.0 * r.overFrames / FRAMES, r.live, 3 * r.got / r.asked);
+    Serial.println(buf);
+  }
+
+  Serial.println("\nChecks:");
+  check(eraseRestores(), "erasing puts the scene back byte for byte");
+  check(onlyOnCanvas(), "particles only drawn on the quadrants allowed");
+  check(budgetSteps(), "over budget: bursts shrink a quarter at a time, calm frames bring them back");
+  check(budgetZeroIsOff(), "particle_budget_us 0: no new particles");
+
+  Serial.print("\n--- PARTICLE BENCHMARK ");
+  Serial.print(failures ? "FAILED" : "COMPLETE");
+  Serial.print(" --- ("); Serial.print(failures); Serial.println(" failed)");
+  hostStop();
+}
+
+void loop() {
+}
@@ -0,0 +1,91 @@
+// --- LOOP PROFILE BENCHMARK (host only) ---
+// Runs the real game (src/main.cpp, built with LOOP_PROFILER) through a
+// short show: Intro, Round 1 with balls dropping, Round 2 with every
+// effect, Round 3 with the boundary moving, and the Finale. After each
+// scene it types "prof" into the console, exactly like you would on the
+// board, and prints the per-section timings.
+//
+// On the host the profiler uses std::chrono, so these numbers are host CPU
+// time for the game logic; show() wire time only shows up on the board
+// (pio run -e profile, then type "prof" in the Serial Monitor).
+//
+// The game's binary records (state feed and telemetry) go through their
+// decoders and are dropped, so only the console's text reaches stdout.
+//
+// Run with:  pio run -e bench_profile -t exec
+#include <HostTest.h>
+#include "feed_decode.h"
+#include "telemetry_decode.h"
+
+// --- Serial: records out, console text to stdout while `echo` is on ---
+FeedDecoder feed = {};
+TelemetryDecoder telemetry = {};
+bool echo = false;
+
+void onFeed(const FeedDecoder&, uint16_t, uint8_t, const uint8_t*, uint8_t) {}
+void onTelemetry(uint32_t, uint8_t, uint16_t) {}
+void onText(uint8_t c) { if (echo) fputc(c, stdout); }
+void onOther(uint8_t c) { telemetryDecodeByte(telemetry, c, onTelemetry, onText); }
+void onSerialByte(uint8_t c) { feedDecodeByte(feed, c, onFeed, onOther); }
+
+// Start counting from zero, run the scene, then print the timings
+void profile(const char* scene, void (*play)()) {
+  hostSerialType("prof reset\n");
+  runMs(20);
+  play();
+  printf("\n[%s]\n", scene);
+  echo = true;
+  hostSerialType("prof\n");
+  runMs(1000); // the console prints one section per loop
+  echo = false;
+}
+
+void playIntro() { press(CODE_CH_MINUS); runMs(3000); }
+
+void playRound1() {
+  press(CODE_1);
+  for (int i = 0; i < 40; i++) {
+    uint8_t pin = BEAM_PINS[i % 4];
+    hostSetPin(pin, HIGH); runMs(40);
+    hostSetPin(pin, LOW);  runMs(60);
+  }
+  runMs(1000);
+}
+
+void playRound2() {
+  press(CODE_2);
+  press(CODE_7); press(CODE_NEXT);   // top-right steady
+  press(CODE_8); press(CODE_PREV);   // top-left flicker
+  runMs(2000);
+  press(CODE_9); press(CODE_PREV);   // top-left fast flicker
+  runMs(2000);
+  press(CODE_LOSE);                 // bottom-right lose
+  runMs(1000);
+}
+
+void playRound3() {
+  press(CODE_3);
+  for (int i = 0; i < 10; i++) press(CODE_NEXT);
+  for (int i = 0; i < 5; i++) press(CODE_PREV);
+  runMs(2000);
+}
+
+void playFinale() { press(CODE_5); runMs(3000); }
+
+int main() {
+  // Rough WS2812 cost so the virtual clock moves like the board's would
+  hostCosts.showUsPerLed = 30;
+  hostCosts.showLatchUs = 300;
+  hostSerialEcho(false);
+  hostSetSerialFn(onSerialByte);
+  setup();
+  runMs(200);
+
+  printf("\n--- LOOP PROFILE (host CPU time, us) ---\n");
+  profile("Intro", playIntro);
+  profile("Round 1", playRound1);
+  profile("Round 2", playRound2);
+  profile("Round 3", playRound3);
+  profile("Finale", playFinale);
+  return 0;
+}
@@ -0,0 +1,49 @@
+// --- STATE FEED DECODER (host only) ---
+// Reads the raw Serial stream of the game from stdin (or a file) and
+// prints one JSON line per state feed record (feed.h): the whole state as
+// it is after that record, plus the event if it was one. Telemetry records
+// and text are skipped. Made for the scoreboard overlay: read the lines,
+// draw the latest one, wait for "synced": true after starting late.
+//
+// Run with, for example:
+//   pio run -e decode_feed
+//   pio device monitor -e main --raw --quiet | .pio/build/decode_feed/program
+//   .pio/build/decode_feed/program capture.bin
+#include "feed_decode.h"
+#include "telemetry_decode.h"
+
+const char* modeName(uint8_t mode) { return mode < 7 ? TELEMETRY_MODE_NAMES[mode] : "?"; }
+const char* effectName(uint8_t kind) { return kind < 7 ? TELEMETRY_EFFECT_NAMES[kind] : "?"; }
+
+void printRecord(const FeedDecoder& d, uint16_t seq, uint8_t type, const uint8_t* body, uint8_t len) {
+  const FeedView& v = d.view;
+  printf("{\"seq\":%u,\"synced\":%s,\"mode\":\"%s\",\"boundary\":%u,\"rows\":[", seq,
+         v.synced ? "true" : "false", modeName(v.mode), v.boundary);
+  for (uint8_t q = 0; q < v.quads; q++) printf("%s%u", q ? "," : "", v.rows[q]);
+  printf("],\"effects\":[");
+  for (uint8_t q = 0; q < v.quads; q++) printf("%s\"%s\"", q ? "," : "", effectName(v.effects[q]));
+  printf("]");
+  if (type == FEED_EVENT && len == 2 && body[0] < FEED_EVENT_COUNT) {
+    printf(",\"event\":\"%s\"", FEED_EVENT_NAMES[body[0]]);
+    if (body[1] != FEED_NO_QUAD) printf(",\"quad\":%u", body[1]);
+  }
+  printf("}\n");
+  fflush(stdout);
+}
+
+void skip(uint8_t) {}
+
+int main(int argc, char** argv) {
+  FILE* in = argc > 1 ? fopen(argv[1], "rb") : stdin;
+  if (!in) {
+    fprintf(stderr, "Can't open %s\n", argv[1]);
+    return 1;
+  }
+  FeedDecoder decoder = {};
+  int c;
+  while ((c = fgetc(in)) != EOF) feedDecodeByte(decoder, (uint8_t)c, printRecord, skip);
+  if (decoder.lost) fprintf(stderr, "%lu records lost\n", decoder.lost);
+  if (decoder.badVersion) fprintf(stderr, "%lu snapshots of an unknown version (this decoder: v%u)\n",
+                                  decoder.badVersion, FEED_VERSION);
+  return 0;
+}
@@ -0,0 +1,56 @@
+// --- TELEMETRY DECODER (host only) ---
+// Reads the raw Serial stream of the game from stdin (or a file) and
+// prints it with the binary event records turned into timestamped lines.
+// State feed records (feed.h) are shown too, marked "feed".
+//
+// Run with, for example:
+//   pio run -e decode_telemetry
+//   pio device monitor -e main --raw --quiet | .pio/build/decode_telemetry/program
+//   .pio/build/decode_telemetry/program capture.bin
+#include "feed_decode.h"
+#include "telemetry_decode.h"
+
+bool atLineStart = true;
+
+void printRecord(uint32_t ms, uint8_t event, uint16_t arg) {
+  char text[64];
+  telemetryDescribe(event, arg, text, sizeof(text));
+  if (!atLineStart) putchar('\n');
+  printf("[%6lu.%03lu] %s\n", (unsigned long)(ms / 1000), (unsigned long)(ms % 1000), text);
+  atLineStart = true;
+  fflush(stdout);
+}
+
+void printFeed(const FeedDecoder&, uint16_t seq, uint8_t type, const uint8_t* body, uint8_t len) {
+  char text[96];
+  feedDescribe(type, body, len, text, sizeof(text));
+  if (!atLineStart) putchar('\n');
+  printf("[feed %5u] %s\n", seq, text);
+  atLineStart = true;
+  fflush(stdout);
+}
+
+void printText(uint8_t c) {
+  if (c == '\r') return;
+  putchar(c);
+  atLineStart = c == '\n';
+  if (atLineStart) fflush(stdout);
+}
+
+TelemetryDecoder decoder = {};
+FeedDecoder feedDecoder = {};
+
+// Bytes that aren't state feed records: telemetry or text
+void decodeTelemetry(uint8_t c) { telemetryDecodeByte(decoder, c, printRecord, printText); }
+
+int main(int argc, char** argv) {
+  FILE* in = argc > 1 ? fopen(argv[1], "rb") : stdin;
+  if (!in) {
+    fprintf(stderr, "Can't open %s\n", argv[1]);
+    return 1;
+  }
+  int c;
+  while ((c = fgetc(in)) != EOF) feedDecodeByte(feedDecoder, (uint8_t)c, printFeed, decodeTelemetry);
+  if (decoder.bad) fprintf(stderr, "%lu damaged records skipped\n", decoder.bad);
+  return 0;
+}
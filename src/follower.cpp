@@ -0,0 +1,20 @@
+// --- LINK FOLLOWER FIRMWARE ---
+// A board that only drives LEDs for a link leader (link.h): it takes the
+// leader's frames on Serial1 and shows its own quadrants (LINK_QUAD_BOARD
+// in config.h) when the sync line toggles. Build one per board:
+//   pio run -e follower1 -t upload   (LINK_BOARD=1)
+//   pio run -e follower2 -t upload   (LINK_BOARD=2)
+// The USB Serial Monitor gets a stats line every 10 s.
+#include "config.h"
+#include "leds.h"
+#include "link.h"
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("\n--- HIVE MIND LINK FOLLOWER ---");
+  linkFollowerBegin(LINK_BOARD);
+}
+
+void loop() {
+  linkFollowerService();
+}
@@ -0,0 +1,1136 @@
+// --- SCENARIO RUNNER (host only) ---
+// Plays scripted shows (scenarios/*.scn) against the real game (src/main.cpp,
+// built with LATENCY_TRACE) on the host's virtual clock, far faster than
+// real time, and checks what the game did. A scenario is a list of timed
+// inputs and checks, one per line:
+//
+//   # Round 1: three balls in quadrant 2
+//   seed 7                       flicker/flash randomness (rng.h), default 1
+//   t=0     key CH-              remote button(s): CH- CH+ 0-9 PREV NEXT PAUSE
+//   t=2s    key 1                LOSE WIN or a raw code like 0xF30CFF00;
+//   t=30s   key 2 8 PREV         several are pressed 400 ms apart
+//   t=3s    beam 2 pulses 3 hz 5 ball(s) through beam 2: count, rate, and
+//                                optionally "width 40ms" per ball
+//   +500ms  type set brightness 80   a console command
+//   t=5s    expect mode R1       checks: mode, score <quad> <rows>,
+//           expect score 2 3     effect <quad> <name>, lit <quad> <op> <n>,
+//           expect pixel 0 8 4 green    pixel <quad> <x> <y> <off|on|red|...>
+//           expect loop_ms <= 1500      and, over the run so far: loop_ms and
+//                                shows_per_loop <op> <n> (the longest loop()
+//                                and most show() calls in one), frame_ms and
+//                                shows_per_frame (the same, leaving out the
+//                                loops that entered a mode), no_stray_flicker
+//   t=40s   end                  run until here (default: 1 s after the last line)
+//
+// Times are t=<n>s / t=<n>ms (plain t=<n> is seconds) from the start of
+// the scenario, or +<n>ms / +<n>s after the line before (a line without a
+// time reuses it). The remote is modelled like the real receiver: a key
+// sent while the game is busy drawing a new round can be lost, so leave a
+// gap after a round change as a person would.
+// Every scenario runs twice from a fresh boot; both runs must push the
+// same frames, so a scenario is only as random as its seed says.
+//
+// show() is charged like a WS2812 strip on the board (hostUseWs2812Timing()
+// in HostShim.h): wire time on the virtual clock, with interrupts off, so
+// a key on air during a show() decodes as garbage and millis() falls
+// behind. Prints each check, the loop time, input-to-light latency and
+// keys lost that way per scenario, then a summary table.
+//
+// Run with:  pio run -e scenarios -t exec            (every scenarios/*.scn)
+//      or:   .pio/build/scenarios/program scenarios/round1.scn ...
+//
+// Parameter sweep: every combination of the swept values, for every
+// scenario, each run in its own forked process (so each one is a freshly
+// booted board with its own copy of the game's globals), as many at once
+// as there are cores. Results go to a CSV, one row per run: loops per
+// second, loop times, input-to-light latency, inputs the game missed and
+// keys garbled by show().
+//
+//   program --sweep flicker_min_ms=100,300,500 --sweep loop_delay_ms=0..20/5
+//           [--sweep ball_width_ms=10,20,40] [--jobs N] [--csv sweep.csv] [files]
+//
+// --record <dir> writes every frame of each scenario (first run) with its
+// inputs and checks to <dir>/<name>.hrec, for src/view_recording.cpp.
+//
+// A swept name is any parameter from params.h (set over the console right
+// after boot, like typing it) or ball_width_ms, the width of balls on beam
+// lines that don't give one. Values are a list or lo..hi/step.
+//
+// Fuzzing: random remote keys (mostly Round 2's arm and select keys, with
+// mode changes mixed in) and balls, one sequence per seed, each checked for
+//   - a frame (a loop() that enters no mode) longer than --frame-budget ms
+//     or with more than --frame-shows show() calls
+//   - a loop() that enters a mode longer than --entry-budget ms or with
+//     more than --entry-shows show() calls
+// The defaults come from what the game is meant to cost (see FuzzBudget).
+//   - stray flicker: a Round 2 quadrant (or anything in MODE_OFF) that keeps
+//     toggling on and off with no flicker effect running on it
+// A failing sequence is cut down to the fewest inputs that still fail the
+// same way and written to <dir>/fuzz_<seed>.scn, a scenario that fails
+// here until the game is fixed. The worst loop time and show() count seen
+// are printed with the seed that produced them.
+//
+//   program --fuzz 500 [--fuzz-seed 1] [--fuzz-inputs 40] [--fuzz-out fuzz]
+//           [--frame-budget 155] [--frame-shows 4] [--entry-budget 1338]
+//           [--entry-shows 16]
+#include <HostShim.h>
+#include <Adafruit_NeoPixel.h>
+#include <algorithm>
+#include <chrono>
+#include <dirent.h>
+#include <fstream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+#include "modestate.h"
+#include "remote_codes.h"
+#include "telemetry_decode.h"
+
+// --- From the game (src/main.cpp and the headers it pulls in) ---
+void setup();
+void loop();
+extern Adafruit_NeoPixel strips[NUM_STRIPS_CONNECTED];
+uint16_t xyToIndex(uint8_t x, uint8_t y);
+void rngSeed(uint32_t seed);
+
+// Remote buttons by name (codes from remote_codes.h)
+struct KeyName {
+  const char* name;
+  uint32_t code;
+};
+const KeyName KEYS[] = {
+  {"CH-", CODE_CH_MINUS}, {"CH+", CODE_CH_PLUS}, {"0", CODE_0},       {"1", CODE_1},
+  {"2", CODE_2},         {"3", CODE_3},        {"4", CODE_4},       {"5", CODE_5},
+  {"7", CODE_7},         {"8", CODE_8},        {"9", CODE_9},       {"PREV", CODE_PREV},
+  {"NEXT", CODE_NEXT},   {"PAUSE", CODE_PAUSE}, {"LOSE", CODE_LOSE}, {"WIN", CODE_WIN},
+};
+
+// Remote buttons on one line are pressed this far apart: the settle delay
+// plus a little, like a person pressing them in turn
+const unsigned long KEY_GAP_US = 400000;
+const unsigned long BALL_WIDTH_US = 40000;
+const float DEFAULT_BALL_HZ = 5;
+// The shim's clock only moves for delay(), show() and the UART. A loop with
+// none of them (loop_delay_ms 0 and nothing to draw) still takes the real
+// CPU this long, roughly what bench_profile measures for an idle loop.
+const unsigned long IDLE_LOOP_US = 100;
+// Run on after the last line unless the scenario says "end"
+const double DEFAULT_TAIL_MS = 1000;
+
+// --- SCENARIO FILES ---
+struct Step {
+  double atMs;
+  int line;
+  std::vector<std::string> words; // command and its arguments
+};
+
+struct Scenario {
+  std::string name;
+  uint32_t seed = 1;
+  double endMs = -1;
+  std::vector<Step> steps;
+};
+
+bool parseDuration(const std::string& s, double& ms) {
+  char* end = nullptr;
+  double v = strtod(s.c_str(), &end);
+  if (end == s.c_str()) return false;
+  std::string unit = end;
+  if (unit == "ms") ms = v;
+  else if (unit == "s" || unit.empty()) ms = v * 1000; // plain numbers are seconds
+  else return false;
+  return true;
+}
+
+bool loadScenario(const std::string& path, Scenario& sc, std::string& error) {
+  std::ifstream in(path);
+  if (!in) { error = "can't open " + path; return false; }
+  size_t slash = path.find_last_of('/');
+  sc.name = path.substr(slash == std::string::npos ? 0 : slash + 1);
+  if (sc.name.size() > 4 && sc.name.substr(sc.name.size() - 4) == ".scn") sc.name.resize(sc.name.size() - 4);
+
+  std::string text;
+  double at = 0;
+  for (int line = 1; std::getline(in, text); line++) {
+    size_t hash = text.find('#');
+    if (hash != std::string::npos) text.resize(hash);
+    std::istringstream ws(text);
+    std::vector<std::string> words;
+    for (std::string w; ws >> w;) words.push_back(w);
+    if (words.empty()) continue;
+
+    // Optional time first
+    double ms;
+    if (words[0].compare(0, 2, "t=") == 0 || words[0][0] == '+') {
+      bool relative = words[0][0] == '+';
+      if (!parseDuration(words[0].substr(relative ? 1 : 2), ms)) {
+        error = path + ":" + std::to_string(line) + ": bad time '" + words[0] + "'";
+        return false;
+      }
+      at = relative ? at + ms : ms;
+      words.erase(words.begin());
+      if (words.empty()) continue;
+    }
+
+    if (words[0] == "seed" && words.size() == 2) {
+      sc.seed = (uint32_t)strtoul(words[1].c_str(), nullptr, 0);
+    } else if (words[0] == "end") {
+      sc.endMs = at;
+    } else if (words[0] == "key" || words[0] == "beam" || words[0] == "type" || words[0] == "expect") {
+      sc.steps.push_back({at, line, words});
+    } else {
+      error = path + ":" + std::to_string(line) + ": unknown command '" + words[0] + "'";
+      return false;
+    }
+  }
+  // Keep file order for lines with the same time
+  std::stable_sort(sc.steps.begin(), sc.steps.end(),
+                   [](const Step& a, const Step& b) { return a.atMs < b.atMs; });
+  if (sc.endMs < 0) sc.endMs = (sc.steps.empty() ? 0 : sc.steps.back().atMs) + DEFAULT_TAIL_MS;
+  return true;
+}
+
+// --- INPUTS ---
+struct Ball {
+  uint8_t pin;
+  unsigned long startUs, endUs;
+};
+std::vector<Ball> balls;
+
+int beamPin(uint8_t pin, unsigned long nowUs) {
+  for (const Ball& b : balls) {
+    if (b.pin == pin && nowUs >= b.startUs && nowUs < b.endUs) return HIGH;
+  }
+  return LOW;
+}
+
+bool findKey(const std::string& name, uint32_t& code) {
+  for (const KeyName& k : KEYS) {
+    if (strcasecmp(k.name, name.c_str()) == 0) { code = k.code; return true; }
+  }
+  if (name.compare(0, 2, "0x") == 0) { code = (uint32_t)strtoul(name.c_str(), nullptr, 16); return true; }
+  return false;
+}
+
+// --- WHAT THE GAME SENDS AND SHOWS ---
+std::string serialOut;
+void onSerialByte(uint8_t c) { serialOut += (char)c; }
+
+uint64_t frameHash = 1469598103934665603ULL; // FNV-1a over every frame pushed
+unsigned long frames = 0;
+unsigned long showsThisLoop = 0;
+
+struct LoopStats {
+  unsigned long loops = 0;
+  unsigned long minUs = ~0UL, maxUs = 0;
+  unsigned long long totalUs = 0;
+  unsigned long maxShows = 0;  // most show() calls in one loop()
+  unsigned long maxAtUs = 0;   // when the longest loop() started
+  // The same for the loops that entered no mode (see FuzzBudget)
+  unsigned long frameMaxUs = 0, frameMaxShows = 0, frameMaxAtUs = 0;
+};
+LoopStats* loopStats = nullptr; // where loop times go (none between scenarios)
+
+const char* modeName(Mode m) { return m <= MODE_FINALE ? TELEMETRY_MODE_NAMES[m] : "?"; }
+const char* effectName(uint8_t kind) { return kind < 7 ? TELEMETRY_EFFECT_NAMES[kind] : "?"; }
+
+// Stray flicker watch. A strip that shows A, B, A, B... is toggling; that
+// is only expected from a Round 2 quadrant whose effect toggles (flicker,
+// lose sequence). Elsewhere in Round 2, and in MODE_OFF, this many toggles
+// in a row means a flicker that was never stopped.
+const int STRAY_TOGGLES = 4;
+// EFFECT_FLICKER, EFFECT_FLICKER_FAST and EFFECT_LOSE (same values as effects.h)
+bool effectToggles(uint8_t kind) { return kind >= 2 && kind <= 4; }
+struct StripWatch {
+  uint64_t shown[2]; // hashes of the last two frames, newest first
+  int toggles;       // unexpected toggles in a row
+};
+StripWatch stripWatch[NUM_STRIPS_CONNECTED];
+std::string strayFlicker; // the first one seen this run, empty if none
+
+void watchStrip(uint8_t q, uint64_t h) {
+  StripWatch& w = stripWatch[q];
+  bool toggled = h == w.shown[1] && h != w.shown[0];
+  w.shown[1] = w.shown[0];
+  w.shown[0] = h;
+  bool watched = modeIsRunning(MODE_OFF) || modeIsRunning(MODE_R2);
+  bool timed = modeIsRunning(MODE_R2) && effectToggles(modeState.r2.effects[q].kind);
+  if (!toggled || !watched || timed) {
+    w.toggles = 0;
+    return;
+  }
+  if (++w.toggles == STRAY_TOGGLES && strayFlicker.empty()) {
+    char buf[96];
+    snprintf(buf, sizeof(buf), "quad %u toggling in %s with effect %s", q, modeName(activeMode),
+             modeIsRunning(MODE_R2) ? effectName(modeState.r2.effects[q].kind) : "-");
+    strayFlicker = buf;
+  }
+}
+
+void onShow(Adafruit_NeoPixel& strip, unsigned long, unsigned long) {
+  uint8_t q = (uint8_t)(&strip - strips);
+  frameHash = (frameHash ^ q) * 1099511628211ULL;
+  uint64_t stripHash = 1469598103934665603ULL;
+  const uint8_t* p = strip.getPixels();
+  for (uint16_t i = 0; i < strip.numPixels() * 3; i++) {
+    frameHash = (frameHash ^ p[i]) * 1099511628211ULL;
+    stripHash = (stripHash ^ p[i]) * 1099511628211ULL;
+  }
+  frames++;
+  showsThisLoop++;
+  if (q < NUM_STRIPS_CONNECTED) watchStrip(q, stripHash);
+}
+
+// --- CHECKS ---
+bool nameMatches(const std::string& want, const char* name) {
+  if (strcasecmp(want.c_str(), name) == 0) return true;
+  return strncasecmp(name, "MODE_", 5) == 0 && strcasecmp(want.c_str(), name + 5) == 0;
+}
+
+bool colorIs(uint32_t c, const std::string& want) {
+  uint8_t r = c >> 16, g = c >> 8, b = c;
+  uint8_t hi = std::max(r, std::max(g, b)), lo = std::min(r, std::min(g, b));
+  if (want == "off") return c == 0;
+  if (want == "on") return c != 0;
+  if (want == "white") return hi > 0 && lo >= hi / 2;
+  if (want == "red") return r > 0 && r > 2 * g && r > 2 * b;
+  if (want == "green") return g > 0 && g > 2 * r && g > 2 * b;
+  if (want == "blue") return b > 0 && b > 2 * r && b > 2 * g;
+  return false;
+}
+
+int litCount(uint8_t q) {
+  int n = 0;
+  for (uint8_t y = 0; y < QUAD_ROWS; y++) {
+    for (uint8_t x = 0; x < QUAD_COLS; x++) n += strips[q].getPixelColor(xyToIndex(x, y)) != 0;
+  }
+  return n;
+}
+
+bool compare(int got, const std::string& op, int want) {
+  if (op == "==") return got == want;
+  if (op == ">=") return got >= want;
+  if (op == "<=") return got <= want;
+  if (op == ">") return got > want;
+  if (op == "<") return got < want;
+  return false;
+}
+
+// Evaluate "expect ..." words[1..]; fills `what` with a readable result
+bool expectHolds(const std::vector<std::string>& w, std::string& what) {
+  char buf[160];
+  auto arg = [&](size_t i) { return i < w.size() ? atoi(w[i].c_str()) : -1; };
+  const std::string kind = w.size() > 1 ? w[1] : "";
+  if (kind == "mode" && w.size() == 3) {
+    snprintf(buf, sizeof(buf), "mode %s (got %s%s)", w[2].c_str(), modeName(activeMode),
+             activeModeEntered ? "" : ", not entered yet");
+    what = buf;
+    return activeModeEntered && nameMatches(w[2], modeName(activeMode));
+  }
+  if ((kind == "loop_ms" || kind == "shows_per_loop" || kind == "frame_ms" || kind == "shows_per_frame") &&
+      w.size() == 4 && loopStats) {
+    bool frame = kind == "frame_ms" || kind == "shows_per_frame";
+    unsigned long us = frame ? loopStats->frameMaxUs : loopStats->maxUs;
+    unsigned long shows = frame ? loopStats->frameMaxShows : loopStats->maxShows;
+    bool ms = kind == "loop_ms" || kind == "frame_ms";
+    int got = ms ? (int)((us + 999) / 1000) : (int)shows;
+    snprintf(buf, sizeof(buf), "%s %s %d (got %d)", kind.c_str(), w[2].c_str(), arg(3), got);
+    what = buf;
+    return compare(got, w[2], arg(3));
+  }
+  if (kind == "no_stray_flicker" && w.size() == 2) {
+    what = "no stray flicker" + (strayFlicker.empty() ? std::string() : " (got " + strayFlicker + ")");
+    return strayFlicker.empty();
+  }
+  int q = arg(2);
+  if (q < 0 || q >= NUM_STRIPS_CONNECTED) {
+    what = "bad quadrant in '" + kind + "'";
+    return false;
+  }
+  if (kind == "score" && w.size() == 4) {
+    bool round1 = modeIsRunning(MODE_R1) || modeIsRunning(MODE_R4);
+    int got = round1 ? modeState.r1.rows[q] : -1;
+    snprintf(buf, sizeof(buf), "score quad %d = %d (got %d%s)", q, arg(3), got, round1 ? "" : ", not in Round 1/4");
+    what = buf;
+    return got == arg(3);
+  }
+  if (kind == "effect" && w.size() == 4) {
+    bool round2 = modeIsRunning(MODE_R2);
+    uint8_t got = round2 ? modeState.r2.effects[q].kind : 0;
+    const char* gotName = effectName(got);
+    snprintf(buf, sizeof(buf), "effect quad %d %s (got %s%s)", q, w[3].c_str(), gotName, round2 ? "" : ", not in Round 2");
+    what = buf;
+    return round2 && nameMatches(w[3], gotName);
+  }
+  if (kind == "lit" && w.size() == 5) {
+    int got = litCount(q);
+    snprintf(buf, sizeof(buf), "lit quad %d %s %d (got %d)", q, w[3].c_str(), arg(4), got);
+    what = buf;
+    return compare(got, w[3], arg(4));
+  }
+  if (kind == "pixel" && w.size() == 6) {
+    int x = arg(3), y = arg(4);
+    if (x < 0 || x >= QUAD_COLS || y < 0 || y >= QUAD_ROWS) { what = "pixel outside the quadrant"; return false; }
+    uint32_t c = strips[q].getPixelColor(xyToIndex(x, y));
+    snprintf(buf, sizeof(buf), "pixel quad %d (%d,%d) %s (got #%06X)", q, x, y, w[5].c_str(), (unsigned)c);
+    what = buf;
+    return colorIs(c, w[5]);
+  }
+  what = "don't know how to check '" + kind + "'";
+  return false;
+}
+
+// --- RUNNING ---
+struct Result {
+  std::string name;
+  int passed = 0, failed = 0;
+  LoopStats loop;
+  double simulatedMs = 0, wallMs = 0;
+  unsigned long balls = 0, keys = 0; // inputs sent
+  unsigned long beamN = 0, irN = 0;     // inputs the game traced
+  unsigned long beamTimeouts = 0, irTimeouts = 0;
+  unsigned long garbledKeys = 0;        // keys on air during a show()
+  unsigned long irqOffUs = 0, ticksLost = 0;
+  float beamAvg = 0, beamMax = 0, irAvg = 0, irMax = 0;
+  uint64_t hash = 0;
+  unsigned long frames = 0;
+  bool repeatable = true;
+  double worstLoopAtMs = 0;  // when the longest loop() started
+  double worstFrameAtMs = 0; // ... and the longest frame
+  std::string strayFlicker;  // see watchStrip()
+};
+
+void loopOnce() {
+  unsigned long t0 = hostNowUs();
+  showsThisLoop = 0;
+  Mode modeBefore = activeMode;
+  bool enteredBefore = activeModeEntered;
+  loop();
+  if (hostNowUs() == t0) hostAdvanceUs(IDLE_LOOP_US);
+  if (!loopStats) return;
+  unsigned long us = hostNowUs() - t0;
+  LoopStats& st = *loopStats;
+  st.loops++;
+  st.totalUs += us;
+  if (us < st.minUs) st.minUs = us;
+  if (us > st.maxUs) {
+    st.maxUs = us;
+    st.maxAtUs = t0;
+  }
+  if (showsThisLoop > st.maxShows) st.maxShows = showsThisLoop;
+  if (activeModeEntered && (!enteredBefore || activeMode != modeBefore)) return; // this loop entered a mode
+  if (us > st.frameMaxUs) {
+    st.frameMaxUs = us;
+    st.frameMaxAtUs = t0;
+  }
+  if (showsThisLoop > st.frameMaxShows) st.frameMaxShows = showsThisLoop;
+}
+
+void runUntilUs(unsigned long us) {
+  while (hostNowUs() < us) loopOnce();
+}
+
+// Power-cycle the board with a blank data flash, so nothing resumes. The
+// clock starts from 0 again too: where millis() ticks fall relative to the
+// show()s moves the loop timing a little, and the particles (which move
+// once per loop) would make that a different run.
+void freshBoot(uint32_t seed) {
+  hostResetClock();
+  hostFlashWipe();
+  memset(&modeState, 0, sizeof(modeState));
+  currentMode = MODE_OFF;
+  activeMode = MODE_OFF;
+  activeModeEntered = true;
+  for (int q = 0; q < NUM_STRIPS_CONNECTED; q++) strips[q].clear();
+  balls.clear();
+  setup();
+  rngSeed(seed);
+}
+
+// "<input> n=N timeouts=T total ms: min A avg B max C" from the "lat" report
+void latencyTotals(const char* input, unsigned long& n, unsigned long& timeouts, float& avgMs, float& maxMs) {
+  std::string key = std::string(input) + " n=";
+  size_t at = serialOut.rfind(key);
+  n = 0;
+  if (at == std::string::npos) return;
+  float minMs;
+  sscanf(serialOut.c_str() + at + key.size(), "%lu timeouts=%lu total ms: min %f avg %f max %f",
+         &n, &timeouts, &minMs, &avgMs, &maxMs);
+}
+
+// One swept value for a run
+struct Setting {
+  std::string name, value;
+};
+
+// Where play() records its frames (--record), empty for none
+std::string recordPath;
+
+// One run of a scenario. Prints its checks if `verbose`.
+Result play(const Scenario& sc, bool verbose, const std::vector<Setting>& settings = {}) {
+  Result r;
+  r.name = sc.name;
+  auto wall0 = std::chrono::steady_clock::now();
+  freshBoot(sc.seed);
+  double ballWidthMs = BALL_WIDTH_US / 1000.0;
+  for (const Setting& s : settings) {
+    if (s.name == "ball_width_ms") {
+      ballWidthMs = atof(s.value.c_str());
+      continue;
+    }
+    serialOut.clear();
+    hostSerialType(("set " + s.name + " " + s.value + "\n").c_str());
+    runUntilUs(hostNowUs() + 50000);
+    if (serialOut.find(s.name + " = ") == std::string::npos) {
+      r.failed++; // unknown name or value out of range: the console said why
+      if (verbose) printf("  FAIL  set %s %s: %s", s.name.c_str(), s.value.c_str(), serialOut.c_str());
+    }
+  }
+  frameHash = 1469598103934665603ULL;
+  frames = 0;
+  memset(stripWatch, 0, sizeof(stripWatch));
+  strayFlicker.clear();
+  loopStats = &r.loop;
+  const unsigned long startUs = hostNowUs();
+  const unsigned long garbled0 = hostIrCorrupted, irqOff0 = hostIrqOffUs, ticks0 = hostTicksLost;
+  if (!recordPath.empty() && !hostRecordStart(recordPath.c_str())) {
+    r.failed++;
+    if (verbose) printf("  FAIL  can't record to %s\n", recordPath.c_str());
+  }
+
+  for (const Step& s : sc.steps) {
+    runUntilUs(startUs + (unsigned long)(s.atMs * 1000));
+    const std::vector<std::string>& w = s.words;
+    const std::string& cmd = w[0];
+    std::string problem;
+
+    if (cmd == "key") {
+      for (size_t i = 1; i < w.size(); i++) {
+        uint32_t code;
+        if (!findKey(w[i], code)) { problem = "unknown key '" + w[i] + "'"; break; }
+        hostIrSendAt(hostNowUs() + (i - 1) * KEY_GAP_US, code);
+        hostRecordEvent(hostNowUs() + (i - 1) * KEY_GAP_US, ("key " + w[i]).c_str());
+        r.keys++;
+      }
+    } else if (cmd == "beam") {
+      int beam = w.size() > 1 ? atoi(w[1].c_str()) : -1;
+      int count = 1;
+      float hz = DEFAULT_BALL_HZ;
+      double widthMs = ballWidthMs;
+      for (size_t i = 2; i + 1 < w.size(); i += 2) {
+        if (w[i] == "pulses") count = atoi(w[i + 1].c_str());
+        else if (w[i] == "hz") hz = (float)atof(w[i + 1].c_str());
+        else if (w[i] != "width" || !parseDuration(w[i + 1], widthMs)) problem = "bad beam option '" + w[i] + "'";
+      }
+      if (beam < 0 || beam >= NUM_STRIPS_CONNECTED || count < 1 || hz <= 0) problem = "bad beam line";
+      for (int i = 0; problem.empty() && i < count; i++) {
+        unsigned long t = hostNowUs() + (unsigned long)(i * 1000000.0 / hz);
+        balls.push_back({BEAM_PINS[beam], t, t + (unsigned long)(widthMs * 1000)});
+        hostRecordEvent(t, ("ball " + w[1]).c_str());
+        r.balls++;
+      }
+    } else if (cmd == "type") {
+      std::string text;
+      for (size_t i = 1; i < w.size(); i++) text += (i > 1 ? " " : "") + w[i];
+      hostSerialType((text + "\n").c_str());
+      hostRecordEvent(hostNowUs(), ("type " + text).c_str());
+    } else if (cmd == "expect") {
+      std::string what;
+      bool ok = expectHolds(w, what);
+      ok ? r.passed++ : r.failed++;
+      hostRecordEvent(hostNowUs(), ((ok ? "PASS " : "FAIL ") + what).c_str());
+      if (verbose) printf("  %s  line %d: %s\n", ok ? "PASS" : "FAIL", s.line, what.c_str());
+      continue;
+    }
+    if (!problem.empty()) {
+      r.failed++;
+      if (verbose) printf("  FAIL  line %d: %s\n", s.line, problem.c_str());
+    }
+  }
+  runUntilUs(startUs + (unsigned long)(sc.endMs * 1000));
+  hostRecordStop();
+  loopStats = nullptr;
+  r.hash = frameHash;
+  r.frames = frames;
+  r.simulatedMs = (hostNowUs() - startUs) / 1000.0;
+  r.garbledKeys = hostIrCorrupted - garbled0;
+  r.irqOffUs = hostIrqOffUs - irqOff0;
+  r.ticksLost = hostTicksLost - ticks0;
+  r.worstLoopAtMs = r.loop.loops ? (r.loop.maxAtUs - startUs) / 1000.0 : 0;
+  r.worstFrameAtMs = r.loop.frameMaxUs ? (r.loop.frameMaxAtUs - startUs) / 1000.0 : 0;
+  r.strayFlicker = strayFlicker;
+
+  // The same latency report you'd get by typing "lat" on the board
+  serialOut.clear();
+  hostSerialType("lat\n");
+  unsigned long reportEnd = hostNowUs() + 200000;
+  runUntilUs(reportEnd);
+  latencyTotals("beam", r.beamN, r.beamTimeouts, r.beamAvg, r.beamMax);
+  latencyTotals("ir", r.irN, r.irTimeouts, r.irAvg, r.irMax);
+  r.wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wall0).count();
+  return r;
+}
+
+std::vector<std::string> defaultScenarios() {
+  std::vector<std::string> paths;
+  if (DIR* dir = opendir("scenarios")) {
+    while (dirent* e = readdir(dir)) {
+      std::string n = e->d_name;
+      if (n.size() > 4 && n.substr(n.size() - 4) == ".scn") paths.push_back("scenarios/" + n);
+    }
+    closedir(dir);
+  }
+  std::sort(paths.begin(), paths.end());
+  return paths;
+}
+
+// --- SWEEPS ---
+struct Axis {
+  std::string name;
+  std::vector<std::string> values;
+};
+
+// What a forked run sends back: plain numbers, written as one struct
+struct SweepRow {
+  int passed, failed;
+  double simulatedMs;
+  unsigned long loops, minUs, maxUs, maxShows;
+  unsigned long long totalUs;
+  unsigned long frames;
+  unsigned long balls, beamN, beamTimeouts, keys, irN, irTimeouts, garbledKeys;
+  unsigned long irqOffUs, ticksLost;
+  float beamAvg, beamMax, irAvg, irMax;
+  uint64_t hash;
+};
+
+// "name=a,b,c" or "name=lo..hi/step"
+bool parseAxis(const std::string& arg, Axis& axis) {
+  size_t eq = arg.find('=');
+  if (eq == std::string::npos || eq == 0) return false;
+  axis.name = arg.substr(0, eq);
+  std::string spec = arg.substr(eq + 1);
+  long lo, hi, step = 1;
+  char tail;
+  if (sscanf(spec.c_str(), "%ld..%ld/%ld%c", &lo, &hi, &step, &tail) == 3 ||
+      sscanf(spec.c_str(), "%ld..%ld%c", &lo, &hi, &tail) == 2) {
+    if (step <= 0 || hi < lo) return false;
+    for (long v = lo; v <= hi; v += step) axis.values.push_back(std::to_string(v));
+  } else {
+    std::istringstream vs(spec);
+    for (std::string v; std::getline(vs, v, ',');) {
+      if (!v.empty()) axis.values.push_back(v);
+    }
+  }
+  return !axis.values.empty();
+}
+
+struct SweepJob {
+  size_t scenario;
+  std::vector<Setting> settings;
+};
+
+// Every combination of the axes' values, for every scenario
+std::vector<SweepJob> sweepJobs(size_t scenarios, const std::vector<Axis>& axes) {
+  std::vector<SweepJob> jobs;
+  for (size_t s = 0; s < scenarios; s++) {
+    std::vector<size_t> at(axes.size(), 0);
+    while (true) {
+      SweepJob job{s, {}};
+      for (size_t a = 0; a < axes.size(); a++) job.settings.push_back({axes[a].name, axes[a].values[at[a]]});
+      jobs.push_back(job);
+      // Like nested loops: the last axis changes fastest
+      size_t a = axes.size();
+      while (a > 0 && ++at[a - 1] == axes[a - 1].values.size()) at[--a] = 0;
+      if (a == 0) break;
+    }
+  }
+  return jobs;
+}
+
+// The child's half: play once, send the numbers back, never return
+[[noreturn]] void sweepChild(const Scenario& sc, const std::vector<Setting>& settings, int fd) {
+  Result r = play(sc, false, settings);
+  SweepRow row = {r.passed, r.failed, r.simulatedMs, r.loop.loops, r.loop.minUs, r.loop.maxUs,
+                  r.loop.maxShows, r.loop.totalUs, r.frames, r.balls, r.beamN, r.beamTimeouts, r.keys, r.irN,
+                  r.irTimeouts, r.garbledKeys, r.irqOffUs, r.ticksLost, r.beamAvg, r.beamMax, r.irAvg, r.irMax, r.hash};
+  bool sent = write(fd, &row, sizeof(row)) == (ssize_t)sizeof(row);
+  _exit(sent ? 0 : 1);
+}
+
+void sweepCsvRow(FILE* csv, const Scenario& sc, const SweepJob& job, const SweepRow* row) {
+  fprintf(csv, "%s,%u", sc.name.c_str(), (unsigned)sc.seed);
+  for (const Setting& s : job.settings) fprintf(csv, ",%s", s.value.c_str());
+  if (!row) {
+    fprintf(csv, "%s,crashed\n", std::string(25, ',').c_str());
+    return;
+  }
+  double seconds = row->simulatedMs / 1000;
+  fprintf(csv, ",%d,%d,%.2f,%lu,%.1f,%.2f,%.2f,%lu,%lu,%lu,%lu,%lu,%ld,%.1f,%.1f,%lu,%lu,%lu,%ld,%lu,%.1f,%.1f,"
+               "%.1f,%lu,%016llx,%s\n",
+          row->passed, row->failed, seconds, row->loops, seconds > 0 ? row->loops / seconds : 0.0,
+          row->loops ? row->totalUs / 1000.0 / row->loops : 0.0, row->maxUs / 1000.0, row->maxShows, row->frames,
+          row->balls, row->beamN, row->beamTimeouts, (long)row->balls - (long)row->beamN,
+          row->beamAvg, row->beamMax, row->keys, row->irN, row->irTimeouts,
+          (long)row->keys - (long)row->irN, row->garbledKeys, row->irAvg, row->irMax,
+          seconds > 0 ? row->irqOffUs / 10000.0 / seconds : 0.0, row->ticksLost, (unsigned long long)row->hash,
+          row->failed ? "fail" : "ok");
+}
+
+// Runs every job in its own process, `parallel` at a time, and writes the CSV.
+// Returns the number of runs that didn't finish (crashed).
+int runSweep(const std::vector<Scenario>& scenarios, const std::vector<Axis>& axes, unsigned parallel,
+             const std::string& csvPath) {
+  std::vector<SweepJob> jobs = sweepJobs(scenarios.size(), axes);
+  FILE* csv = fopen(csvPath.c_str(), "w");
+  if (!csv) {
+    printf("Can't write %s\n", csvPath.c_str());
+    return 1;
+  }
+  fprintf(csv, "scenario,seed");
+  for (const Axis& a : axes) fprintf(csv, ",%s", a.name.c_str());
+  fprintf(csv, ",checks_passed,checks_failed,sim_s,loops,fps,avg_loop_ms,max_loop_ms,max_shows,frames,"
+               "balls,beam_n,beam_timeouts,missed_balls,beam_avg_ms,beam_max_ms,"
+               "keys,ir_n,ir_timeouts,missed_keys,garbled_keys,ir_avg_ms,ir_max_ms,"
+               "irq_off_pct,ticks_lost,hash,result\n");
+
+  printf("\n--- SWEEP ---\n%zu runs (%zu scenarios x %zu settings) on %u cores\n", jobs.size(),
+         scenarios.size(), jobs.size() / scenarios.size(), parallel);
+  auto wall0 = std::chrono::steady_clock::now();
+
+  // Rows are kept in job order, whichever child finishes first
+  std::vector<SweepRow> rows(jobs.size());
+  std::vector<bool> done(jobs.size(), false);
+  std::map<pid_t, std::pair<size_t, int>> running; // pid -> job, read end of its pipe
+  size_t next = 0;
+  int crashed = 0, failedRuns = 0;
+  while (next < jobs.size() || !running.empty()) {
+    while (next < jobs.size() && running.size() < parallel) {
+      int fds[2];
+      if (pipe(fds) != 0) break;
+      fflush(stdout); // or the child would print our buffer again
+      pid_t pid = fork();
+      if (pid == 0) {
+        close(fds[0]);
+        sweepChild(scenarios[jobs[next].scenario], jobs[next].settings, fds[1]);
+      }
+      close(fds[1]);
+      if (pid < 0) {
+        close(fds[0]);
+        break;
+      }
+      running[pid] = {next++, fds[0]};
+    }
+    if (running.empty()) {
+      printf("Can't start a run\n");
+      fclose(csv);
+      return 1;
+    }
+
+    int status;
+    pid_t pid = waitpid(-1, &status, 0);
+    auto it = running.find(pid);
+    if (it == running.end()) continue;
+    size_t j = it->second.first;
+    int fd = it->second.second;
+    running.erase(it);
+    done[j] = WIFEXITED(status) && WEXITSTATUS(status) == 0 &&
+              read(fd, &rows[j], sizeof(SweepRow)) == (ssize_t)sizeof(SweepRow);
+    close(fd);
+    if (!done[j]) crashed++;
+    else if (rows[j].failed) failedRuns++;
+  }
+
+  for (size_t j = 0; j < jobs.size(); j++) {
+    sweepCsvRow(csv, scenarios[jobs[j].scenario], jobs[j], done[j] ? &rows[j] : nullptr);
+  }
+  fclose(csv);
+  double wallS = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall0).count();
+  printf("%zu runs in %.1f s: %d with failed checks, %d crashed\nWrote %s\n", jobs.size(), wallS,
+         failedRuns, crashed, csvPath.c_str());
+  return crashed;
+}
+
+// --- FUZZING ---
+// The budgets come from what a loop() is meant to cost on the wall, with
+// show() at WS2812 speed (FUZZ_SHOW_MS per strip):
+//   - a frame, any loop() that enters no mode, may settle one remote key
+//     (readRemote()'s delay(100)), show every strip once and run the
+//     loop delay
+//   - entering a mode is exempt from that: it draws whole scenes and
+//     blocks on purpose. round2Enter() is the costliest entry and sets the
+//     entry budget: the blue flash (a show per strip), delay(1000),
+//     ledsAllOff()'s two clearing passes with delay(50) between, then the
+//     bears. That is four shows per strip and 1050 ms of delay() on top of
+//     a frame's key and loop delay.
+// Anything over either budget is a regression, not noise: the host clock is
+// virtual, so the same sequence always costs the same.
+struct FuzzBudget {
+  unsigned long frameMs;     // longest frame allowed
+  unsigned long frameShows;  // most show() calls in one frame
+  unsigned long entryMs;     // longest loop() that enters a mode
+  unsigned long entryShows;  // most show() calls in it
+};
+
+const double FUZZ_SHOW_MS = (LEDS_PER_QUAD * HOST_WS2812_US_PER_LED + HOST_WS2812_LATCH_US) / 1000.0;
+const double FUZZ_KEY_SETTLE_MS = 100; // readRemote()
+const double FUZZ_LOOP_DELAY_MS = 10;  // loop_delay_ms default in params.h
+const double FUZZ_ROUND2_ENTER_DELAY_MS = 1000 + 50;
+const unsigned long FUZZ_ENTRY_SHOWS = 4 * NUM_STRIPS_CONNECTED;
+
+FuzzBudget fuzzDefaultBudget() {
+  double frameMs = FUZZ_KEY_SETTLE_MS + NUM_STRIPS_CONNECTED * FUZZ_SHOW_MS + FUZZ_LOOP_DELAY_MS;
+  double entryMs = FUZZ_KEY_SETTLE_MS + FUZZ_ENTRY_SHOWS * FUZZ_SHOW_MS + FUZZ_ROUND2_ENTER_DELAY_MS +
+                   FUZZ_LOOP_DELAY_MS;
+  return {(unsigned long)ceil(frameMs), NUM_STRIPS_CONNECTED, (unsigned long)ceil(entryMs), FUZZ_ENTRY_SHOWS};
+}
+
+// Run on after a fuzzed sequence's last input, long enough for a mode
+// change to draw and a flicker to show itself
+const double FUZZ_TAIL_MS = 3000;
+
+const char* const FUZZ_ROUND2_KEYS[] = {"7", "8", "9", "PREV", "NEXT", "PAUSE", "LOSE", "2"};
+const char* const FUZZ_MODE_KEYS[] = {"CH-", "CH+", "0", "1", "2", "3", "4", "5", "WIN"};
+
+// One random sequence: Round 2 first, then mostly its arm and select keys,
+// some mode changes and balls. Gaps range from a fast double press to a
+// couple of seconds.
+Scenario fuzzScenario(uint32_t seed, int inputs) {
+  std::mt19937 rnd(seed);
+  auto below = [&](unsigned n) { return (unsigned)(rnd() % n); };
+  Scenario sc;
+  sc.name = "fuzz_" + std::to_string(seed);
+  sc.seed = seed;
+  double at = 0;
+  sc.steps.push_back({at, 1, {"key", "2"}});
+  for (int i = 0; i < inputs; i++) {
+    unsigned gap = below(10);
+    at += gap < 1 ? 50 + below(100) : gap < 7 ? 150 + below(600) : 750 + below(1500);
+    unsigned what = below(10);
+    std::vector<std::string> words;
+    if (what < 6) {
+      words = {"key", FUZZ_ROUND2_KEYS[below(8)]};
+    } else if (what < 8) {
+      words = {"key", FUZZ_MODE_KEYS[below(9)]};
+    } else {
+      words = {"beam", std::to_string(below(NUM_STRIPS_CONNECTED)), "pulses", std::to_string(1 + below(6)),
+               "hz", std::to_string(1 + below(12))};
+    }
+    sc.steps.push_back({at, i + 2, words});
+  }
+  sc.endMs = at + FUZZ_TAIL_MS;
+  return sc;
+}
+
+enum FuzzFailure {
+  FUZZ_OK,
+  FUZZ_STRAY_FLICKER,
+  FUZZ_SLOW_ENTRY,
+  FUZZ_ENTRY_SHOWS_OVER,
+  FUZZ_SLOW_FRAME,
+  FUZZ_FRAME_SHOWS_OVER
+};
+
+// What went wrong in a run, worst first; fills `what` with the details
+FuzzFailure fuzzFailure(const Result& r, const FuzzBudget& budget, std::string& what) {
+  char buf[160];
+  if (!r.strayFlicker.empty()) {
+    what = "stray flicker: " + r.strayFlicker;
+    return FUZZ_STRAY_FLICKER;
+  }
+  // Every loop, entries included, against the entry budget
+  if (r.loop.maxUs > budget.entryMs * 1000) {
+    snprintf(buf, sizeof(buf), "loop() took %.1f ms at t=%.1fs (entry budget %lu ms)", r.loop.maxUs / 1000.0,
+             r.worstLoopAtMs / 1000, budget.entryMs);
+    what = buf;
+    return FUZZ_SLOW_ENTRY;
+  }
+  if (r.loop.maxShows > budget.entryShows) {
+    snprintf(buf, sizeof(buf), "%lu show() calls in one loop() (entry budget %lu)", r.loop.maxShows,
+             budget.entryShows);
+    what = buf;
+    return FUZZ_ENTRY_SHOWS_OVER;
+  }
+  if (r.loop.frameMaxUs > budget.frameMs * 1000) {
+    snprintf(buf, sizeof(buf), "frame took %.1f ms at t=%.1fs (budget %lu ms)", r.loop.frameMaxUs / 1000.0,
+             r.worstFrameAtMs / 1000, budget.frameMs);
+    what = buf;
+    return FUZZ_SLOW_FRAME;
+  }
+  if (r.loop.frameMaxShows > budget.frameShows) {
+    snprintf(buf, sizeof(buf), "%lu show() calls in one frame (budget %lu)", r.loop.frameMaxShows,
+             budget.frameShows);
+    what = buf;
+    return FUZZ_FRAME_SHOWS_OVER;
+  }
+  what.clear();
+  return FUZZ_OK;
+}
+
+// The check that fails while the problem is there, for the scenario file
+std::vector<std::string> fuzzCheck(FuzzFailure kind, const FuzzBudget& budget) {
+  switch (kind) {
+    case FUZZ_SLOW_ENTRY: return {"expect", "loop_ms", "<=", std::to_string(budget.entryMs)};
+    case FUZZ_ENTRY_SHOWS_OVER: return {"expect", "shows_per_loop", "<=", std::to_string(budget.entryShows)};
+    case FUZZ_SLOW_FRAME: return {"expect", "frame_ms", "<=", std::to_string(budget.frameMs)};
+    case FUZZ_FRAME_SHOWS_OVER: return {"expect", "shows_per_frame", "<=", std::to_string(budget.frameShows)};
+    default: return {"expect", "no_stray_flicker"};
+  }
+}
+
+// Inputs removed in ever smaller chunks, keeping every cut after which the
+// sequence still fails the same way. Ends when no single input can go.
+Scenario fuzzMinimise(const Scenario& sc, FuzzFailure kind, const FuzzBudget& budget) {
+  Scenario best = sc;
+  auto stillFails = [&](const Scenario& t) {
+    std::string what;
+    return fuzzFailure(play(t, false), budget, what) == kind;
+  };
+  for (size_t chunk = std::max<size_t>(1, best.steps.size() / 2); chunk > 0; chunk /= 2) {
+    for (size_t at = 0; at < best.steps.size();) {
+      Scenario fewer = best;
+      fewer.steps.erase(fewer.steps.begin() + at,
+                        fewer.steps.begin() + std::min(best.steps.size(), at + chunk));
+      fewer.endMs = (fewer.steps.empty() ? 0 : fewer.steps.back().atMs) + FUZZ_TAIL_MS;
+      if (stillFails(fewer)) best = fewer;
+      else at += chunk;
+    }
+  }
+  // Start with the first input if the quiet time before it doesn't matter
+  if (!best.steps.empty() && best.steps[0].atMs > 0) {
+    Scenario sooner = best;
+    double by = sooner.steps[0].atMs;
+    for (Step& s : sooner.steps) s.atMs -= by;
+    sooner.endMs -= by;
+    if (stillFails(sooner)) best = sooner;
+  }
+  return best;
+}
+
+// Write a cut-down sequence as a scenario that fails while the problem is there
+bool fuzzSave(const std::string& path, const Scenario& sc, size_t fromInputs, const std::string& what,
+              const std::vector<std::string>& check) {
+  FILE* f = fopen(path.c_str(), "w");
+  if (!f) return false;
+  fprintf(f, "# Found by run_scenarios --fuzz (seed %u), cut from %zu inputs to %zu\n", (unsigned)sc.seed,
+          fromInputs, sc.steps.size());
+  fprintf(f, "# %s\n", what.c_str());
+  fprintf(f, "seed %u\n", (unsigned)sc.seed);
+  for (const Step& s : sc.steps) {
+    fprintf(f, "t=%.0fms ", s.atMs);
+    for (size_t i = 0; i < s.words.size(); i++) fprintf(f, "%s%s", i ? " " : "", s.words[i].c_str());
+    fprintf(f, "\n");
+  }
+  fprintf(f, "t=%.0fms ", sc.endMs);
+  for (size_t i = 0; i < check.size(); i++) fprintf(f, "%s%s", i ? " " : "", check[i].c_str());
+  fprintf(f, "\n");
+  return fclose(f) == 0;
+}
+
+// Plays `count` random sequences; returns how many failed
+int runFuzz(uint32_t firstSeed, int count, int inputs, const FuzzBudget& budget, const std::string& outDir) {
+  printf("\n--- FUZZ ---\n%d sequences of %d inputs from seed %u (budgets: frame %lu ms and %lu show(), "
+         "mode entry %lu ms and %lu show())\n",
+         count, inputs, (unsigned)firstSeed, budget.frameMs, budget.frameShows, budget.entryMs, budget.entryShows);
+  auto wall0 = std::chrono::steady_clock::now();
+  mkdir(outDir.c_str(), 0755); // fine if it's already there
+  std::map<FuzzFailure, std::vector<uint32_t>> failing; // kind -> seeds
+  unsigned long worstLoopUs = 0, worstShows = 0, worstFrameUs = 0, worstFrameShows = 0;
+  uint32_t worstLoopSeed = 0, worstShowsSeed = 0, worstFrameSeed = 0, worstFrameShowsSeed = 0;
+  double worstLoopAtMs = 0, worstFrameAtMs = 0;
+  for (int n = 0; n < count; n++) {
+    uint32_t seed = firstSeed + n;
+    Scenario sc = fuzzScenario(seed, inputs);
+    Result r = play(sc, false);
+    if (r.loop.maxUs > worstLoopUs) {
+      worstLoopUs = r.loop.maxUs;
+      worstLoopSeed = seed;
+      worstLoopAtMs = r.worstLoopAtMs;
+    }
+    if (r.loop.maxShows > worstShows) {
+      worstShows = r.loop.maxShows;
+      worstShowsSeed = seed;
+    }
+    if (r.loop.frameMaxUs > worstFrameUs) {
+      worstFrameUs = r.loop.frameMaxUs;
+      worstFrameSeed = seed;
+      worstFrameAtMs = r.worstFrameAtMs;
+    }
+    if (r.loop.frameMaxShows > worstFrameShows) {
+      worstFrameShows = r.loop.frameMaxShows;
+      worstFrameShowsSeed = seed;
+    }
+    std::string what;
+    FuzzFailure kind = fuzzFailure(r, budget, what);
+    if (kind == FUZZ_OK) continue;
+    failing[kind].push_back(seed);
+    if (failing[kind].size() > 1) continue; // cut down the first of each kind only
+
+    printf("  seed %u: %s\n", (unsigned)seed, what.c_str());
+    Scenario small = fuzzMinimise(sc, kind, budget);
+    std::string smallWhat;
+    fuzzFailure(play(small, false), budget, smallWhat);
+    std::string path = outDir + "/" + sc.name + ".scn";
+    if (!fuzzSave(path, small, sc.steps.size(), smallWhat, fuzzCheck(kind, budget))) {
+      printf("    can't write %s\n", path.c_str());
+      continue;
+    }
+    // Load it back the way a scenario run would, and check it still fails
+    Scenario again;
+    std::string error;
+    bool reproduces = loadScenario(path, again, error) && play(again, false).failed > 0;
+    printf("    cut to %zu inputs: %s\n    wrote %s (%s)\n", small.steps.size(), smallWhat.c_str(), path.c_str(),
+           reproduces ? "fails there too" : "DOES NOT REPRODUCE");
+  }
+
+  for (const auto& k : failing) {
+    if (k.second.size() < 2) continue;
+    printf("  %zu more sequences failed the same way as seed %u:", k.second.size() - 1, (unsigned)k.second[0]);
+    for (size_t i = 1; i < k.second.size() && i <= 10; i++) printf(" %u", (unsigned)k.second[i]);
+    printf(k.second.size() > 11 ? " ...\n" : "\n");
+  }
+  int failed = 0;
+  for (const auto& k : failing) failed += (int)k.second.size();
+  double wallS = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall0).count();
+  printf("worst frame %.1f ms (seed %u, t=%.1fs), most show() in one frame %lu (seed %u)\n",
+         worstFrameUs / 1000.0, (unsigned)worstFrameSeed, worstFrameAtMs / 1000, worstFrameShows,
+         (unsigned)worstFrameShowsSeed);
+  printf("worst loop() with mode entries %.1f ms (seed %u, t=%.1fs), most show() %lu (seed %u)\n",
+         worstLoopUs / 1000.0, (unsigned)worstLoopSeed, worstLoopAtMs / 1000, worstShows,
+         (unsigned)worstShowsSeed);
+  printf("%d sequences in %.1f s\n", count, wallS);
+  printf("\n%s (%d of %d failed)\n", failed ? "--- FUZZ FAILED ---" : "--- FUZZ PASSED ---", failed, count);
+  return failed;
+}
+
+int main(int argc, char** argv) {
+  hostUseWs2812Timing();
+  hostSerialEcho(false);
+  hostSetSerialFn(onSerialByte);
+  hostSetShowFn(onShow);
+  hostSetPinFn(beamPin);
+
+  std::vector<std::string> paths;
+  std::vector<Axis> axes;
+  unsigned parallel = std::max(1L, sysconf(_SC_NPROCESSORS_ONLN));
+  std::string csvPath = "sweep.csv";
+  std::string recordDir;
+  int fuzzCount = 0, fuzzInputs = 40;
+  uint32_t fuzzSeed = 1;
+  std::string fuzzDir = "fuzz";
+  FuzzBudget budget = fuzzDefaultBudget();
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool hasValue = i + 1 < argc;
+    if (arg == "--sweep" && hasValue) {
+      Axis axis;
+      if (!parseAxis(argv[++i], axis)) {
+        printf("Bad sweep '%s': want name=a,b,c or name=lo..hi/step\n", argv[i]);
+        return 1;
+      }
+      axes.push_back(axis);
+    } else if (arg == "--jobs" && hasValue) {
+      parallel = std::max(1, atoi(argv[++i]));
+    } else if (arg == "--csv" && hasValue) {
+      csvPath = argv[++i];
+    } else if (arg == "--fuzz" && hasValue) {
+      fuzzCount = std::max(1, atoi(argv[++i]));
+    } else if (arg == "--fuzz-seed" && hasValue) {
+      fuzzSeed = (uint32_t)strtoul(argv[++i], nullptr, 0);
+    } else if (arg == "--fuzz-inputs" && hasValue) {
+      fuzzInputs = std::max(1, atoi(argv[++i]));
+    } else if (arg == "--fuzz-out" && hasValue) {
+      fuzzDir = argv[++i];
+    } else if (arg == "--frame-budget" && hasValue) {
+      budget.frameMs = strtoul(argv[++i], nullptr, 0);
+    } else if (arg == "--frame-shows" && hasValue) {
+      budget.frameShows = strtoul(argv[++i], nullptr, 0);
+    } else if (arg == "--entry-budget" && hasValue) {
+      budget.entryMs = strtoul(argv[++i], nullptr, 0);
+    } else if (arg == "--entry-shows" && hasValue) {
+      budget.entryShows = strtoul(argv[++i], nullptr, 0);
+    } else if (arg == "--record" && hasValue) {
+      recordDir = argv[++i];
+      mkdir(recordDir.c_str(), 0755); // fine if it's already there
+    } else if (arg.compare(0, 2, "--") == 0) {
+      printf("Unknown option %s\n", arg.c_str());
+      return 1;
+    } else {
+      paths.push_back(arg);
+    }
+  }
+  if (fuzzCount) return runFuzz(fuzzSeed, fuzzCount, fuzzInputs, budget, fuzzDir) ? 1 : 0;
+  if (paths.empty()) paths = defaultScenarios();
+  if (paths.empty()) {
+    printf("No scenarios given and none found in scenarios/\n");
+    return 1;
+  }
+
+  if (!axes.empty()) {
+    std::vector<Scenario> scenarios;
+    for (const std::string& path : paths) {
+      Scenario sc;
+      std::string error;
+      if (!loadScenario(path, sc, error)) {
+        printf("%s\n", error.c_str());
+        return 1;
+      }
+      scenarios.push_back(sc);
+    }
+    return runSweep(scenarios, axes, parallel, csvPath) ? 1 : 0;
+  }
+
+  printf("\n--- SCENARIOS ---\n");
+  std::vector<Result> results;
+  int failedScenarios = 0;
+  for (const std::string& path : paths) {
+    Scenario sc;
+    std::string error;
+    if (!loadScenario(path, sc, error)) {
+      printf("\n%s\n", error.c_str());
+      Result r;
+      r.name = sc.name.empty() ? path : sc.name;
+      r.failed = 1;
+      results.push_back(r);
+      failedScenarios++;
+      continue;
+    }
+    printf("\n[%s] seed %u, %.1f s\n", sc.name.c_str(), (unsigned)sc.seed, sc.endMs / 1000);
+    if (!recordDir.empty()) recordPath = recordDir + "/" + sc.name + ".hrec";
+    Result r = play(sc, true);
+    recordPath.clear();
+    Result again = play(sc, false);
+    r.repeatable = again.hash == r.hash && again.frames == r.frames;
+
+    const LoopStats& L = r.loop;
+    printf("  loops %lu, loop ms min %.1f avg %.1f max %.1f, up to %lu show() per loop\n", L.loops,
+           L.minUs / 1000.0, L.loops ? L.totalUs / 1000.0 / L.loops : 0.0, L.maxUs / 1000.0, L.maxShows);
+    printf("  latency ms: beam n=%lu avg %.1f max %.1f, ir n=%lu avg %.1f max %.1f\n",
+           r.beamN, r.beamAvg, r.beamMax, r.irN, r.irAvg, r.irMax);
+    printf("  interrupts off %.1f%% of the time: %lu of %lu keys garbled, millis() lost %lu ms\n",
+           r.simulatedMs > 0 ? r.irqOffUs / 10.0 / r.simulatedMs : 0.0, r.garbledKeys, r.keys, r.ticksLost);
+    printf("  %lu frames, hash %016llx, second run %s\n", r.frames, (unsigned long long)r.hash,
+           r.repeatable ? "identical" : "DIFFERENT");
+    printf("  %.1f s simulated in %.0f ms (%.0fx real time)\n", r.simulatedMs / 1000, r.wallMs,
+           r.simulatedMs / std::max(r.wallMs, 0.001));
+    if (!recordDir.empty()) printf("  frames recorded to %s/%s.hrec\n", recordDir.c_str(), sc.name.c_str());
+    if (!r.repeatable) r.failed++;
+    if (r.failed) failedScenarios++;
+    results.push_back(r);
+  }
+
+  printf("\nscenario               checks  loops  avg ms  max ms  beam max  ir max  result\n");
+  for (const Result& r : results) {
+    const LoopStats& L = r.loop;
+    printf("%-22s %3d/%-3d %6lu %7.1f %7.1f %9.1f %7.1f  %s\n", r.name.c_str(), r.passed, r.passed + r.failed,
+           L.loops, L.loops ? L.totalUs / 1000.0 / L.loops : 0.0, L.maxUs / 1000.0, r.beamMax, r.irMax,
+           r.failed ? "FAIL" : "ok");
+  }
+  printf("\n%s (%d of %zu failed)\n", failedScenarios ? "--- SCENARIOS FAILED ---" : "--- SCENARIOS PASSED ---",
+         failedScenarios, results.size());
+  return failedScenarios ? 1 : 0;
+}
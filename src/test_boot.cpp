@@ -0,0 +1,111 @@
+// --- HEADLESS BOOT TEST (host only) ---
+// Runs the real game's setup() (src/main.cpp is built into this
+// environment too) with show() charged at WS2812 wire speed and the UART
+// at its real baud rate, three ways:
+//   - no Serial Monitor at all: setup() still finishes within the boot
+//     budget and the remote works straight away
+//   - a monitor opened later: the boot report shows up then, once
+//   - a monitor already open: no grace period is spent waiting
+// Also checks that each strip is cleared with a single show().
+//
+// Run with:  pio run -e test_boot -t exec
+// Prints PASS/FAIL per check and exits non-zero if anything failed.
+#include <HostTest.h>
+#include <Adafruit_NeoPixel.h>
+#include <string>
+#include "modestate.h"
+
+// --- From the game (src/main.cpp and the headers it pulls in) ---
+extern Adafruit_NeoPixel strips[NUM_STRIPS_CONNECTED];
+
+// Same values as boot.h
+const unsigned long BOOT_SERIAL_WAIT_MS = 300;
+const unsigned long BOOT_BUDGET_MS = 500;
+
+// Same as test_journal: the data flash is slow to write, not to read
+const unsigned long FLASH_WRITE_US_PER_BYTE = 50;
+const unsigned long FLASH_ERASE_US_PER_BLOCK = 10000;
+
+std::string serialOut;
+void onSerialByte(uint8_t c) { serialOut += (char)c; }
+
+size_t countOf(const char* text) {
+  size_t n = 0;
+  for (size_t at = serialOut.find(text); at != std::string::npos; at = serialOut.find(text, at + 1)) n++;
+  return n;
+}
+
+// Reset the board with the Serial Monitor opening `monitorMs` after it
+// (-1: never). Returns how long setup() took.
+unsigned long reboot(long monitorMs) {
+  memset(&modeState, 0, sizeof(modeState));
+  currentMode = MODE_OFF;
+  activeMode = MODE_OFF;
+  activeModeEntered = true;
+  for (int q = 0; q < NUM_STRIPS_CONNECTED; q++) strips[q].clear();
+  hostSerialConnectAt(monitorMs < 0 ? (unsigned long)-1 : hostNowUs() + monitorMs * 1000UL);
+  serialOut.clear();
+
+  unsigned long t0 = hostNowUs();
+  setup();
+  return (hostNowUs() - t0) / 1000;
+}
+
+// The report's own number: "Boot: MODE_OFF after 52.3 ms"
+float reportedMs() {
+  size_t at = serialOut.find("Boot: MODE_OFF after ");
+  return at == std::string::npos ? -1 : strtof(serialOut.c_str() + at + 21, nullptr);
+}
+
+int main() {
+  hostCosts.showUsPerLed = 30;
+  hostCosts.showLatchUs = 300;
+  hostCosts.serialAtBaud = true;
+  hostCosts.serialFifoBytes = 64;
+  hostCosts.flashWriteUsPerByte = FLASH_WRITE_US_PER_BYTE;
+  hostCosts.flashEraseUsPerBlock = FLASH_ERASE_US_PER_BLOCK;
+  hostSerialEcho(false);
+  hostSetSerialFn(onSerialByte);
+  char buf[128];
+
+  printf("\n--- HEADLESS BOOT TEST ---\n");
+
+  printf("No Serial Monitor:\n");
+  unsigned long shows = hostShowCount;
+  unsigned long ms = reboot(-1);
+  snprintf(buf, sizeof(buf), "setup() done after %lu ms (budget %lu ms)", ms, BOOT_BUDGET_MS);
+  check(ms <= BOOT_BUDGET_MS, buf);
+  snprintf(buf, sizeof(buf), "each strip cleared with one show() (%lu shows)", hostShowCount - shows);
+  check(hostShowCount - shows == NUM_STRIPS_CONNECTED, buf);
+  hostIrSend(CODE_CH_MINUS);
+  runMs(400);
+  check(currentMode == MODE_INTRO, "remote works straight after boot");
+  runMs(2000);
+  check(serialOut.empty(), "nothing reaches a monitor that isn't there");
+
+  printf("Monitor opened 2 s after the reset:\n");
+  reboot(2000);
+  runMs(1500);
+  check(countOf("Boot:") == 0, "no report before the monitor opens");
+  runMs(1000);
+  fputs(serialOut.c_str(), stdout);
+  check(countOf("Boot: MODE_OFF after") == 1 && countOf("Boot stages ms:") == 1,
+        "boot report printed once the monitor opens");
+  check(countOf("Mode arena:") == 1, "RAM numbers come with it");
+  float reported = reportedMs();
+  snprintf(buf, sizeof(buf), "reported boot time %.1f ms includes the serial grace (%lu ms)",
+           reported, BOOT_SERIAL_WAIT_MS);
+  check(reported >= BOOT_SERIAL_WAIT_MS && reported <= BOOT_BUDGET_MS, buf);
+  runMs(2000);
+  check(countOf("Boot: MODE_OFF after") == 1, "and only once");
+
+  printf("Monitor already open:\n");
+  ms = reboot(0);
+  runMs(200);
+  reported = reportedMs();
+  snprintf(buf, sizeof(buf), "no grace spent: setup() %lu ms, reported %.1f ms", ms, reported);
+  check(ms < BOOT_SERIAL_WAIT_MS && reported >= 0 && reported <= ms + 1, buf);
+  check(serialOut.find("--- HIVE MIND SYSTEM START ---") != std::string::npos, "startup banner seen");
+
+  return hostTestFinish("BOOT TEST");
+}
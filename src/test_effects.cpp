@@ -0,0 +1,244 @@
+// --- ROUND 2 EFFECT TEST (host only) ---
+// Runs the real game (src/main.cpp is built into this environment too) on
+// the host and drives every Round 2 remote transition through the IR
+// receiver:
+//   - every armed effect (nothing, 7, 8, 9) x every selector (NEXT, PAUSE,
+//     PREV) x every effect the selected quadrant can be running
+//   - arming twice: the second arm key wins
+//   - LOSE and 2 on every effect their quadrant can be running
+//   - the lose sequence costs one show() per toggle, the last one included
+// After each one the effect slots (kind and timedMask) must be exactly
+// what effects.h says: a locked quadrant only takes another lock, anything
+// else takes the armed effect, and the other quadrants are left alone.
+//
+// The effect a quadrant is running beforehand is put there with the
+// remote too (7/8/9 and a selector, LOSE, the lock Round 2 starts with).
+// The few the remote can't reach (a locked top quadrant, a lose sequence
+// anywhere but bottom-right, a flicker with nothing armed since) are set
+// directly, and counted separately.
+//
+// Run with:  pio run -e test_effects -t exec
+// Prints PASS/FAIL per check and exits non-zero if anything failed.
+#include <HostTest.h>
+#include "modestate.h"
+
+// --- From the game (src/main.cpp and the headers it pulls in) ---
+void effectSetKind(uint8_t q, uint8_t kind);
+void effectStart(uint8_t q, uint8_t kind);
+
+// Long enough for a frame to arrive and be acted on, short enough that a
+// lose sequence (10 toggles at 50 ms) is still running three keys later
+const unsigned long KEY_MS = 150;
+const uint8_t LOSE_TOGGLES = 10;        // default in params.h
+const unsigned long LOSE_DONE_MS = 700; // ... at 50 ms each, with room
+
+const char* const KIND_NAMES[] = {"none", "steady", "flicker", "fast", "lose", "lost", "locked"};
+const uint8_t KIND_COUNT = EFFECT_LOCKED + 1;
+
+struct Arm {
+  uint32_t key;  // 0 = nothing armed
+  uint8_t kind;
+  const char* name;
+};
+const Arm ARMS[] = {
+  {0, EFFECT_NONE, "nothing"},
+  {CODE_7, EFFECT_STEADY, "7"},
+  {CODE_8, EFFECT_FLICKER, "8"},
+  {CODE_9, EFFECT_FLICKER_FAST, "9"},
+};
+
+struct Selector {
+  uint32_t key;
+  uint8_t q;
+  const char* name;
+};
+const Selector SELECTORS[] = {
+  {CODE_NEXT, Q_TOP_RIGHT, "NEXT"},
+  {CODE_PAUSE, Q_BOTTOM_RIGHT, "PAUSE"},
+  {CODE_PREV, Q_TOP_LEFT, "PREV"},
+};
+
+// A fresh Round 2: bottom-left locked, the others showing a bear
+void freshRound2() {
+  press(CODE_1, 300);
+  press(CODE_2, 1500);
+}
+
+uint32_t armKeyFor(uint8_t kind) {
+  for (const Arm& arm : ARMS) {
+    if (arm.kind == kind) return arm.key;
+  }
+  return 0;
+}
+
+uint32_t selectorFor(uint8_t q) {
+  for (const Selector& sel : SELECTORS) {
+    if (sel.q == q) return sel.key;
+  }
+  return 0;
+}
+
+// Put quadrant q into `kind` with the remote, without arming anything
+// unless `mayArm`. Returns false when the remote can't: then it is set
+// directly, past the lock.
+unsigned long driven = 0, forced = 0;
+
+bool reach(uint8_t q, uint8_t kind, bool mayArm) {
+  switch (kind) {
+    case EFFECT_NONE:
+      driven++;
+      return true;
+    case EFFECT_STEADY:
+    case EFFECT_FLICKER:
+    case EFFECT_FLICKER_FAST:
+      if (!mayArm || !selectorFor(q)) break;
+      press(armKeyFor(kind));
+      press(selectorFor(q));
+      driven++;
+      return true;
+    case EFFECT_LOSE:
+    case EFFECT_LOST:
+      if (q != Q_BOTTOM_RIGHT) break;
+      press(CODE_LOSE);
+      if (kind == EFFECT_LOST) runMs(LOSE_DONE_MS);
+      driven++;
+      return true;
+    case EFFECT_LOCKED:
+      if (q != Q_BOTTOM_LEFT) break;
+      driven++; // Round 2 starts with it locked
+      return true;
+  }
+  effectSetKind(q, EFFECT_NONE);
+  effectStart(q, kind);
+  forced++;
+  return false;
+}
+
+bool isTimed(uint8_t kind) {
+  return kind == EFFECT_FLICKER || kind == EFFECT_FLICKER_FAST || kind == EFFECT_LOSE;
+}
+
+// The slots as they should be: `before` with quadrant q set to `kind`
+bool slotsAre(const uint8_t before[NUM_STRIPS_CONNECTED], uint8_t q, uint8_t kind) {
+  uint8_t mask = 0;
+  for (uint8_t i = 0; i < NUM_STRIPS_CONNECTED; i++) {
+    uint8_t want = i == q ? kind : before[i];
+    if (modeState.r2.effects[i].kind != want) return false;
+    if (isTimed(want)) mask |= 1 << i;
+  }
+  return modeState.r2.timedMask == mask;
+}
+
+void kindsNow(uint8_t kinds[NUM_STRIPS_CONNECTED]) {
+  for (uint8_t i = 0; i < NUM_STRIPS_CONNECTED; i++) kinds[i] = modeState.r2.effects[i].kind;
+}
+
+int main() {
+  hostSerialEcho(false);
+  hostTestKeyMs = KEY_MS;
+  char buf[128];
+
+  printf("\n--- ROUND 2 EFFECT TEST ---\n");
+  setup();
+  runMs(200);
+
+  printf("Armed effect x selector x effect already running:\n");
+  unsigned long combos = 0, wrong = 0;
+  for (const Arm& arm : ARMS) {
+    for (const Selector& sel : SELECTORS) {
+      for (uint8_t kind = 0; kind < KIND_COUNT; kind++) {
+        freshRound2();
+        reach(sel.q, kind, arm.key != 0);
+        if (arm.key) press(arm.key);
+        uint8_t before[NUM_STRIPS_CONNECTED];
+        kindsNow(before);
+        press(sel.key);
+
+        uint8_t expect = kind == EFFECT_LOCKED || arm.key == 0 ? kind : arm.kind;
+        combos++;
+        if (!slotsAre(before, sel.q, expect) || modeState.r2.armed != arm.kind) {
+          wrong++;
+          snprintf(buf, sizeof(buf), "armed %s, %s on %s: got %s (timedMask %02x)", arm.name, sel.name,
+                   KIND_NAMES[kind], KIND_NAMES[modeState.r2.effects[sel.q].kind], modeState.r2.timedMask);
+          check(false, buf);
+        }
+      }
+    }
+  }
+  snprintf(buf, sizeof(buf), "every slot and timedMask as expected (%lu of %lu wrong)", wrong, combos);
+  check(wrong == 0, buf);
+
+  printf("Arming twice:\n");
+  combos = wrong = 0;
+  freshRound2();
+  for (const Arm& first : ARMS) {
+    for (const Arm& second : ARMS) {
+      if (!first.key || !second.key) continue;
+      press(first.key);
+      press(second.key);
+      combos++;
+      if (modeState.r2.armed != second.kind) wrong++;
+    }
+  }
+  snprintf(buf, sizeof(buf), "the second arm key wins (%lu of %lu wrong)", wrong, combos);
+  check(wrong == 0, buf);
+  press(CODE_9);
+  press(CODE_PREV);
+  runMs(1000);
+  press(CODE_PREV);
+  check(modeState.r2.effects[Q_TOP_LEFT].kind == EFFECT_FLICKER_FAST && modeState.r2.effects[Q_TOP_LEFT].phase < 4 &&
+            (modeState.r2.timedMask & 1 << Q_TOP_LEFT),
+        "re-applying the running effect starts it again");
+
+  printf("LOSE on every effect (top-left fast flicker, top-right steady):\n");
+  combos = wrong = 0;
+  for (uint8_t kind = 0; kind < KIND_COUNT; kind++) {
+    freshRound2();
+    reach(Q_TOP_LEFT, EFFECT_FLICKER_FAST, true);
+    reach(Q_TOP_RIGHT, EFFECT_STEADY, true);
+    reach(Q_BOTTOM_RIGHT, kind, true);
+    uint8_t before[NUM_STRIPS_CONNECTED];
+    kindsNow(before);
+    if (before[Q_TOP_LEFT] == EFFECT_FLICKER_FAST) before[Q_TOP_LEFT] = EFFECT_NONE; // LOSE stops other flickers
+    press(CODE_LOSE);
+    combos++;
+    if (!slotsAre(before, Q_BOTTOM_RIGHT, kind == EFFECT_LOCKED ? kind : (uint8_t)EFFECT_LOSE)) {
+      wrong++;
+      snprintf(buf, sizeof(buf), "LOSE on %s: got %s (timedMask %02x)", KIND_NAMES[kind],
+               KIND_NAMES[modeState.r2.effects[Q_BOTTOM_RIGHT].kind], modeState.r2.timedMask);
+      check(false, buf);
+    }
+  }
+  snprintf(buf, sizeof(buf), "bottom-right loses unless locked, flicker elsewhere stops (%lu of %lu wrong)", wrong,
+           combos);
+  check(wrong == 0, buf);
+
+  printf("2 on every effect:\n");
+  combos = wrong = 0;
+  for (uint8_t kind = 0; kind < KIND_COUNT; kind++) {
+    freshRound2();
+    reach(Q_TOP_RIGHT, EFFECT_FLICKER, true);
+    reach(Q_BOTTOM_LEFT, kind, true);
+    uint8_t before[NUM_STRIPS_CONNECTED];
+    kindsNow(before);
+    press(CODE_2);
+    combos++;
+    if (!slotsAre(before, Q_BOTTOM_LEFT, EFFECT_LOCKED) || activeMode != MODE_R2) wrong++;
+  }
+  snprintf(buf, sizeof(buf), "bottom-left locked from anything, nothing else touched (%lu of %lu wrong)", wrong,
+           combos);
+  check(wrong == 0, buf);
+
+  printf("The lose sequence:\n");
+  freshRound2();
+  unsigned long shows = hostShowCount;
+  press(CODE_LOSE, LOSE_DONE_MS);
+  shows = hostShowCount - shows;
+  snprintf(buf, sizeof(buf), "one show() to start and one per toggle, the X included (%lu)", shows);
+  check(modeState.r2.effects[Q_BOTTOM_RIGHT].kind == EFFECT_LOST && shows == 1 + LOSE_TOGGLES, buf);
+
+  snprintf(buf, sizeof(buf), "starting effects: %lu from the remote, %lu set directly", driven, forced);
+  check(driven > forced, buf);
+
+  return hostTestFinish("ROUND 2 EFFECT TEST");
+}
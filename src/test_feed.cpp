@@ -0,0 +1,184 @@
+// --- STATE FEED TEST (host only) ---
+// Runs the real game (src/main.cpp is built into this environment too) on
+// the host, feeds everything it sends on Serial through the same decoders
+// as decode_feed and decode_telemetry, and plays a show through every
+// round:
+//   - after every loop the state rebuilt from the feed equals the game's
+//     own (mode, rows, boundary, effects)
+//   - the lose and the win come through as events, once each, even when
+//     the UART has no room for them straight after their records
+//   - nothing is sent while nothing changes, except the snapshots
+//   - an overlay that starts listening mid-show is right within one
+//     snapshot period
+//   - a record damaged on the way is noticed (seq gap at the next record)
+//     and healed by the next snapshot
+//   - a snapshot of an unknown version is refused
+//   - the telemetry records around the feed still decode cleanly
+//
+// Run with:  pio run -e test_feed -t exec
+// Prints PASS/FAIL per check and exits non-zero if anything failed.
+#include <HostTest.h>
+#include "modestate.h"
+#include "feed_decode.h"
+#include "telemetry_decode.h"
+
+// --- From the game (src/main.cpp and the headers it pulls in) ---
+uint8_t trackBlueCols();
+const uint16_t FEED_SNAPSHOT_MS = 2000; // same value as feed.h
+
+// --- The overlay's side: feed first, the rest to the telemetry decoder ---
+FeedDecoder feed = {};
+FeedDecoder lateFeed = {}; // starts listening mid-show
+bool lateListening = false;
+TelemetryDecoder telemetry = {};
+unsigned long feedBytes = 0, feedRecords = 0, snapshots = 0;
+unsigned long loseEvents = 0, winEvents = 0, loseQuad = FEED_NO_QUAD;
+
+void onFeed(const FeedDecoder&, uint16_t, uint8_t type, const uint8_t* body, uint8_t len) {
+  feedBytes += FEED_HEADER_BYTES + len + 1;
+  feedRecords++;
+  if (type == FEED_SNAPSHOT) snapshots++;
+  if (type != FEED_EVENT) return;
+  if (body[0] == FEED_LOSE) { loseEvents++; loseQuad = body[1]; }
+  if (body[0] == FEED_WIN) winEvents++;
+}
+void onLateFeed(const FeedDecoder&, uint16_t, uint8_t, const uint8_t*, uint8_t) {}
+void onTelemetry(uint32_t, uint8_t, uint16_t) {}
+void onText(uint8_t) {}
+void onOther(uint8_t c) { telemetryDecodeByte(telemetry, c, onTelemetry, onText); }
+void ignore(uint8_t) {}
+
+// Set to garble the next feed record on its way (the byte after its sync)
+bool damageNext = false;
+bool damaging = false;
+
+void onSerialByte(uint8_t c) {
+  if (damaging) { c ^= 0x40; damaging = false; }
+  if (damageNext && c == FEED_SYNC) { damaging = true; damageNext = false; }
+  feedDecodeByte(feed, c, onFeed, onOther);
+  if (lateListening) feedDecodeByte(lateFeed, c, onLateFeed, ignore);
+}
+
+// --- The game's side, read straight from its memory ---
+bool viewMatchesGame(const FeedView& v) {
+  if (!v.synced || v.mode != activeMode || v.quads != NUM_STRIPS_CONNECTED) return false;
+  bool r1 = activeMode == MODE_R1 || activeMode == MODE_R4;
+  if (v.boundary != (activeMode == MODE_R3 ? trackBlueCols() : 0)) return false;
+  for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) {
+    if (v.rows[q] != (r1 ? modeState.r1.rows[q] : 0)) return false;
+    if (v.effects[q] != (activeMode == MODE_R2 ? modeState.r2.effects[q].kind : 0)) return false;
+  }
+  return true;
+}
+
+// After each loop the overlay has to agree with the game (feed.h writes
+// its records straight away)
+unsigned long compared = 0, mismatches = 0;
+
+void compareWithGame() {
+  if (!activeModeEntered || damageNext || feed.bad) return; // from the damaged record on
+  compared++;
+  if (!viewMatchesGame(feed.view)) mismatches++;
+}
+
+int main() {
+  hostSerialEcho(false);
+  hostSetSerialFn(onSerialByte);
+  hostTestEachLoop = compareWithGame;
+  char buf[128];
+
+  printf("\n--- STATE FEED TEST ---\n");
+  setup();
+  runMs(200);
+
+  printf("A show through every round:\n");
+  press(CODE_1);
+  for (int i = 0; i < 6; i++) ball(i % NUM_STRIPS_CONNECTED);
+  runMs(500);
+  press(CODE_2);
+  runMs(1000);
+  press(CODE_7); press(CODE_NEXT);
+  press(CODE_8); press(CODE_PREV);
+
+  // Someone opens the overlay now
+  lateListening = true;
+  unsigned long lateFromMs = millis();
+  press(CODE_LOSE);
+  runMs(1000);
+  unsigned long lateSyncedMs = 0;
+  for (unsigned long waited = 0; waited < 2 * FEED_SNAPSHOT_MS && !lateSyncedMs; waited += 10) {
+    runMs(10);
+    if (lateFeed.view.synced) lateSyncedMs = millis();
+  }
+  press(CODE_3);
+  for (int i = 0; i < 5; i++) press(CODE_NEXT);
+  for (int i = 0; i < 3; i++) press(CODE_PREV);
+  runMs(1000);
+  press(CODE_5);
+  runMs(1000);
+
+  snprintf(buf, sizeof(buf), "rebuilt state equals the game's after every loop (%lu of %lu differ)",
+           mismatches, compared);
+  check(compared > 1000 && mismatches == 0, buf);
+  snprintf(buf, sizeof(buf), "one lose event, on the lose quadrant (%lu, quad %lu)", loseEvents, loseQuad);
+  check(loseEvents == 1 && loseQuad == Q_BOTTOM_RIGHT, buf);
+  snprintf(buf, sizeof(buf), "one win event (%lu)", winEvents);
+  check(winEvents == 1, buf);
+  snprintf(buf, sizeof(buf), "late overlay right %lu ms after it started listening",
+           lateSyncedMs ? lateSyncedMs - lateFromMs : 0);
+  check(lateSyncedMs && lateSyncedMs - lateFromMs <= FEED_SNAPSHOT_MS + 100 && viewMatchesGame(lateFeed.view),
+        buf);
+
+  printf("Nothing changing:\n");
+  unsigned long recordsBefore = feedRecords, snapshotsBefore = snapshots, bytesBefore = feedBytes;
+  runMs(10000);
+  unsigned long sent = feedRecords - recordsBefore;
+  snprintf(buf, sizeof(buf), "10 s of finale: %lu records, all snapshots, %.1f bytes/s", sent,
+           (feedBytes - bytesBefore) / 10.0);
+  check(sent == snapshots - snapshotsBefore && sent >= 4 && sent <= 6, buf);
+
+  printf("A damaged record:\n");
+  press(CODE_1);
+  damageNext = true; // the point's record arrives with a bad byte
+  ball(0);
+  unsigned long damagedAt = millis();
+  unsigned long healedMs = 0;
+  for (unsigned long waited = 0; waited < 2 * FEED_SNAPSHOT_MS && !healedMs; waited += 10) {
+    runMs(10);
+    if (feed.lost && viewMatchesGame(feed.view)) healedMs = millis() - damagedAt;
+  }
+  snprintf(buf, sizeof(buf), "%lu record lost, seen at the next one, right again after %lu ms", feed.lost,
+           healedMs);
+  check(feed.lost == 1 && healedMs > 0 && healedMs <= FEED_SNAPSHOT_MS + 100, buf);
+  check(modeState.r1.rows[0] == 1 && feed.view.rows[0] == 1, "the point scored meanwhile is there");
+
+  printf("A slow link:\n");
+  hostCosts.serialAtBaud = true;
+  hostCosts.serialFifoBytes = 10; // a mode or effect record fits, its event after it doesn't
+  Serial.begin(9600);
+  loseEvents = winEvents = 0;
+  press(CODE_2);
+  runMs(1000);
+  press(CODE_LOSE);
+  runMs(1000);
+  press(CODE_5);
+  runMs(1000);
+  snprintf(buf, sizeof(buf), "lose and win events still come through, once each (%lu, %lu)", loseEvents,
+           winEvents);
+  check(loseEvents == 1 && winEvents == 1, buf);
+  hostCosts.serialAtBaud = false;
+
+  printf("Unknown version:\n");
+  FeedDecoder fresh = {};
+  uint8_t record[FEED_HEADER_BYTES + FEED_SNAPSHOT_FIXED + 1] = {FEED_SYNC, 0, 0, FEED_SNAPSHOT,
+                                                                 FEED_SNAPSHOT_FIXED, FEED_VERSION + 1};
+  record[sizeof(record) - 1] = feedCheck(record, FEED_SNAPSHOT_FIXED);
+  for (uint8_t c : record) feedDecodeByte(fresh, c, onLateFeed, ignore);
+  check(fresh.badVersion == 1 && !fresh.view.synced, "refused, overlay stays unsynced");
+
+  snprintf(buf, sizeof(buf), "telemetry still decodes cleanly (%lu records, %lu damaged)",
+           telemetry.records, telemetry.bad);
+  check(telemetry.records > 0 && telemetry.bad == 0, buf);
+
+  return hostTestFinish("STATE FEED TEST");
+}
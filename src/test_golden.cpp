@@ -0,0 +1,356 @@
+// --- GOLDEN FRAME TEST (host only) ---
+// Draws every fixed scene of the game with its own drawing code (src/main.cpp
+// is built into this environment too) and compares the four strips' pixel
+// buffers, byte for byte as they would go down the wire, with the copies
+// checked in to golden/frames.txt. Any change to the art shows up here,
+// including LEDs that should stay dark (serpentine turns, spare row).
+//
+// Scenes: intro and finale rainbows at fixed hues, the Round 1 jar at every
+// fill level, the Round 2 bear, red X and bear with X, and the Round 3 track
+// with the boundary at every column.
+//
+// A scene that doesn't match prints its expected and actual quadrants side
+// by side and lists the LEDs that differ. Pictures show the 18x18 grid top
+// row first, with each row's turn LED in an extra last column and the spare
+// row on top, so every LED on the strip is in the picture.
+//
+// Run with:  pio run -e test_golden -t exec
+// After an intended change to the art, rewrite the golden file with
+//            .pio/build/test_golden/program --update
+// and check the new pictures in the diff before committing it.
+#include <HostTest.h>
+#include <Adafruit_NeoPixel.h>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "modestate.h"
+
+// --- From the game (src/main.cpp and the headers it pulls in) ---
+extern Adafruit_NeoPixel strips[NUM_STRIPS_CONNECTED];
+void introUpdate();
+void finaleUpdate();
+void drawJarBorder(uint8_t q, uint32_t borderColor);
+void drawJarRow(uint8_t q, uint8_t row, uint32_t color);
+uint32_t jarBorderColor();
+uint32_t jarHoneyColor(uint8_t step);
+void effectDrawBear(uint8_t q);
+void drawRedX(uint8_t q);
+void drawRedXOver(uint8_t q);
+void trackJumpTo(uint8_t blueCols);
+
+// Same values as rounds.h, round3.h and params.h
+const uint8_t JAR_RISE_STEPS = 6;
+const uint8_t JAR_MAX_ROWS = QUAD_ROWS - 2;
+const uint8_t TRACK_COLS = 2 * QUAD_COLS;
+const uint16_t INTRO_HUE_STEP = 3000;
+const uint16_t FINALE_HUE_STEP = 100;
+
+const char* const GOLDEN_PATH = "golden/frames.txt";
+// Palette characters for a quadrant's colours; '.' is off. A quadrant with
+// more colours than this (the rainbows) is stored as hex, one LED per word.
+const char PALETTE_CHARS[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+const size_t PALETTE_SIZE = sizeof(PALETTE_CHARS) - 1;
+const int MAX_LISTED_DIFFS = 12;
+
+// One frame: the wire colour (RRGGBB, brightness applied) of every LED
+struct Frame {
+  uint32_t led[NUM_STRIPS_CONNECTED][LEDS_PER_QUAD];
+};
+
+// --- SCENES ---
+struct Scene {
+  std::string name;
+  void (*draw)(int arg);
+  int arg;
+};
+
+void drawIntro(int hue) {
+  modeState.intro.hue = (uint16_t)(hue - INTRO_HUE_STEP); // introUpdate() adds one step first
+  introUpdate();
+}
+
+void drawFinale(int hue) {
+  modeState.finale.hue = (uint16_t)(hue - FINALE_HUE_STEP);
+  finaleUpdate();
+}
+
+void drawJar(int rows) {
+  for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) {
+    drawJarBorder(q, jarBorderColor());
+    for (uint8_t row = 0; row < rows; row++) drawJarRow(q, row, jarHoneyColor(JAR_RISE_STEPS));
+  }
+}
+
+void drawBear(int) {
+  for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) effectDrawBear(q);
+}
+
+void drawX(int) {
+  for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) drawRedX(q);
+}
+
+void drawBearX(int) {
+  for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) {
+    effectDrawBear(q);
+    drawRedXOver(q);
+  }
+}
+
+void drawTrack(int blueCols) { trackJumpTo((uint8_t)blueCols); }
+
+std::vector<Scene> allScenes() {
+  std::vector<Scene> scenes = {
+    {"intro_hue_0", drawIntro, 0},
+    {"intro_hue_32768", drawIntro, 32768},
+    {"finale_hue_16384", drawFinale, 16384},
+  };
+  for (int rows = 0; rows <= JAR_MAX_ROWS; rows++) scenes.push_back({"jar_" + std::to_string(rows), drawJar, rows});
+  scenes.push_back({"bear", drawBear, 0});
+  scenes.push_back({"x", drawX, 0});
+  scenes.push_back({"bear_x", drawBearX, 0});
+  for (int cols = 0; cols <= TRACK_COLS; cols++) scenes.push_back({"track_" + std::to_string(cols), drawTrack, cols});
+  return scenes;
+}
+
+Frame render(const Scene& s) {
+  for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) strips[q].clear();
+  s.draw(s.arg);
+  Frame f;
+  for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) {
+    const uint8_t* p = strips[q].getPixels();
+    for (uint16_t i = 0; i < LEDS_PER_QUAD; i++, p += 3) {
+      f.led[q][i] = (uint32_t)p[1] << 16 | (uint32_t)p[0] << 8 | p[2]; // buffer is G R B
+    }
+  }
+  return f;
+}
+
+uint64_t frameHash(const Frame& f) {
+  uint64_t h = 1469598103934665603ULL; // FNV-1a
+  for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) {
+    for (uint16_t i = 0; i < LEDS_PER_QUAD; i++) {
+      for (int shift = 16; shift >= 0; shift -= 8) h = (h ^ (uint8_t)(f.led[q][i] >> shift)) * 1099511628211ULL;
+    }
+  }
+  return h;
+}
+
+// --- PICTURE LAYOUT ---
+// The strip LED at row r (0 = bottom), column c of a picture. Worked out
+// here rather than with xyToIndex(), so a mapping bug shows in the picture.
+uint16_t pictureLed(uint8_t r, uint8_t c) {
+  uint16_t rowStart = (uint16_t)r * PHYS_COLS;
+  if (r >= QUAD_ROWS || c == PHYS_COLS - 1) return rowStart + c;  // spare row, turn LED
+  return rowStart + (r % 2 == 0 ? c : PHYS_COLS - 2 - c);         // odd rows run backwards
+}
+
+// "x 4 y 2", "turn LED, row 3" or "spare row"
+std::string ledName(uint16_t i) {
+  uint8_t r = i / PHYS_COLS, p = i % PHYS_COLS;
+  if (r >= QUAD_ROWS) return "spare row";
+  if (p == PHYS_COLS - 1) return "turn LED, row " + std::to_string(r);
+  uint8_t x = r % 2 == 0 ? p : PHYS_COLS - 2 - p;
+  return "x " + std::to_string(x) + " y " + std::to_string(r);
+}
+
+// --- GOLDEN FILE ---
+// scene <name> <hash>
+// quad <q> off                  (every LED dark)
+// quad <q> palette a=RRGGBB ... then PHYS_ROWS lines of PHYS_COLS characters
+// quad <q> hex                  then PHYS_ROWS lines of PHYS_COLS hex words
+// Picture rows are top row first.
+struct Golden {
+  uint64_t hash;
+  Frame frame;
+};
+
+void writeQuad(std::ostream& out, const uint32_t* led, uint8_t q) {
+  std::map<uint32_t, char> palette;
+  for (uint16_t i = 0; i < LEDS_PER_QUAD; i++) {
+    if (led[i] && !palette.count(led[i]) && palette.size() < PALETTE_SIZE + 1) {
+      palette[led[i]] = palette.size() < PALETTE_SIZE ? PALETTE_CHARS[palette.size()] : 0;
+    }
+  }
+  if (palette.empty()) {
+    out << "quad " << (int)q << " off\n";
+    return;
+  }
+  bool hex = palette.size() > PALETTE_SIZE;
+  char buf[16];
+  out << "quad " << (int)q << (hex ? " hex" : " palette");
+  if (!hex) {
+    for (const auto& e : palette) {
+      snprintf(buf, sizeof(buf), " %c=%06X", e.second, (unsigned)e.first);
+      out << buf;
+    }
+  }
+  out << "\n";
+  for (int r = PHYS_ROWS - 1; r >= 0; r--) {
+    for (uint8_t c = 0; c < PHYS_COLS; c++) {
+      uint32_t v = led[pictureLed(r, c)];
+      if (hex) {
+        snprintf(buf, sizeof(buf), "%s%06X", c ? " " : "", (unsigned)v);
+        out << buf;
+      } else {
+        out << (v ? palette[v] : '.');
+      }
+    }
+    out << "\n";
+  }
+}
+
+bool readQuad(std::istream& in, const std::string& header, uint32_t* led) {
+  std::istringstream hs(header);
+  std::string word, kind;
+  int q;
+  hs >> word >> q >> kind;
+  memset(led, 0, sizeof(uint32_t) * LEDS_PER_QUAD);
+  if (kind == "off") return true;
+  std::map<char, uint32_t> palette;
+  for (std::string e; hs >> e;) {
+    if (e.size() > 2 && e[1] == '=') palette[e[0]] = (uint32_t)strtoul(e.c_str() + 2, nullptr, 16);
+  }
+  std::string line;
+  for (int r = PHYS_ROWS - 1; r >= 0; r--) {
+    if (!std::getline(in, line)) return false;
+    std::istringstream ls(line);
+    for (uint8_t c = 0; c < PHYS_COLS; c++) {
+      uint32_t v = 0;
+      if (kind == "hex") {
+        if (!(ls >> word)) return false;
+        v = (uint32_t)strtoul(word.c_str(), nullptr, 16);
+      } else {
+        if (c >= line.size()) return false;
+        v = line[c] == '.' ? 0 : palette[line[c]];
+      }
+      led[pictureLed(r, c)] = v;
+    }
+  }
+  return true;
+}
+
+bool loadGolden(std::map<std::string, Golden>& golden) {
+  std::ifstream in(GOLDEN_PATH);
+  if (!in) {
+    printf("Can't read %s (create it with --update)\n", GOLDEN_PATH);
+    return false;
+  }
+  std::string line, name;
+  Golden* g = nullptr;
+  while (std::getline(in, line)) {
+    if (line.compare(0, 6, "scene ") == 0) {
+      std::istringstream ls(line.substr(6));
+      std::string hash;
+      ls >> name >> hash;
+      g = &golden[name];
+      g->hash = strtoull(hash.c_str(), nullptr, 16);
+      memset(&g->frame, 0, sizeof(g->frame));
+    } else if (line.compare(0, 5, "quad ") == 0 && g) {
+      int q = atoi(line.c_str() + 5);
+      if (q < 0 || q > 3 || !readQuad(in, line, g->frame.led[q])) {
+        printf("%s: bad picture for %s\n", GOLDEN_PATH, name.c_str());
+        return false;
+      }
+    }
+  }
+  // A picture edited by hand would no longer match the hash it came with
+  for (const auto& e : golden) {
+    if (frameHash(e.second.frame) != e.second.hash) {
+      printf("%s: picture for %s doesn't match its hash\n", GOLDEN_PATH, e.first.c_str());
+      return false;
+    }
+  }
+  return true;
+}
+
+bool saveGolden(const std::vector<Scene>& scenes) {
+  std::ofstream out(GOLDEN_PATH);
+  if (!out) return false;
+  out << "# Golden frames for test_golden (src/test_golden.cpp). Generated with --update:\n"
+         "# check the pictures in the diff before committing a change to this file.\n";
+  char buf[32];
+  for (const Scene& s : scenes) {
+    Frame f = render(s);
+    snprintf(buf, sizeof(buf), "%016llx", (unsigned long long)frameHash(f));
+    out << "\nscene " << s.name << " " << buf << "\n";
+    for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) writeQuad(out, f.led[q], q);
+  }
+  return (bool)out;
+}
+
+// --- DIFF ---
+void printDiff(const Frame& want, const Frame& got) {
+  for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) {
+    if (memcmp(want.led[q], got.led[q], sizeof(want.led[q])) == 0) continue;
+
+    // One palette over both pictures so the same character means the same colour
+    std::map<uint32_t, char> palette;
+    for (const Frame* f : {&want, &got}) {
+      for (uint16_t i = 0; i < LEDS_PER_QUAD; i++) {
+        uint32_t v = f->led[q][i];
+        if (v && !palette.count(v)) palette[v] = palette.size() < PALETTE_SIZE ? PALETTE_CHARS[palette.size()] : '*';
+      }
+    }
+    auto ch = [&](uint32_t v) { return v ? palette[v] : '.'; };
+
+    std::string title = "quad " + std::to_string(q);
+    printf("    %-8s%-*s%-*s%s\n", title.c_str(), PHYS_COLS + 2, "expected", PHYS_COLS + 2, "got", "differs");
+    for (int r = PHYS_ROWS - 1; r >= 0; r--) {
+      std::string a, b, d;
+      for (uint8_t c = 0; c < PHYS_COLS; c++) {
+        uint16_t i = pictureLed(r, c);
+        a += ch(want.led[q][i]);
+        b += ch(got.led[q][i]);
+        d += want.led[q][i] == got.led[q][i] ? '.' : 'X';
+      }
+      printf("    %-8s%s  %s  %s\n", "", a.c_str(), b.c_str(), d.c_str());
+    }
+    int listed = 0, differing = 0;
+    for (uint16_t i = 0; i < LEDS_PER_QUAD; i++) {
+      if (want.led[q][i] == got.led[q][i]) continue;
+      if (listed++ < MAX_LISTED_DIFFS) {
+        printf("    LED %3u (%s): expected #%06X got #%06X\n", i, ledName(i).c_str(),
+               (unsigned)want.led[q][i], (unsigned)got.led[q][i]);
+      }
+      differing++;
+    }
+    if (differing > MAX_LISTED_DIFFS) printf("    ... %d LEDs differ in all\n", differing);
+  }
+}
+
+int main(int argc, char** argv) {
+  bool update = argc > 1 && strcmp(argv[1], "--update") == 0;
+  hostSerialEcho(false);
+  setup();
+  std::vector<Scene> scenes = allScenes();
+
+  if (update) {
+    bool ok = saveGolden(scenes);
+    printf("%s %zu scenes to %s\n", ok ? "Wrote" : "Couldn't write", scenes.size(), GOLDEN_PATH);
+    return ok ? 0 : 1;
+  }
+
+  printf("\n--- GOLDEN FRAME TEST ---\n");
+  std::map<std::string, Golden> golden;
+  if (!loadGolden(golden)) return 1;
+  char buf[160];
+  for (const Scene& s : scenes) {
+    Frame f = render(s);
+    uint64_t hash = frameHash(f);
+    auto it = golden.find(s.name);
+    if (it == golden.end()) {
+      snprintf(buf, sizeof(buf), "%s: no golden frame (run with --update)", s.name.c_str());
+      check(false, buf);
+      continue;
+    }
+    snprintf(buf, sizeof(buf), "%s %016llx", s.name.c_str(), (unsigned long long)hash);
+    check(hash == it->second.hash, buf);
+    if (hash != it->second.hash) printDiff(it->second.frame, f);
+    golden.erase(it);
+  }
+  for (const auto& g : golden) printf("  (golden frame %s is no longer drawn)\n", g.first.c_str());
+
+  return hostTestFinish("GOLDEN FRAME TEST");
+}
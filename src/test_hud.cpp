@@ -0,0 +1,137 @@
+// --- HEALTH HUD TEST (host only) ---
+// Runs the real game (src/main.cpp is built into this environment too) on
+// the host and reads back what the HUD put on the 12x8 matrix:
+//   - the layout: mode column, heartbeat, loops per second, worst loop,
+//     bad remote frames and beam breaks each on their own row
+//   - a slow loop shows up on the worst-loop row and is gone again a
+//     second later
+//   - the matrix is redrawn a few times a second, not every loop
+//   - one redraw stays inside its time budget
+//
+// Run with:  pio run -e test_hud -t exec
+// Prints the matrix, PASS/FAIL per check and exits non-zero if anything
+// failed.
+#include <HostTest.h>
+#include <chrono>
+#include "modestate.h"
+
+// --- From the game (src/main.cpp and the headers it pulls in) ---
+void hudUpdate();
+
+// Matrix rows (same values as hud.h)
+const uint8_t HUD_ROW_MODE = 0;
+const uint8_t HUD_ROW_FPS = 2;
+const uint8_t HUD_ROW_WORST = 4;
+const uint8_t HUD_ROW_IR = 6;
+const uint8_t HUD_ROW_BEAMS = 7;
+const uint8_t HUD_SPACER_ROWS[] = {1, 3, 5};
+
+const uint32_t KEY_STRAY = 0xF807FF00; // not mapped to anything
+
+// One redraw on the board is a few hundred cycles; the host is faster than
+// the board's 48 MHz M4, so the same budget here is generous
+const float HUD_BUDGET_US = 20;
+
+int litInRow(uint8_t row) {
+  int n = 0;
+  for (uint8_t c = 0; c < 12; c++) n += hostMatrixPixel(row, c);
+  return n;
+}
+
+// A bar is a run of LEDs from the left with nothing after it
+bool isBar(uint8_t row) {
+  int n = litInRow(row);
+  for (uint8_t c = 0; c < 12; c++) {
+    if (hostMatrixPixel(row, c) != (c < n)) return false;
+  }
+  return true;
+}
+
+void printMatrix() {
+  for (uint8_t r = 0; r < 8; r++) {
+    printf("    ");
+    for (uint8_t c = 0; c < 12; c++) printf("%c ", hostMatrixPixel(r, c) ? '#' : '.');
+    printf("\n");
+  }
+}
+
+int main() {
+  hostSerialEcho(false);
+  char buf[128];
+
+  printf("\n--- HEALTH HUD TEST ---\n");
+  setup();
+  runMs(1500);
+  printf("After 1.5 s in MODE_OFF:\n");
+  printMatrix();
+
+  // Layout
+  check(hostMatrixPixel(HUD_ROW_MODE, MODE_OFF) && litInRow(HUD_ROW_MODE) - hostMatrixPixel(HUD_ROW_MODE, 11) == 1,
+        "mode row: one LED at MODE_OFF's column");
+  bool rowsOk = true;
+  for (uint8_t r : HUD_SPACER_ROWS) rowsOk = rowsOk && litInRow(r) == 0;
+  check(rowsOk, "spacer rows stay dark");
+  // delay(10) per loop and free show()s: just under 100 loops a second
+  snprintf(buf, sizeof(buf), "loops/s row shows ~100 (%d LEDs)", litInRow(HUD_ROW_FPS));
+  check(isBar(HUD_ROW_FPS) && litInRow(HUD_ROW_FPS) >= 9 && litInRow(HUD_ROW_FPS) <= 10, buf);
+  snprintf(buf, sizeof(buf), "worst loop row shows 10 ms (%d LEDs)", litInRow(HUD_ROW_WORST));
+  check(isBar(HUD_ROW_WORST) && litInRow(HUD_ROW_WORST) == 2, buf);
+  check(litInRow(HUD_ROW_IR) == 0 && litInRow(HUD_ROW_BEAMS) == 0, "no bad frames, no beams yet");
+
+  // Heartbeat flips on every redraw
+  bool beat = hostMatrixPixel(HUD_ROW_MODE, 11);
+  runMs(250);
+  check(hostMatrixPixel(HUD_ROW_MODE, 11) != beat, "heartbeat flips between redraws");
+
+  // A stall of ~50 ms is on the worst-loop row for about a second
+  loop();
+  hostAdvanceUs(40000);
+  runMs(300);
+  snprintf(buf, sizeof(buf), "50 ms loop shows on the worst row (%d LEDs)", litInRow(HUD_ROW_WORST));
+  check(litInRow(HUD_ROW_WORST) == 10, buf);
+  runMs(1200);
+  snprintf(buf, sizeof(buf), "and is gone a second later (%d LEDs)", litInRow(HUD_ROW_WORST));
+  check(litInRow(HUD_ROW_WORST) == 2, buf);
+
+  // Remote: an unknown frame counts as bad, a mode switch moves the mode LED
+  hostIrSend(KEY_STRAY);
+  runMs(400);
+  check(litInRow(HUD_ROW_IR) == 1, "stray remote frame shows on the bad-frame row");
+  hostIrSend(CODE_CH_MINUS);
+  runMs(400);
+  check(hostMatrixPixel(HUD_ROW_MODE, MODE_INTRO) && !hostMatrixPixel(HUD_ROW_MODE, MODE_OFF),
+        "mode LED moves to MODE_INTRO");
+
+  // Beams: three balls through Round 1 within a second
+  hostIrSend(CODE_1);
+  runMs(1500);
+  check(litInRow(HUD_ROW_IR) == 0, "bad-frame row clears after a second");
+  for (int i = 0; i < 3; i++) {
+    hostSetPin(BEAM_PINS[i], HIGH);
+    runMs(60);
+    hostSetPin(BEAM_PINS[i], LOW);
+    runMs(60);
+  }
+  runMs(250);
+  printf("After three balls in Round 1:\n");
+  printMatrix();
+  snprintf(buf, sizeof(buf), "beam row counts the balls (%d LEDs)", litInRow(HUD_ROW_BEAMS));
+  check(isBar(HUD_ROW_BEAMS) && litInRow(HUD_ROW_BEAMS) == 3, buf);
+
+  // Redraw rate: a few times a second, not once per loop
+  unsigned long loads = hostMatrixLoads;
+  runMs(10000);
+  loads = hostMatrixLoads - loads;
+  snprintf(buf, sizeof(buf), "matrix redrawn %lu times in 10 s (4 per second)", loads);
+  check(loads >= 39 && loads <= 41, buf);
+
+  // Cost of one redraw (host CPU time)
+  const int N = 10000;
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < N; i++) hudUpdate();
+  float avgUs = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - t0).count() / N;
+  snprintf(buf, sizeof(buf), "one redraw takes %.2f us (budget %.0f us)", avgUs, HUD_BUDGET_US);
+  check(avgUs <= HUD_BUDGET_US, buf);
+
+  return hostTestFinish("HUD TEST");
+}
@@ -0,0 +1,198 @@
+// --- GAME JOURNAL TEST (host only) ---
+// Runs the real game (src/main.cpp is built into this environment too) on
+// the host, with the data flash emulator from lib/HostShim, and pulls the
+// plug in the middle of every round:
+//   - after a reset the board must come back on the same scene, quickly
+//   - a record torn in half by the power cut must not confuse the replay
+//   - neither must a checkpoint the power cut stopped partway through
+//   - a record that passes its check but holds a mode or effect that
+//     doesn't exist is ignored
+//   - thousands of changes must wrap the ring evenly, never program flash
+//     that wasn't erased, and never stall the loop for more than one
+//     flash operation at a time
+//
+// Run with:  pio run -e test_journal -t exec
+// Prints PASS/FAIL per check and exits non-zero if anything failed.
+#include <HostTest.h>
+#include <Adafruit_NeoPixel.h>
+#include <DataFlash.h>
+#include "modestate.h"
+
+// --- From the game (src/main.cpp and the headers it pulls in) ---
+extern Mode currentMode;
+extern Adafruit_NeoPixel strips[NUM_STRIPS_CONNECTED];
+uint16_t xyToIndex(uint8_t x, uint8_t y);
+void round3Next();
+void round3Prev();
+void journalCheckpoint();
+uint8_t journalCheck(uint8_t tag, uint8_t arg, uint8_t value);
+extern uint16_t journalHead;
+const uint8_t JOURNAL_CHECKPOINT_RECORDS = 2 + 2 * NUM_STRIPS_CONNECTED; // same value as journal.h
+const uint8_t JOURNAL_RECORD_BYTES = 4;
+
+// Rough RA4M1 data flash timings (typical values from the datasheet)
+const unsigned long FLASH_WRITE_US_PER_BYTE = 50;
+const unsigned long FLASH_ERASE_US_PER_BLOCK = 10000;
+// How fast the scene has to be back after a reset
+const unsigned long RESUME_BUDGET_MS = 400;
+
+// Power cut: RAM and LEDs are gone, the data flash is not. Boots again and
+// returns how long it took until `expect` was running with its scene drawn.
+unsigned long reboot(Mode expect) {
+  hostFlashPowerFailAfter(-1);
+  memset(&modeState, 0, sizeof(modeState));
+  currentMode = MODE_OFF;
+  activeMode = MODE_OFF;
+  activeModeEntered = true;
+  for (int q = 0; q < NUM_STRIPS_CONNECTED; q++) strips[q].clear();
+
+  unsigned long t0 = hostNowUs();
+  setup();
+  unsigned long deadline = millis() + 3000;
+  while (!modeIsRunning(expect) && millis() < deadline) loop();
+  unsigned long tookMs = (hostNowUs() - t0) / 1000;
+  runMs(500); // let the journal catch up again
+  return tookMs;
+}
+
+void reportResume(unsigned long ms) {
+  char buf[64];
+  snprintf(buf, sizeof(buf), "scene back after %lu ms (budget %lu ms)", ms, RESUME_BUDGET_MS);
+  check(ms <= RESUME_BUDGET_MS, buf);
+}
+
+int main() {
+  hostCosts.showUsPerLed = 30;
+  hostCosts.showLatchUs = 300;
+  hostCosts.flashWriteUsPerByte = FLASH_WRITE_US_PER_BYTE;
+  hostCosts.flashEraseUsPerBlock = FLASH_ERASE_US_PER_BLOCK;
+  hostSerialEcho(false);
+
+  printf("\n--- GAME JOURNAL TEST ---\n");
+  printf("Blank flash boots into MODE_OFF\n");
+  setup();
+  runMs(200);
+  check(currentMode == MODE_OFF, "starts in MODE_OFF");
+
+  printf("Round 1: reset after scoring\n");
+  press(CODE_1);
+  for (int i = 0; i < 3; i++) ball(0);
+  ball(2);
+  runMs(1000);
+  uint8_t rows[NUM_STRIPS_CONNECTED];
+  memcpy(rows, modeState.r1.rows, sizeof(rows));
+  reportResume(reboot(MODE_R1));
+  check(memcmp(rows, modeState.r1.rows, sizeof(rows)) == 0 && rows[0] == 3 && rows[2] == 1,
+        "rows per quadrant restored (3, 0, 1, 0)");
+  check(strips[0].getPixelColor(xyToIndex(8, 4)) != 0 && strips[0].getPixelColor(xyToIndex(8, 5)) == 0,
+        "jar in quadrant 0 drawn three rows high");
+
+  printf("Round 1: power cut partway through a checkpoint\n");
+  // A checkpoint takes one loop per record; cut after every whole record
+  // and in the middle of every record it writes
+  unsigned long cuts = 0, kept = 0;
+  for (long bytes = 0; bytes < JOURNAL_CHECKPOINT_RECORDS * JOURNAL_RECORD_BYTES; bytes += 2) {
+    journalCheckpoint();
+    hostFlashPowerFailAfter(bytes);
+    runMs(300);
+    reboot(MODE_R1);
+    cuts++;
+    if (currentMode == MODE_R1 && memcmp(rows, modeState.r1.rows, sizeof(rows)) == 0) kept++;
+  }
+  char cutBuf[96];
+  snprintf(cutBuf, sizeof(cutBuf), "rows kept after every cut (%lu of %lu)", kept, cuts);
+  check(kept == cuts, cutBuf);
+
+  printf("Round 2: reset after steady, flicker and lose\n");
+  press(CODE_2);
+  runMs(1500);
+  press(CODE_7); press(CODE_NEXT);   // top-right steady
+  press(CODE_8); press(CODE_PREV);   // top-left flicker
+  press(CODE_LOSE);                 // bottom-right lose (stops the flicker)
+  runMs(1000);
+  uint8_t kinds[NUM_STRIPS_CONNECTED];
+  for (int q = 0; q < NUM_STRIPS_CONNECTED; q++) kinds[q] = modeState.r2.effects[q].kind;
+  reportResume(reboot(MODE_R2));
+  bool same = true;
+  for (int q = 0; q < NUM_STRIPS_CONNECTED; q++) same &= modeState.r2.effects[q].kind == kinds[q];
+  check(same, "effect in every quadrant restored");
+
+  printf("Round 3: reset after moving the boundary\n");
+  press(CODE_3);
+  for (int i = 0; i < 5; i++) press(CODE_NEXT);
+  for (int i = 0; i < 2; i++) press(CODE_PREV);
+  runMs(500);
+  uint64_t green = modeState.r3.greenMask;
+  reportResume(reboot(MODE_R3));
+  check(modeState.r3.greenMask == green && modeState.r3.shownGreen == green, "boundary restored (21 blue columns)");
+
+  printf("Round 3: power cut halfway through writing a record\n");
+  press(CODE_NEXT);
+  runMs(300);
+  green = modeState.r3.greenMask;
+  hostFlashPowerFailAfter(2); // the next record only gets 2 of its 4 bytes
+  round3Next();
+  runMs(300);
+  reboot(MODE_R3);
+  check(modeState.r3.greenMask == green, "torn record skipped, last complete state restored");
+  press(CODE_NEXT);
+  runMs(300);
+  check(hostFlashBadWrites == 0, "writing carries on after the torn record");
+
+  printf("Endurance: 5000 boundary moves\n");
+  unsigned long erasesBefore = 0;
+  for (uint32_t b = 0; b < 4; b++) erasesBefore += hostFlashErases(b);
+  unsigned long slowLoops = 0, loops = 0, worstFlashUs = 0, worstWriteUs = 0;
+  for (int i = 0; i < 5000; i++) {
+    if ((i / 30) % 2 == 0) round3Next(); else round3Prev();
+    // Time this loop spent waiting for the data flash
+    unsigned long busy0 = hostFlashBusyUs;
+    loop();
+    unsigned long flashUs = hostFlashBusyUs - busy0;
+    if (flashUs > 1000) slowLoops++;
+    else if (flashUs > worstWriteUs) worstWriteUs = flashUs;
+    if (flashUs > worstFlashUs) worstFlashUs = flashUs;
+    loops++;
+  }
+  runMs(1000);
+  unsigned long erases[4], minErases = ~0UL, maxErases = 0, totalErases = 0;
+  for (uint32_t b = 0; b < 4; b++) {
+    erases[b] = hostFlashErases(b);
+    if (erases[b] < minErases) minErases = erases[b];
+    if (erases[b] > maxErases) maxErases = erases[b];
+    totalErases += erases[b];
+  }
+  printf("  erases per block: %lu %lu %lu %lu\n", erases[0], erases[1], erases[2], erases[3]);
+  printf("  loops waiting > 1 ms for flash: %lu of %lu, worst record write %.2f ms, worst loop %.1f ms\n",
+         slowLoops, loops, worstWriteUs / 1000.0, worstFlashUs / 1000.0);
+  check(maxErases - minErases <= 1, "erases spread evenly over the journal blocks");
+  check(hostFlashBadWrites == 0, "never programmed a byte that wasn't erased");
+  check(slowLoops <= totalErases - erasesBefore, "only loops that erased a block waited > 1 ms");
+  check(worstWriteUs <= 1000, "a record write costs the loop under 1 ms");
+  check(worstFlashUs <= FLASH_ERASE_US_PER_BLOCK, "worst loop does a single block erase, nothing more");
+  green = modeState.r3.greenMask;
+  reportResume(reboot(MODE_R3));
+  check(modeState.r3.greenMask == green, "boundary restored after wrapping the ring");
+
+  printf("MODE_OFF on purpose stays off\n");
+  press(CODE_0);
+  runMs(500);
+  reboot(MODE_OFF);
+  runMs(200);
+  check(currentMode == MODE_OFF, "no resume after switching off");
+
+  printf("Out-of-range records are ignored\n");
+  const uint8_t JOURNAL_MODE = 1, JOURNAL_R2_EFFECT = 3; // same values as journal.h
+  press(CODE_2);
+  runMs(500);
+  uint8_t bogus[2][JOURNAL_RECORD_BYTES] = {{JOURNAL_R2_EFFECT, 0, 99}, {JOURNAL_MODE, 0, 99}};
+  for (uint8_t* rec : bogus) {
+    rec[3] = journalCheck(rec[0], rec[1], rec[2]);
+    dataFlashWrite((uint32_t)journalHead * JOURNAL_RECORD_BYTES, rec, JOURNAL_RECORD_BYTES);
+    journalHead++;
+  }
+  reboot(MODE_R2);
+  check(currentMode == MODE_R2 && modeState.r2.effects[0].kind == 0, "mode 99 and effect 99 skipped");
+
+  return hostTestFinish("JOURNAL TEST");
+}
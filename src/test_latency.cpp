@@ -0,0 +1,146 @@
+// --- INPUT-TO-LIGHT LATENCY TEST (host only) ---
+// Runs the real game (src/main.cpp, built with LATENCY_TRACE) on the host
+// with show() charged at WS2812 wire speed, drops balls and presses remote
+// buttons, then types "lat" into the console and reads the same report
+// you'd get on the board:
+//   - the tracer's beam numbers agree with the true latency, which the
+//     host knows exactly (ball edge time -> end of that strip's show())
+//   - no input waits longer than its budget, so a slower loop, an extra
+//     show() or a longer settle delay fails here before it fails at a show
+//
+// Run with:  pio run -e test_latency -t exec
+// Prints the report, PASS/FAIL per check and exits non-zero if anything
+// failed.
+#include <HostTest.h>
+#include <Adafruit_NeoPixel.h>
+#include <string>
+#include "modestate.h"
+
+// --- From the game (src/main.cpp and the headers it pulls in) ---
+extern Adafruit_NeoPixel strips[NUM_STRIPS_CONNECTED];
+
+// Latency budgets: ball until its jar row starts to rise, and remote
+// button until its change is on every strip it touches
+const float BEAM_BUDGET_MS = 25;
+const float IR_BUDGET_MS = 250;
+
+const int BALLS = 24;
+// Longest Round 1 loop: delay(10) plus one strip's show() while a row rises
+const float LOOP_MS = 22;
+
+// How long each remote key gets before the next one
+const unsigned long KEY_MS = 400;
+
+// --- Balls: ball i breaks beam i % 4 at ballEdgeUs(i) for BALL_US ---
+const unsigned long BALL_GAP_US = 250000;
+const unsigned long BALL_US = 40000;
+unsigned long ballsStartUs = 0;
+
+// Spread the edges over the whole loop so some land right after a poll
+unsigned long ballEdgeUs(int i) {
+  return ballsStartUs + i * BALL_GAP_US + (unsigned long)(i * 3779) % 20000;
+}
+
+int beamPin(uint8_t pin, unsigned long nowUs) {
+  if (ballsStartUs == 0) return -1;
+  for (int i = 0; i < BALLS; i++) {
+    if (pin != BEAM_PINS[i % NUM_STRIPS_CONNECTED]) continue;
+    if (nowUs >= ballEdgeUs(i) && nowUs < ballEdgeUs(i) + BALL_US) return HIGH;
+  }
+  return LOW;
+}
+
+// --- True beam latency: edge -> end of the next show() of that strip ---
+int nextBall[4] = {0, 1, 2, 3};
+float trueWorstMs = 0;
+float trueBestMs = 1e9;
+
+void onShow(Adafruit_NeoPixel& strip, unsigned long, unsigned long endUs) {
+  if (ballsStartUs == 0) return;
+  for (int q = 0; q < NUM_STRIPS_CONNECTED; q++) {
+    if (&strip != &strips[q] || nextBall[q] >= BALLS) continue;
+    unsigned long edge = ballEdgeUs(nextBall[q]);
+    if (endUs <= edge) continue; // ball not there yet: some other redraw
+    nextBall[q] += NUM_STRIPS_CONNECTED;
+    float ms = (endUs - edge) / 1000.0f;
+    if (ms > trueWorstMs) trueWorstMs = ms;
+    if (ms < trueBestMs) trueBestMs = ms;
+  }
+}
+
+// --- Console output, so the test reads the same report a person would ---
+std::string serialOut;
+void onSerialByte(uint8_t c) { serialOut += (char)c; }
+
+// Pull "<input> n=N ... total ms: min A avg B max C" out of the report
+bool reportTotals(const char* input, unsigned long& n, float& minMs, float& avgMs, float& maxMs) {
+  std::string key = std::string(input) + " n=";
+  size_t at = serialOut.rfind(key);
+  if (at == std::string::npos) return false;
+  n = 0;
+  int got = sscanf(serialOut.c_str() + at + key.size(), "%lu timeouts=%*u total ms: min %f avg %f max %f",
+                   &n, &minMs, &avgMs, &maxMs);
+  return got == 4 || (got >= 1 && n == 0);
+}
+
+int main() {
+  hostCosts.showUsPerLed = 30;
+  hostCosts.showLatchUs = 300;
+  hostSerialEcho(false);
+  hostTestKeyMs = KEY_MS;
+  hostSetShowFn(onShow);
+  hostSetSerialFn(onSerialByte);
+  char buf[128];
+
+  printf("\n--- INPUT-TO-LIGHT LATENCY TEST ---\n");
+  setup();
+  runMs(200);
+
+  // Remote: switch modes (every strip redraws) and act inside the rounds
+  press(CODE_CH_MINUS);
+  press(CODE_2);
+  press(CODE_7); press(CODE_NEXT);   // top-right steady
+  press(CODE_8); press(CODE_PREV);   // top-left flicker
+  press(CODE_LOSE);                 // bottom-right lose
+  press(CODE_3);
+  for (int i = 0; i < 4; i++) press(CODE_NEXT);
+  press(CODE_1);
+  runMs(500);
+
+  // Balls at odd moments so they land all over the loop
+  ballsStartUs = hostNowUs() + 10000;
+  hostSetPinFn(beamPin);
+  runMs(BALLS * BALL_GAP_US / 1000 + 500);
+
+  printf("\nReport (typed \"lat\"):\n");
+  serialOut.clear();
+  hostSerialType("lat\n");
+  runMs(200);
+  fputs(serialOut.c_str(), stdout);
+  printf("\n");
+
+  unsigned long beamN = 0, irN = 0;
+  float beamMin = 0, beamAvg = 0, beamMax = 0, irMin = 0, irAvg = 0, irMax = 0;
+  bool parsed = reportTotals("beam", beamN, beamMin, beamAvg, beamMax) &&
+                reportTotals("ir", irN, irMin, irAvg, irMax);
+  check(parsed, "report printed for beam and IR");
+
+  snprintf(buf, sizeof(buf), "every ball traced (%lu of %d)", beamN, BALLS);
+  check(beamN == BALLS, buf);
+  snprintf(buf, sizeof(buf), "remote presses traced (%lu)", irN);
+  check(irN >= 10, buf);
+
+  // The tracer starts the clock at the last poll that saw the beam clear,
+  // so it may read up to one loop period high, never low
+  snprintf(buf, sizeof(buf), "tracer max %.1f ms vs true max %.1f ms (at most one loop high)", beamMax, trueWorstMs);
+  check(beamMax >= trueWorstMs - 0.1f && beamMax <= trueWorstMs + LOOP_MS, buf);
+  snprintf(buf, sizeof(buf), "tracer min %.1f ms vs true min %.1f ms", beamMin, trueBestMs);
+  check(beamMin >= trueBestMs - 0.1f, buf);
+
+  snprintf(buf, sizeof(buf), "beam worst %.1f ms (budget %.0f ms)", beamMax, BEAM_BUDGET_MS);
+  check(beamMax <= BEAM_BUDGET_MS, buf);
+  snprintf(buf, sizeof(buf), "IR worst %.1f ms (budget %.0f ms)", irMax, IR_BUDGET_MS);
+  check(irMax <= IR_BUDGET_MS, buf);
+
+  return hostTestFinish("LATENCY TEST");
+}
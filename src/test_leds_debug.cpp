@@ -0,0 +1,205 @@
+// --- LED BRING-UP BENCHMARK ---
+// Run this first on a new build of the honeycomb. It uses the game's own
+// strips, brightness and xyToIndex() (leds.h) and prints one table:
+//   - show() time per strip (min/avg/max) next to the WS2812 wire time it
+//     should take, so a strip that is slower than its LEDs stands out
+//   - a full frame (all strips back to back) and the frames per second
+//     that leaves the game
+//   - how long interrupts stay off: the NeoPixel library blocks them for
+//     the whole transfer, so the millis() clock loses ticks. The table
+//     shows how many per show().
+//   - the xyToIndex() mapping: every pixel has its own LED, nothing lands
+//     past LEDS_PER_QUAD, the serpentine turn LEDs are never used
+// Then it walks one green pixel through every quadrant, row by row from
+// the bottom left. Every row must run left to right (a row that runs
+// backwards means the serpentine mapping is wrong). The strip's last LED
+// is lit red the whole time: if it doesn't light, or isn't the last one on
+// the strip, LEDS_PER_QUAD doesn't match the strip.
+//
+// On the board: pio run -e test_leds_debug -t upload, then open the monitor.
+// On the host:  pio run -e test_leds_debug_host -t exec (show() charged at
+// wire speed with interrupts off by the shim; exits non-zero if a check
+// fails).
+#include <Arduino.h>
+#include "config.h"
+#include "leds.h"
+#if !defined(ARDUINO_ARCH_RENESAS)
+#include <HostShim.h>
+#endif
+
+const uint8_t SHOWS_PER_STRIP = 50;
+const uint8_t FRAMES = 20;
+const uint16_t WALK_STEP_MS = 20;
+
+// WS2812: 24 bits of 1.25 us per LED, then at least 280 us low to latch
+const float WIRE_US_PER_LED = 30.0f;
+const float WIRE_LATCH_US = 280.0f;
+// show() may take this much longer than the wire before it counts as slow
+const float SHOW_SLACK = 1.15f;
+
+#if defined(ARDUINO_ARCH_RENESAS)
+// Cycle counter: keeps counting while interrupts are off, unlike micros()
+void benchClockBegin() {
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+float benchNowUs() { return DWT->CYCCNT / (SystemCoreClock / 1000000.0f); }
+#else
+// The shim's WS2812 model loses millis() ticks like the board; its own
+// clock is the cycle counter
+void benchClockBegin() { hostUseWs2812Timing(); }
+float benchNowUs() { return (float)hostNowUs(); }
+#endif
+
+struct ShowTiming {
+  float minUs, maxUs, totalUs;
+  uint16_t count;
+  float lostMs; // millis() ticks lost while interrupts were off
+};
+
+int failures = 0;
+
+void timingAdd(ShowTiming& t, float us) {
+  if (t.count == 0 || us < t.minUs) t.minUs = us;
+  if (us > t.maxUs) t.maxUs = us;
+  t.totalUs += us;
+  t.count++;
+}
+
+// Fill strip q with a pattern that changes every call, so each show()
+// pushes a new frame
+void fillTestPattern(uint8_t q, uint8_t n) {
+  for (uint16_t i = 0; i < LEDS_PER_QUAD; i++) {
+    strips[q].setPixelColor(i, (i + n) % 3 == 0 ? 0xFF0000 : (i + n) % 3 == 1 ? 0x00FF00 : 0x0000FF);
+  }
+}
+
+// Show strips [first, last] `reps` times and time each pass
+ShowTiming timeShows(uint8_t first, uint8_t last, uint8_t reps) {
+  ShowTiming t = {0, 0, 0, 0, 0};
+  float startUs = benchNowUs();
+  unsigned long startMs = millis();
+  for (uint8_t n = 0; n < reps; n++) {
+    for (uint8_t q = first; q <= last; q++) fillTestPattern(q, n);
+    float us = benchNowUs();
+    for (uint8_t q = first; q <= last; q++) stripShow(q);
+    timingAdd(t, benchNowUs() - us);
+  }
+  float elapsedMs = (benchNowUs() - startUs) / 1000.0f;
+  t.lostMs = (elapsedMs - (millis() - startMs)) / reps;
+  if (t.lostMs < 0) t.lostMs = 0;
+  return t;
+}
+
+void printCell(float v, uint8_t width, uint8_t digits = 0) {
+  char buf[16];
+  snprintf(buf, sizeof(buf), "%*.*f", width, digits, v);
+  Serial.print(buf);
+}
+
+void printPadded(const char* s, uint8_t width) {
+  Serial.print(s);
+  for (uint8_t n = strlen(s); n < width; n++) Serial.print(' ');
+}
+
+// One table row; `strips` is how many strips one pass pushes
+void printRow(const char* name, const ShowTiming& t, uint8_t stripsPerPass) {
+  float wireUs = stripsPerPass * (LEDS_PER_QUAD * WIRE_US_PER_LED + WIRE_LATCH_US);
+  float avgUs = t.totalUs / t.count;
+  bool slow = avgUs > wireUs * SHOW_SLACK;
+  bool fast = avgUs < wireUs * 0.9f; // less than the wire needs: not really sent
+  if (slow || fast) failures++;
+
+  printPadded(name, 8);
+  printCell(stripsPerPass * LEDS_PER_QUAD, 6);
+  printCell(t.minUs, 9); printCell(avgUs, 9); printCell(t.maxUs, 9);
+  printCell(wireUs, 9);
+  printCell(1000000.0f / avgUs, 7, 1);
+  printCell(t.lostMs, 9, 2);
+  Serial.println(slow ? "  SLOW" : fast ? "  TOO FAST" : "  OK");
+}
+
+// xyToIndex() must give every visible pixel its own LED, stay inside the
+// strip and leave the rest (turn LEDs, spare row) unused
+void checkMapping() {
+  static bool used[LEDS_PER_QUAD];
+  memset(used, 0, sizeof(used));
+  uint16_t unique = 0, outside = 0, maxIndex = 0, gaps = 0;
+  for (uint8_t y = 0; y < QUAD_ROWS; y++) {
+    for (uint8_t x = 0; x < QUAD_COLS; x++) {
+      uint16_t i = xyToIndex(x, y);
+      if (i >= LEDS_PER_QUAD) { outside++; continue; }
+      if (!used[i]) unique++;
+      used[i] = true;
+      if (i > maxIndex) maxIndex = i;
+      // Neighbours in a row sit next to each other on the strip
+      if (x > 0) {
+        uint16_t prev = xyToIndex(x - 1, y);
+        if (i != prev + 1 && i + 1 != prev) gaps++;
+      }
+    }
+  }
+  uint16_t unused = LEDS_PER_QUAD - unique;
+  bool ok = unique == QUAD_ROWS * QUAD_COLS && outside == 0 && gaps == 0 &&
+            unused == LEDS_PER_QUAD - QUAD_ROWS * QUAD_COLS;
+  if (!ok) failures++;
+
+  Serial.print("xyToIndex: "); Serial.print(unique); Serial.print(" of ");
+  Serial.print(QUAD_ROWS * QUAD_COLS); Serial.print(" pixels unique, highest LED ");
+  Serial.print(maxIndex); Serial.print(" of "); Serial.print(LEDS_PER_QUAD);
+  Serial.print(", "); Serial.print(unused); Serial.print(" LEDs unused (turns and spare row), ");
+  Serial.print(outside); Serial.print(" outside the strip, ");
+  Serial.print(gaps); Serial.print(" gaps in a row");
+  Serial.println(ok ? "  OK" : "  WRONG");
+}
+
+void setup() {
+  Serial.begin(115200);
+  while (!Serial) delay(10);
+  benchClockBegin();
+
+  Serial.println("\n--- LED BRING-UP BENCHMARK ---");
+  ledsBegin();
+  Serial.print(NUM_STRIPS_CONNECTED); Serial.print(" strips of ");
+  Serial.print(LEDS_PER_QUAD); Serial.print(" LEDs (");
+  Serial.print(PHYS_ROWS); Serial.print('x'); Serial.print(PHYS_COLS);
+  Serial.print("), brightness "); Serial.println(params.brightness);
+  checkMapping();
+
+  Serial.println("\nbackend: Adafruit_NeoPixel show(), one strip after another");
+  Serial.println("pass      leds   min us   avg us   max us  wire us    fps  lost ms");
+  char name[8];
+  ShowTiming t;
+  for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) {
+    t = timeShows(q, q, SHOWS_PER_STRIP);
+    snprintf(name, sizeof(name), "strip%u", q);
+    printRow(name, t, 1);
+  }
+  t = timeShows(0, NUM_STRIPS_CONNECTED - 1, FRAMES);
+  printRow("frame", t, NUM_STRIPS_CONNECTED);
+  Serial.println("(fps: shows per second with nothing else running; lost ms: millis()");
+  Serial.println(" ticks missed per pass while interrupts were off)");
+  Serial.println(failures ? "--- LED CHECKS FAILED ---" : "--- LED CHECKS PASSED ---");
+
+  Serial.println("\nWalking one pixel through every row (each row left to right)...");
+  ledsAllOff();
+}
+
+void loop() {
+  for (uint8_t y = 0; y < QUAD_ROWS; y++) {
+    for (uint8_t x = 0; x < QUAD_COLS; x++) {
+      for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) {
+        strips[q].clear();
+        strips[q].setPixelColor(LEDS_PER_QUAD - 1, 0xFF0000); // end-of-strip marker
+        strips[q].setPixelColor(xyToIndex(x, y), 0x00FF00);
+        stripShow(q);
+      }
+      delay(WALK_STEP_MS);
+    }
+  }
+  Serial.println("Walk done, starting again");
+#if !defined(ARDUINO_ARCH_RENESAS)
+  exit(failures ? 1 : 0);
+#endif
+}
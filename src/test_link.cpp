@@ -0,0 +1,271 @@
+// --- MULTI-BOARD LINK TEST (host only) ---
+// Runs the real game as a link leader (src/main.cpp built with
+// LINK_ROLE=LINK_LEADER) and forks one process per follower board, the
+// way they are wired on the wall: the leader's Serial1 and LINK_SYNC_PIN
+// go down a pipe to every follower (HostShim.h, BOARD LINK). The
+// followers run the follower firmware (linkFollowerService(), link.h)
+// with show() at WS2812 speed and write down every show() they do.
+// After a short show through every round it checks that:
+//   - every frame the leader latched reached the followers pixel for pixel
+//   - each follower ends up with exactly what the leader thinks it has
+//   - no link byte was lost while a follower had interrupts off, no packet
+//     was damaged and no sync was missed
+//   - the followers latch within LINK_SKEW_BUDGET_US of each other
+//   - no remote key was garbled: the leader never masks interrupts now
+// and prints the link's bandwidth per scene and the sync skew.
+//
+// Run with:  pio run -e test_link -t exec
+// Prints PASS/FAIL per check and exits non-zero if anything failed.
+#include <HostTest.h>
+#include <Adafruit_NeoPixel.h>
+#include <map>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+#include "config.h"
+#include "link_protocol.h"
+
+// --- From the game (src/main.cpp and the headers it pulls in) ---
+extern Adafruit_NeoPixel strips[NUM_STRIPS_CONNECTED];
+extern uint8_t linkShown[NUM_STRIPS_CONNECTED][LEDS_PER_QUAD * 3];
+extern uint8_t linkPending;
+extern uint16_t linkFrame;
+extern uint8_t linkFrameMask;
+extern uint32_t linkSyncUs;
+extern LinkStats linkStats;
+void linkFollowerBegin(uint8_t board);
+void linkFollowerService();
+extern uint16_t linkShowingFrame;
+extern LinkFollowerStats linkFollowerStats;
+
+// Followers poll the sync pin every LINK_SYNC_POLL_US (link.h): allow a
+// few polls between the first and the last to see it
+const unsigned long LINK_SKEW_BUDGET_US = 10;
+
+uint64_t pixelHash(const uint8_t* px) {
+  uint64_t h = 1469598103934665603ULL; // FNV-1a
+  for (uint16_t i = 0; i < LEDS_PER_QUAD * 3; i++) h = (h ^ px[i]) * 1099511628211ULL;
+  return h;
+}
+
+// --- FOLLOWER PROCESS ---
+FILE* followerReport = nullptr;
+
+void onFollowerShow(Adafruit_NeoPixel& strip, unsigned long startUs, unsigned long) {
+  fprintf(followerReport, "show %u %d %lu %016llx\n", linkShowingFrame, (int)(&strip - strips), startUs,
+          (unsigned long long)pixelHash(strip.getPixels()));
+}
+
+void runFollower(uint8_t board, int linkFd, FILE* report) {
+  followerReport = report;
+  hostUseWs2812Timing();
+  hostSerialEcho(false);
+  hostLinkInput(linkFd);
+  hostLinkPin(LINK_SYNC_PIN);
+  hostSetShowFn(onFollowerShow);
+  linkFollowerBegin(board);
+  while (!hostLinkEnded()) linkFollowerService();
+  for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) {
+    if (LINK_QUAD_BOARD[q] != board) continue;
+    fprintf(report, "final %u %016llx\n", q, (unsigned long long)pixelHash(strips[q].getPixels()));
+  }
+  fprintf(report, "stats %lu %lu %lu %lu %lu\n", hostLinkRxLost, (unsigned long)linkFollowerStats.frames,
+          (unsigned long)linkFollowerStats.badPackets, (unsigned long)linkFollowerStats.missedSyncs,
+          (unsigned long)linkFollowerStats.maxSyncWaitUs);
+  fclose(report);
+  _exit(0);
+}
+
+// --- LEADER ---
+struct Follower {
+  uint8_t board;
+  pid_t pid;
+  FILE* report;
+};
+
+// A frame the leader sent, with the pixels it meant (only frames latched
+// at the end of a loop with nothing drawn since, so the buffers still
+// hold them)
+struct SentFrame {
+  uint32_t syncUs;
+  uint8_t mask;
+  uint64_t hash[NUM_STRIPS_CONNECTED];
+};
+std::map<uint16_t, SentFrame> sentFrames;
+
+uint16_t lastSentFrame = 0;
+
+void recordSentFrame() {
+  if (linkFrame == lastSentFrame || linkPending) return;
+  lastSentFrame = linkFrame;
+  SentFrame f = {linkSyncUs, linkFrameMask, {}};
+  for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) f.hash[q] = pixelHash(strips[q].getPixels());
+  sentFrames[linkFrame] = f;
+}
+
+void playIntro() { press(CODE_CH_MINUS); runMs(3000); }
+
+void playRound1() {
+  press(CODE_1);
+  for (int i = 0; i < 40; i++) {
+    uint8_t pin = BEAM_PINS[i % 4];
+    hostSetPin(pin, HIGH); runMs(40);
+    hostSetPin(pin, LOW);  runMs(60);
+  }
+  runMs(1000);
+}
+
+void playRound2() {
+  press(CODE_2);
+  press(CODE_7); press(CODE_NEXT);   // top-right steady
+  press(CODE_8); press(CODE_PREV);   // top-left flicker
+  runMs(2000);
+  press(CODE_LOSE);                 // bottom-right lose
+  runMs(1500);
+}
+
+void playRound3() {
+  press(CODE_3);
+  for (int i = 0; i < 10; i++) press(CODE_NEXT);
+  for (int i = 0; i < 5; i++) press(CODE_PREV);
+  runMs(2000);
+}
+
+void playFinale() { press(CODE_5); runMs(3000); }
+
+// One line of the bandwidth table: what the link carried during `play`
+void scene(const char* name, void (*play)()) {
+  LinkStats before = linkStats;
+  unsigned long startMs = millis();
+  linkStats.maxFrameBytes = 0;
+  play();
+  float secs = (millis() - startMs) / 1000.0f;
+  uint32_t bytes = linkStats.bytes - before.bytes, raw = linkStats.rawBytes - before.rawBytes;
+  printf("  %-8s %5lu frames  %7.1f kB  %5.1f%% of the wire  %5.1f%% of plain pixels  largest %5u B  waited %5lu ms\n",
+         name, (unsigned long)(linkStats.frames - before.frames), bytes / 1000.0f,
+         bytes * 1000.0f / LINK_BAUD / secs, raw ? 100.0f * bytes / raw : 0.0f, linkStats.maxFrameBytes,
+         (unsigned long)(linkStats.waitUs - before.waitUs) / 1000);
+  if (before.maxFrameBytes > linkStats.maxFrameBytes) linkStats.maxFrameBytes = before.maxFrameBytes;
+}
+
+int main() {
+  uint8_t boards = 0;
+  for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) boards = max(boards, LINK_QUAD_BOARD[q]);
+
+  // Every pipe first, then the followers, so each one closes all the
+  // write ends and sees the link end when the leader closes it
+  std::vector<int> readFds, writeFds;
+  for (uint8_t b = 0; b < boards; b++) {
+    int fds[2];
+    if (pipe(fds) != 0) { perror("pipe"); return 1; }
+    readFds.push_back(fds[0]);
+    writeFds.push_back(fds[1]);
+  }
+  std::vector<Follower> followers;
+  fflush(stdout);
+  for (uint8_t b = 0; b < boards; b++) {
+    FILE* report = tmpfile();
+    pid_t pid = fork();
+    if (pid < 0) { perror("fork"); return 1; }
+    if (pid == 0) {
+      for (uint8_t i = 0; i < boards; i++) {
+        close(writeFds[i]);
+        if (i != b) close(readFds[i]);
+      }
+      runFollower(b + 1, readFds[b], report);
+    }
+    followers.push_back({(uint8_t)(b + 1), pid, report});
+  }
+  for (uint8_t b = 0; b < boards; b++) {
+    close(readFds[b]);
+    hostLinkOutput(writeFds[b]);
+  }
+
+  printf("\n--- MULTI-BOARD LINK TEST (%u followers, %lu baud) ---\n", boards, LINK_BAUD);
+  hostUseWs2812Timing();
+  hostSerialEcho(false);
+  hostLinkPin(LINK_SYNC_PIN);
+  hostTestEachLoop = recordSentFrame;
+  setup();
+  runMs(500);
+  scene("Intro", playIntro);
+  scene("Round 1", playRound1);
+  scene("Round 2", playRound2);
+  scene("Round 3", playRound3);
+  scene("Finale", playFinale);
+  unsigned long irCorrupted = hostIrCorrupted;
+  hostLinkClose();
+
+  // --- What the followers saw ---
+  std::map<uint16_t, std::map<uint8_t, unsigned long>> firstShowUs; // frame -> board -> start
+  std::map<uint32_t, uint64_t> shownHash;                          // frame << 8 | quad -> pixels
+  unsigned long rxLost = 0, bad = 0, missed = 0, maxWait = 0, worstSyncToShow = 0;
+  bool finalsMatch = true, statsSeen = true;
+  for (Follower& f : followers) {
+    waitpid(f.pid, nullptr, 0);
+    rewind(f.report);
+    char kind[8];
+    bool gotStats = false;
+    while (fscanf(f.report, "%7s", kind) == 1) {
+      if (strcmp(kind, "show") == 0) {
+        unsigned frame; int q; unsigned long startUs; unsigned long long h;
+        if (fscanf(f.report, "%u %d %lu %llx", &frame, &q, &startUs, &h) != 4) break;
+        if (frame == 0) continue; // linkFollowerBegin() clearing the strips
+        shownHash[frame << 8 | q] = h;
+        std::map<uint8_t, unsigned long>& starts = firstShowUs[frame];
+        if (starts.count(f.board)) continue; // its next quadrant, after the first
+        starts[f.board] = startUs;
+        auto sent = sentFrames.find(frame);
+        if (sent != sentFrames.end()) worstSyncToShow = max(worstSyncToShow, startUs - sent->second.syncUs);
+      } else if (strcmp(kind, "final") == 0) {
+        unsigned q; unsigned long long h;
+        if (fscanf(f.report, "%u %llx", &q, &h) != 2) break;
+        if (q < NUM_STRIPS_CONNECTED && h != pixelHash(linkShown[q])) finalsMatch = false;
+      } else if (strcmp(kind, "stats") == 0) {
+        unsigned long lost, frames, badPackets, missedSyncs, wait;
+        if (fscanf(f.report, "%lu %lu %lu %lu %lu", &lost, &frames, &badPackets, &missedSyncs, &wait) != 5) break;
+        rxLost += lost; bad += badPackets; missed += missedSyncs; maxWait = max(maxWait, wait);
+        printf("  follower %u: %lu frames shown, longest wait for a sync %lu us\n", f.board, frames, wait);
+        gotStats = true;
+      }
+    }
+    if (!gotStats) statsSeen = false;
+  }
+
+  unsigned long checked = 0, wrong = 0;
+  for (const auto& sent : sentFrames) {
+    for (uint8_t q = 0; q < NUM_STRIPS_CONNECTED; q++) {
+      if (!(sent.second.mask & (1 << q))) continue;
+      checked++;
+      auto shown = shownHash.find((uint32_t)sent.first << 8 | q);
+      if (shown == shownHash.end() || shown->second != sent.second.hash[q]) wrong++;
+    }
+  }
+  unsigned long maxSkew = 0, skewFrames = 0;
+  for (const auto& frame : firstShowUs) {
+    if (frame.second.size() < 2) continue;
+    unsigned long lo = ~0UL, hi = 0;
+    for (const auto& b : frame.second) { lo = min(lo, b.second); hi = max(hi, b.second); }
+    maxSkew = max(maxSkew, hi - lo);
+    skewFrames++;
+  }
+
+  printf("\n  %lu frames, %lu latched by more than one board: sync skew up to %lu us, "
+         "sync to show up to %lu us\n", (unsigned long)linkStats.frames, skewFrames, maxSkew, worstSyncToShow);
+  printf("  %lu quadrant frames checked pixel for pixel\n\n", checked);
+  char what[96];
+  check(statsSeen, "every follower ran to the end of the link");
+  snprintf(what, sizeof(what), "every checked frame reached its follower intact (%lu wrong)", wrong);
+  check(checked > 0 && wrong == 0, what);
+  check(finalsMatch, "followers end with exactly what the leader sent");
+  snprintf(what, sizeof(what), "no link byte lost to a follower's show() (%lu lost)", rxLost);
+  check(rxLost == 0, what);
+  snprintf(what, sizeof(what), "no damaged packets, no missed syncs (%lu, %lu)", bad, missed);
+  check(bad == 0 && missed == 0, what);
+  snprintf(what, sizeof(what), "followers latch within %lu us of each other (%lu us)", LINK_SKEW_BUDGET_US, maxSkew);
+  check(skewFrames > 0 && maxSkew <= LINK_SKEW_BUDGET_US, what);
+  snprintf(what, sizeof(what), "no remote key garbled on the leader (%lu)", irCorrupted);
+  check(irCorrupted == 0, what);
+
+  return hostTestFinish("LINK TEST");
+}
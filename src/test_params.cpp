@@ -0,0 +1,152 @@
+// --- TUNABLE PARAMETER TEST (host only) ---
+// Runs the real game (src/main.cpp is built into this environment too) on
+// the host and types console commands into its Serial input while rounds
+// are running:
+//   - "set" changes timings and brightness straight away, mid-round
+//   - values outside the allowed range, or a min above its max, are refused
+//   - "list" never holds up the loop, even on a slow 9600 baud link
+//   - "save" survives a reset, "forget" and "defaults" go back to the
+//     built-in values
+//
+// Run with:  pio run -e test_params -t exec
+// Prints PASS/FAIL per check and exits non-zero if anything failed.
+#include <HostTest.h>
+#include <Adafruit_NeoPixel.h>
+#include "modestate.h"
+
+// --- From the game (src/main.cpp and the headers it pulls in) ---
+extern Mode currentMode;
+extern Adafruit_NeoPixel strips[NUM_STRIPS_CONNECTED];
+
+// Same value as config.h (EffectKind comes with modestate.h)
+const uint8_t DEFAULT_BRIGHTNESS = 50;
+
+// Type a command into the Serial Monitor and give the game time to run it
+void type(const char* line) {
+  hostSerialType(line);
+  hostSerialType("\n");
+  runMs(50);
+}
+
+// Power cut: RAM and LEDs are gone, the data flash is not
+void reboot() {
+  memset(&modeState, 0, sizeof(modeState));
+  currentMode = MODE_OFF;
+  activeMode = MODE_OFF;
+  activeModeEntered = true;
+  for (int q = 0; q < NUM_STRIPS_CONNECTED; q++) strips[q].clear();
+  setup();
+  runMs(200);
+}
+
+// Time from CODE_LOSE until the red X is up, in ms
+unsigned long loseSequenceMs() {
+  hostIrSend(CODE_LOSE);
+  unsigned long start = 0, deadline = millis() + 5000;
+  while (millis() < deadline) {
+    loop();
+    uint8_t kind = modeState.r2.effects[Q_BOTTOM_RIGHT].kind;
+    if (start == 0 && kind != EFFECT_LOST && kind != 0) start = millis();
+    if (start && kind == EFFECT_LOST) return millis() - start;
+  }
+  return 0;
+}
+
+// Toggles of the top-left flicker during `ms`
+unsigned long flickerToggles(unsigned long ms) {
+  unsigned long toggles = 0, end = millis() + ms;
+  uint8_t last = modeState.r2.effects[Q_TOP_LEFT].phase;
+  while (millis() < end) {
+    loop();
+    uint8_t phase = modeState.r2.effects[Q_TOP_LEFT].phase;
+    if (phase != last) toggles++;
+    last = phase;
+  }
+  return toggles;
+}
+
+int main() {
+  hostCosts.showUsPerLed = 30;
+  hostCosts.showLatchUs = 300;
+  hostSerialEcho(false);
+  char buf[96];
+
+  printf("\n--- TUNABLE PARAMETER TEST ---\n");
+  setup();
+  runMs(200);
+  check(strips[0].getBrightness() == DEFAULT_BRIGHTNESS, "boots with the built-in brightness");
+
+  printf("Round 2: lose sequence timing\n");
+  press(CODE_2);
+  runMs(1500);
+  unsigned long before = loseSequenceMs();
+  type("set lose_toggle_ms 100");
+  type("set lose_toggles 6");
+  unsigned long after = loseSequenceMs();
+  snprintf(buf, sizeof(buf), "10 x 50 ms took %lu ms, 6 x 100 ms took %lu ms", before, after);
+  check(before >= 450 && before <= 550 && after >= 550 && after <= 650, buf);
+
+  printf("Round 2: flicker speed\n");
+  press(CODE_8); press(CODE_PREV);
+  check(modeState.r2.effects[Q_TOP_LEFT].kind == EFFECT_FLICKER, "top-left is flickering");
+  unsigned long slow = flickerToggles(3000);
+  type("set flicker_min_ms 50");
+  type("set flicker_max_ms 60");
+  unsigned long fast = flickerToggles(3000);
+  snprintf(buf, sizeof(buf), "toggles in 3 s: %lu at 300-600 ms, %lu at 50-60 ms", slow, fast);
+  check(slow >= 4 && slow <= 10 && fast >= 5 * slow, buf);
+  type("set flicker_min_ms 100");
+  type("set flicker_max_ms 40");
+  unsigned long still = flickerToggles(3000);
+  snprintf(buf, sizeof(buf), "min above max refused either way round (%lu toggles in 3 s)", still);
+  check(still >= 5 * slow, buf);
+
+  printf("Brightness\n");
+  type("set brightness 120");
+  check(strips[0].getBrightness() == 120 && strips[3].getBrightness() == 120, "applied to every strip straight away");
+  type("set brightness 300");
+  type("set brightness");
+  type("set brightness 12x");
+  type("set no_such_thing 5");
+  type("set lose_toggles 1");
+  check(strips[0].getBrightness() == 120, "out-of-range and malformed values refused");
+
+  printf("Listing on a 9600 baud link\n");
+  press(CODE_0);
+  hostCosts.serialAtBaud = true;
+  hostCosts.serialFifoBytes = 64;
+  Serial.begin(9600);
+  hostSerialType("list\n");
+  unsigned long worstLoopUs = 0, end = millis() + 2000;
+  while (millis() < end) {
+    unsigned long t0 = hostNowUs();
+    loop();
+    if (hostNowUs() - t0 > worstLoopUs) worstLoopUs = hostNowUs() - t0;
+  }
+  snprintf(buf, sizeof(buf), "worst loop while listing %.1f ms", worstLoopUs / 1000.0);
+  check(worstLoopUs < 12000, buf);
+  hostCosts.serialAtBaud = false;
+
+  printf("Save, reset, forget\n");
+  type("save");
+  reboot();
+  check(strips[0].getBrightness() == 120, "saved brightness back after a reset");
+  press(CODE_2);
+  runMs(1500);
+  after = loseSequenceMs();
+  snprintf(buf, sizeof(buf), "saved lose timing back after a reset (%lu ms)", after);
+  check(after >= 550 && after <= 650, buf);
+  type("set brightness 90");
+  type("save");
+  reboot();
+  check(strips[0].getBrightness() == 90, "second save (other slot) wins after a reset");
+  type("defaults");
+  check(strips[0].getBrightness() == DEFAULT_BRIGHTNESS, "defaults apply straight away");
+  reboot();
+  check(strips[0].getBrightness() == 90, "defaults alone don't touch the saved copy");
+  type("forget");
+  reboot();
+  check(strips[0].getBrightness() == DEFAULT_BRIGHTNESS, "forget: built-in values after a reset");
+
+  return hostTestFinish("PARAMETER TEST");
+}
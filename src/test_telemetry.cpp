@@ -0,0 +1,141 @@
+// --- TELEMETRY TEST (host only) ---
+// Runs the real game (src/main.cpp is built into this environment too) on
+// the host with Serial charged like the UNO R4 WiFi's UART (real speed,
+// write() waits, availableForWrite() always 0), captures every
+// byte it sends and decodes it with the same decoder as
+// decode_telemetry:
+//   - points, mode switches and Round 2 actions come back as records with
+//     the right arguments and timestamps
+//   - a loop never waits for the UART for more than a couple of records
+//   - beam records are compiled out at the default log level
+//   - a flood of events drops records cleanly and says how many
+//   - "list" still prints, a line per loop
+//
+// Run with:  pio run -e test_telemetry -t exec
+// Prints PASS/FAIL per check and exits non-zero if anything failed.
+#include <HostTest.h>
+#include <vector>
+#include "modestate.h"
+#include "feed_decode.h"
+#include "telemetry_decode.h"
+
+// --- From the game (src/main.cpp and the headers it pulls in) ---
+void telemetryLog(uint8_t event, uint16_t arg);
+
+const uint32_t KEY_STRAY = 0xF807FF00; // not mapped to anything
+
+// "Point for Quad 0" + CRLF at 9600 baud: what one point used to cost
+const unsigned long OLD_POINT_PRINT_US = 18 * 10000000UL / 9600;
+
+struct Record {
+  uint32_t ms;
+  uint8_t event;
+  uint16_t arg;
+};
+
+std::vector<Record> records;
+TelemetryDecoder decoder = {};
+
+void onRecord(uint32_t ms, uint8_t event, uint16_t arg) { records.push_back({ms, event, arg}); }
+unsigned long textLines = 0;
+void onText(uint8_t c) { textLines += c == '\n'; }
+void onTelemetryByte(uint8_t c) { telemetryDecodeByte(decoder, c, onRecord, onText); }
+// The state feed (feed.h) shares the stream: take its records out first
+FeedDecoder feedDecoder = {};
+void onFeedRecord(const FeedDecoder&, uint16_t, uint8_t, const uint8_t*, uint8_t) {}
+void onSerialByte(uint8_t c) { feedDecodeByte(feedDecoder, c, onFeedRecord, onTelemetryByte); }
+
+unsigned long worstBlockedUs = 0;
+
+unsigned long blockedBefore = 0;
+
+void trackBlocking() {
+  unsigned long blocked = hostSerialBlockedUs - blockedBefore;
+  if (blocked > worstBlockedUs) worstBlockedUs = blocked;
+  blockedBefore = hostSerialBlockedUs;
+}
+
+size_t countEvent(uint8_t event) {
+  size_t n = 0;
+  for (const Record& r : records) n += r.event == event;
+  return n;
+}
+
+int main() {
+  hostCosts.serialAtBaud = true;
+  hostCosts.serialFifoBytes = 0; // R4 UART write() blocks until sent
+  hostSerialEcho(false);
+  hostSetSerialFn(onSerialByte);
+  hostTestEachLoop = trackBlocking;
+  char buf[112];
+
+  printf("\n--- TELEMETRY TEST ---\n");
+  setup();
+  runMs(200);
+
+  printf("Round 1: points\n");
+  press(CODE_1);
+  worstBlockedUs = 0;
+  unsigned long hitAt[3];
+  hitAt[0] = ball(0);
+  hitAt[1] = ball(2);
+  hitAt[2] = ball(0);
+  runMs(500);
+  std::vector<Record> points;
+  for (const Record& r : records) if (r.event == TEV_POINT) points.push_back(r);
+  check(points.size() == 3, "three point records");
+  bool argsOk = points.size() == 3 && points[0].arg == (0 | 1 << 8) && points[1].arg == (2 | 1 << 8) &&
+                points[2].arg == (0 | 2 << 8);
+  check(argsOk, "quad and rows decoded (0/1, 2/1, 0/2)");
+  bool timesOk = points.size() == 3;
+  for (size_t i = 0; timesOk && i < 3; i++) timesOk = points[i].ms >= hitAt[i] && points[i].ms <= hitAt[i] + 20;
+  check(timesOk, "timestamps within 20 ms of the ball");
+  snprintf(buf, sizeof(buf), "worst loop waits %.2f ms for the UART (text at 9600 baud: %.2f ms per point)",
+           worstBlockedUs / 1000.0, OLD_POINT_PRINT_US / 1000.0);
+  check(worstBlockedUs <= 2 * TELEMETRY_FRAME_BYTES * 10000000UL / 115200 + 100, buf);
+  check(countEvent(TEV_BEAM) == 0, "beam records compiled out at LOG_LEVEL_INFO");
+
+  printf("Mode switches and Round 2\n");
+  press(CODE_2);
+  press(CODE_8);
+  press(CODE_LOSE);
+  press(KEY_STRAY);
+  runMs(1000);
+  std::vector<uint16_t> modes;
+  for (const Record& r : records) if (r.event == TEV_MODE) modes.push_back(r.arg);
+  check(modes.size() == 2 && modes[0] == MODE_R1 && modes[1] == MODE_R2, "mode switches to R1 then R2");
+  check(countEvent(TEV_ROUND_OVER) == NUM_STRIPS_CONNECTED, "round over: one record per quad");
+  check(countEvent(TEV_R2_ARMED) == 1 && countEvent(TEV_R2_LOSE) == 1, "flicker armed and lose started");
+  check(countEvent(TEV_UNKNOWN_KEY) == 1 && records.back().arg == (KEY_STRAY >> 16), "unknown key reported");
+  bool ordered = true;
+  for (size_t i = 1; i < records.size(); i++) ordered &= records[i].ms >= records[i - 1].ms;
+  check(ordered, "timestamps never go backwards");
+
+  printf("Flood: 100 records in one loop\n");
+  size_t before = records.size();
+  for (int i = 0; i < 100; i++) telemetryLog(TEV_MODE, MODE_R2);
+  runMs(300);
+  telemetryLog(TEV_MODE, MODE_R3); // the next record reports the loss first
+  runMs(300);
+  size_t kept = 0;
+  uint16_t lost = 0;
+  for (size_t i = before; i < records.size(); i++) {
+    if (records[i].event == TEV_DROPPED) lost = records[i].arg;
+    else kept++;
+  }
+  snprintf(buf, sizeof(buf), "%zu kept + %u reported lost = 101", kept, lost);
+  check(kept + lost == 101 && lost > 0, buf);
+  check(decoder.bad == 0, "no damaged records in the stream");
+
+  // This UART's availableForWrite() is always 0 (serial_room.h)
+  printf("Console listing\n");
+  textLines = 0;
+  worstBlockedUs = 0;
+  hostSerialType("list\n");
+  runMs(1000);
+  snprintf(buf, sizeof(buf), "every parameter listed (%lu lines), worst loop waits %.2f ms", textLines,
+           worstBlockedUs / 1000.0);
+  check(textLines >= 16 && worstBlockedUs < 8000, buf);
+
+  return hostTestFinish("TELEMETRY TEST");
+}
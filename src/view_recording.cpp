@@ -0,0 +1,509 @@
+// --- RECORDING VIEWER (host only) ---
+// Plays back a frame recording (made with run_scenarios --record, format in
+// lib/HostShim/HostRecording.h) as the whole 36x36 board, three ways:
+//
+//   view_recording show.hrec                  replay in the terminal
+//   view_recording show.hrec --png strip.png  film strip: one picture every
+//                                             --every ms, 10 to a row
+//   view_recording show.hrec --gif show.gif   animation, --fps pictures per
+//                                             simulated second
+//
+//   --from S --to S   only this part of the run (seconds)
+//   --speed X         terminal replay speed (default 1 = real time)
+//   --every MS        film strip spacing (default 250)
+//   --fps N           GIF pictures per second (default 10)
+//   --scale N         image pixels per LED (default 4)
+//   --gain G          multiply LED values by G (default: brightest LED in the
+//                     recording becomes full white, since the strips run dim)
+//
+// Every picture comes with what happened since the previous one: the
+// show() calls (how many, how long on the wire, LEDs changed) and the
+// inputs and checks. In the terminal these are text lines under the board;
+// in PNG/GIF a bar under each picture shows the share of time spent in
+// show() (red) and ticks mark the inputs (yellow remote key, cyan ball,
+// magenta typed command, green/red check). The film strip's legend is
+// printed as text.
+//
+// Build: pio run -e view_recording, then run .pio/build/view_recording/program
+#include <HostShim.h>
+#include <HostRecording.h>
+#include <algorithm>
+#include <string>
+#include <unistd.h>
+#include <vector>
+#include "config.h"
+
+const int BOARD = 2 * QUAD_COLS;   // 36 LEDs each way
+const int BAR_H = 3;               // image rows per overlay bar
+const int CELLS_PER_ROW = 10;      // film strip
+const int TERMINAL_FPS = 30;
+const int EVENT_LINES = 4;         // terminal: recent inputs shown
+
+// Where each quadrant sits on the board (column, row of its top-left corner)
+const uint8_t QUAD_ORIGIN[4][2] = {
+  {0, 0},                  // Q_TOP_LEFT
+  {QUAD_COLS, 0},          // Q_TOP_RIGHT
+  {QUAD_COLS, QUAD_ROWS},  // Q_BOTTOM_RIGHT
+  {0, QUAD_ROWS},          // Q_BOTTOM_LEFT
+};
+
+// --- LOADING ---
+struct Frame {
+  uint64_t us;
+  uint8_t strip;
+  uint32_t showUs;
+  uint16_t changed;
+  size_t at, len; // spans in Recording::blob
+};
+
+struct Event {
+  uint64_t us;
+  std::string text;
+};
+
+struct Recording {
+  std::vector<HostRecStrip> strips;
+  std::vector<int> quadOf; // quadrant of each strip (by pin), -1 if none
+  std::vector<Frame> frames;
+  std::vector<uint8_t> blob;
+  std::vector<Event> events;
+  uint64_t endUs = 0;
+  uint8_t peak = 0; // brightest channel value
+};
+
+bool load(const char* path, Recording& rec) {
+  HostRecReader r;
+  if (!r.open(path)) {
+    printf("%s: not a frame recording\n", path);
+    return false;
+  }
+  for (int tag; (tag = r.next()) > 0;) {
+    if (tag == HOST_REC_FRAME) {
+      rec.frames.push_back({r.frameUs, r.strip, r.showUs, r.changed, rec.blob.size(), r.spans.size()});
+      rec.blob.insert(rec.blob.end(), r.spans.begin(), r.spans.end());
+      for (size_t at = 0; at + 4 <= r.spans.size();) {
+        size_t end = at + 4 + (r.spans[at + 2] | r.spans[at + 3] << 8) * 3;
+        for (at += 4; at < end && at < r.spans.size(); at++) rec.peak = std::max(rec.peak, r.spans[at]);
+      }
+      rec.endUs = std::max(rec.endUs, r.frameUs + r.showUs);
+    } else if (tag == HOST_REC_EVENT) {
+      rec.events.push_back({r.eventUs, r.eventText});
+      rec.endUs = std::max(rec.endUs, r.eventUs);
+    }
+  }
+  rec.strips = r.strips;
+  for (const HostRecStrip& s : rec.strips) {
+    int q = -1;
+    for (int i = 0; i < NUM_STRIPS_CONNECTED; i++) {
+      if (LED_PINS[i] == s.pin) q = i;
+    }
+    rec.quadOf.push_back(s.leds == LEDS_PER_QUAD ? q : -1);
+  }
+  std::stable_sort(rec.events.begin(), rec.events.end(),
+                   [](const Event& a, const Event& b) { return a.us < b.us; });
+  return true;
+}
+
+// --- PLAYBACK ---
+// What happened between two pictures
+struct Window {
+  uint64_t fromUs, toUs;
+  unsigned shows = 0;
+  uint64_t showUs = 0;
+  uint32_t maxShowUs = 0;
+  unsigned long changed = 0;
+  std::vector<const Event*> events;
+};
+
+struct Player {
+  const Recording& rec;
+  std::vector<HostRecStrip> strips;
+  size_t nextFrame = 0, nextEvent = 0;
+  uint64_t atUs = 0;
+
+  explicit Player(const Recording& r) : rec(r), strips(r.strips) {}
+
+  // Apply every frame up to `toUs` and say what happened on the way
+  Window advance(uint64_t toUs) {
+    Window w;
+    w.fromUs = atUs;
+    w.toUs = toUs;
+    for (; nextFrame < rec.frames.size() && rec.frames[nextFrame].us <= toUs; nextFrame++) {
+      const Frame& f = rec.frames[nextFrame];
+      hostRecApply(strips[f.strip], &rec.blob[f.at], f.len);
+      w.shows++;
+      w.showUs += f.showUs;
+      w.maxShowUs = std::max(w.maxShowUs, f.showUs);
+      w.changed += f.changed;
+    }
+    for (; nextEvent < rec.events.size() && rec.events[nextEvent].us <= toUs; nextEvent++) {
+      if (rec.events[nextEvent].us >= w.fromUs) w.events.push_back(&rec.events[nextEvent]);
+    }
+    atUs = toUs;
+    return w;
+  }
+
+  // Board colour (RRGGBB) at column x, row y (row 0 at the top)
+  uint32_t pixel(int x, int y, float gain) const {
+    for (size_t s = 0; s < strips.size(); s++) {
+      int q = rec.quadOf[s];
+      if (q < 0) continue;
+      int qx = x - QUAD_ORIGIN[q][0], qy = y - QUAD_ORIGIN[q][1];
+      if (qx < 0 || qx >= QUAD_COLS || qy < 0 || qy >= QUAD_ROWS) continue;
+      const uint8_t* p = &strips[s].pixels[Panel::index(qx, QUAD_ROWS - 1 - qy) * 3];
+      auto scaled = [gain](uint8_t v) { return (uint32_t)std::min(255.0f, v * gain + 0.5f); };
+      return scaled(p[1]) << 16 | scaled(p[0]) << 8 | scaled(p[2]); // buffer is G R B
+    }
+    return 0;
+  }
+};
+
+uint32_t eventColor(const std::string& text) {
+  if (text.compare(0, 4, "key ") == 0) return 0xFFFF00;
+  if (text.compare(0, 5, "ball ") == 0) return 0x00FFFF;
+  if (text.compare(0, 5, "type ") == 0) return 0xFF00FF;
+  if (text.compare(0, 5, "PASS ") == 0) return 0x00FF00;
+  if (text.compare(0, 5, "FAIL ") == 0) return 0xFF0000;
+  return 0xFFFFFF;
+}
+
+// --- IMAGES ---
+struct Image {
+  int w, h;
+  std::vector<uint32_t> px;
+  Image(int w_, int h_) : w(w_), h(h_), px(w_ * h_, 0) {}
+  void set(int x, int y, uint32_t c) { if (x >= 0 && x < w && y >= 0 && y < h) px[y * w + x] = c; }
+  void fill(int x0, int y0, int ww, int hh, uint32_t c) {
+    for (int y = y0; y < y0 + hh; y++)
+      for (int x = x0; x < x0 + ww; x++) set(x, y, c);
+  }
+  void paste(const Image& src, int x0, int y0) {
+    for (int y = 0; y < src.h; y++)
+      for (int x = 0; x < src.w; x++) set(x0 + x, y0 + y, src.px[y * src.w + x]);
+  }
+};
+
+// The board, then the show() bar and the input ticks
+Image picture(const Player& player, const Window& w, int scale, float gain) {
+  int size = BOARD * scale;
+  Image img(size, size + 2 * BAR_H + 2);
+  for (int y = 0; y < BOARD; y++)
+    for (int x = 0; x < BOARD; x++) img.fill(x * scale, y * scale, scale, scale, player.pixel(x, y, gain));
+
+  uint64_t span = std::max<uint64_t>(1, w.toUs - w.fromUs);
+  int busy = (int)std::min<uint64_t>(size, w.showUs * size / span);
+  img.fill(0, size + 1, size, BAR_H, 0x202020);
+  img.fill(0, size + 1, busy, BAR_H, 0xFF3030);
+  for (const Event* e : w.events) {
+    int x = (int)((e->us - w.fromUs) * (size - 1) / span);
+    img.fill(x, size + BAR_H + 2, std::max(1, scale / 2), BAR_H, eventColor(e->text));
+  }
+  return img;
+}
+
+// PNG, uncompressed (stored deflate blocks): no zlib needed
+uint32_t crc32(const uint8_t* data, size_t len, uint32_t crc = 0) {
+  static uint32_t table[256];
+  if (!table[1]) {
+    for (uint32_t n = 0; n < 256; n++) {
+      uint32_t c = n;
+      for (int k = 0; k < 8; k++) c = c & 1 ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+      table[n] = c;
+    }
+  }
+  crc = ~crc;
+  for (size_t i = 0; i < len; i++) crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+  return ~crc;
+}
+
+void putBE32(std::vector<uint8_t>& out, uint32_t v) {
+  for (int s = 24; s >= 0; s -= 8) out.push_back(v >> s);
+}
+
+void pngChunk(FILE* f, const char* type, const std::vector<uint8_t>& data) {
+  std::vector<uint8_t> chunk;
+  putBE32(chunk, data.size());
+  chunk.insert(chunk.end(), type, type + 4);
+  chunk.insert(chunk.end(), data.begin(), data.end());
+  putBE32(chunk, crc32(&chunk[4], chunk.size() - 4));
+  fwrite(chunk.data(), 1, chunk.size(), f);
+}
+
+bool writePng(const char* path, const Image& img) {
+  FILE* f = fopen(path, "wb");
+  if (!f) return false;
+  fwrite("\x89PNG\r\n\x1a\n", 1, 8, f);
+  std::vector<uint8_t> ihdr;
+  putBE32(ihdr, img.w);
+  putBE32(ihdr, img.h);
+  ihdr.insert(ihdr.end(), {8, 2, 0, 0, 0}); // 8-bit RGB
+  pngChunk(f, "IHDR", ihdr);
+
+  std::vector<uint8_t> raw;
+  for (int y = 0; y < img.h; y++) {
+    raw.push_back(0); // no filter
+    for (int x = 0; x < img.w; x++) {
+      uint32_t c = img.px[y * img.w + x];
+      raw.insert(raw.end(), {(uint8_t)(c >> 16), (uint8_t)(c >> 8), (uint8_t)c});
+    }
+  }
+  std::vector<uint8_t> z = {0x78, 0x01};
+  for (size_t at = 0; at < raw.size() || at == 0; at += 65535) {
+    size_t n = std::min<size_t>(65535, raw.size() - at);
+    z.push_back(at + n >= raw.size());
+    z.insert(z.end(), {(uint8_t)n, (uint8_t)(n >> 8), (uint8_t)~n, (uint8_t)(~n >> 8)});
+    z.insert(z.end(), raw.begin() + at, raw.begin() + at + n);
+  }
+  uint32_t a = 1, b = 0;
+  for (uint8_t v : raw) {
+    a = (a + v) % 65521;
+    b = (b + a) % 65521;
+  }
+  putBE32(z, b << 16 | a);
+  pngChunk(f, "IDAT", z);
+  pngChunk(f, "IEND", {});
+  return fclose(f) == 0;
+}
+
+// GIF: 3-3-2 colour cube palette, LZW coded
+struct GifWriter {
+  FILE* f;
+  int w, h;
+  std::vector<uint8_t> block;
+  uint32_t bits = 0;
+  int nbits = 0;
+
+  bool open(const char* path, int width, int height) {
+    f = fopen(path, "wb");
+    if (!f) return false;
+    w = width;
+    h = height;
+    fwrite("GIF89a", 1, 6, f);
+    put16(w);
+    put16(h);
+    fputc(0xF7, f); // global colour table, 256 entries
+    fputc(0, f);
+    fputc(0, f);
+    for (int i = 0; i < 256; i++) {
+      fputc((i >> 5) * 255 / 7, f);
+      fputc((i >> 2 & 7) * 255 / 7, f);
+      fputc((i & 3) * 255 / 3, f);
+    }
+    fwrite("\x21\xFF\x0BNETSCAPE2.0\x03\x01\x00\x00\x00", 1, 19, f); // loop forever
+    return true;
+  }
+
+  void put16(int v) { fputc(v & 0xFF, f); fputc(v >> 8, f); }
+
+  void flushBlock() {
+    if (block.empty()) return;
+    fputc((int)block.size(), f);
+    fwrite(block.data(), 1, block.size(), f);
+    block.clear();
+  }
+
+  void code(uint32_t c, int size) {
+    bits |= c << nbits;
+    nbits += size;
+    while (nbits >= 8) {
+      block.push_back(bits & 0xFF);
+      bits >>= 8;
+      nbits -= 8;
+      if (block.size() == 255) flushBlock();
+    }
+  }
+
+  void frame(const Image& img, int delayCs) {
+    fwrite("\x21\xF9\x04\x00", 1, 4, f);
+    put16(delayCs);
+    fwrite("\x00\x00", 1, 2, f);
+    fputc(0x2C, f);
+    put16(0); put16(0); put16(w); put16(h);
+    fputc(0, f);
+    fputc(8, f); // minimum code size
+
+    const uint32_t CLEAR = 256, END = 257;
+    std::vector<uint16_t> dict(4096 * 256, 0); // code * 256 + byte -> code (0 = none)
+    int size = 9;
+    uint32_t nextCode = END + 1;
+    int prefix = -1;
+    code(CLEAR, size);
+    for (uint32_t c : img.px) {
+      uint8_t k = (c >> 16 & 0xE0) | (c >> 11 & 0x1C) | (c >> 6 & 0x03);
+      if (prefix < 0) { prefix = k; continue; }
+      uint16_t& known = dict[prefix * 256 + k];
+      if (known) { prefix = known; continue; }
+      code(prefix, size);
+      known = nextCode++;
+      if (nextCode > (1u << size) && size < 12) size++;
+      if (nextCode == 4095) {
+        code(CLEAR, size);
+        std::fill(dict.begin(), dict.end(), 0);
+        size = 9;
+        nextCode = END + 1;
+      }
+      prefix = k;
+    }
+    code(prefix, size);
+    code(END, size);
+    if (nbits) code(0, 8 - nbits);
+    flushBlock();
+    fputc(0, f);
+  }
+
+  bool close() {
+    fputc(0x3B, f);
+    return fclose(f) == 0;
+  }
+};
+
+// --- OUTPUTS ---
+void printWindow(const Window& w) {
+  printf("t %8.3f s  %u shows, %.1f ms on the wire (max %.1f), %lu LEDs changed",
+         w.toUs / 1e6, w.shows, w.showUs / 1000.0, w.maxShowUs / 1000.0, w.changed);
+  for (const Event* e : w.events) printf("  [%.3f %s]", e->us / 1e6, e->text.c_str());
+  printf("\n");
+}
+
+void replayTerminal(const Recording& rec, Player& player, uint64_t toUs, float speed, float gain) {
+  uint64_t stepUs = (uint64_t)(1e6 / TERMINAL_FPS * (speed > 0 ? speed : 1));
+  printf("\x1b[2J");
+  std::vector<const Event*> recent;
+  for (uint64_t t = player.atUs; t < toUs + stepUs; t += stepUs) {
+    Window w = player.advance(std::min(t, toUs));
+    recent.insert(recent.end(), w.events.begin(), w.events.end());
+    std::string out = "\x1b[H";
+    char buf[64];
+    for (int y = 0; y < BOARD; y += 2) {
+      for (int x = 0; x < BOARD; x++) {
+        uint32_t top = player.pixel(x, y, gain), bottom = player.pixel(x, y + 1, gain);
+        snprintf(buf, sizeof(buf), "\x1b[38;2;%u;%u;%um\x1b[48;2;%u;%u;%um\xE2\x96\x80", top >> 16,
+                 top >> 8 & 0xFF, top & 0xFF, bottom >> 16, bottom >> 8 & 0xFF, bottom & 0xFF);
+        out += buf;
+      }
+      out += "\x1b[0m\n";
+    }
+    fputs(out.c_str(), stdout);
+    snprintf(buf, sizeof(buf), "t %8.3f s of %.3f s  ", w.toUs / 1e6, rec.endUs / 1e6);
+    printf("%s%u shows, %.1f ms on the wire (max %.1f), %lu LEDs changed\x1b[K\n", buf, w.shows,
+           w.showUs / 1000.0, w.maxShowUs / 1000.0, w.changed);
+    size_t first = recent.size() > EVENT_LINES ? recent.size() - EVENT_LINES : 0;
+    for (size_t i = 0; i < EVENT_LINES; i++) {
+      if (first + i < recent.size()) {
+        const Event* e = recent[first + i];
+        printf("  %8.3f s  %s\x1b[K\n", e->us / 1e6, e->text.c_str());
+      } else {
+        printf("\x1b[K\n");
+      }
+    }
+    fflush(stdout);
+    if (speed > 0) usleep(1000000 / TERMINAL_FPS);
+  }
+}
+
+bool filmStrip(const char* path, Player& player, uint64_t toUs, uint64_t everyUs, int scale, float gain) {
+  std::vector<Image> cells;
+  printf("Film strip, one picture per %.0f ms (left to right, %d to a row):\n", everyUs / 1000.0, CELLS_PER_ROW);
+  for (uint64_t t = player.atUs + everyUs; t <= toUs + everyUs - 1; t += everyUs) {
+    Window w = player.advance(std::min(t, toUs));
+    printf("  %3zu  ", cells.size());
+    printWindow(w);
+    cells.push_back(picture(player, w, scale, gain));
+  }
+  if (cells.empty()) return false;
+  int cw = cells[0].w + 2, ch = cells[0].h + 2;
+  int cols = std::min<int>(CELLS_PER_ROW, cells.size());
+  int rows = (cells.size() + CELLS_PER_ROW - 1) / CELLS_PER_ROW;
+  Image strip(cols * cw, rows * ch);
+  for (size_t i = 0; i < cells.size(); i++) strip.paste(cells[i], (i % CELLS_PER_ROW) * cw + 1, (i / CELLS_PER_ROW) * ch + 1);
+  return writePng(path, strip);
+}
+
+bool animation(const char* path, Player& player, uint64_t toUs, int fps, int scale, float gain) {
+  uint64_t stepUs = 1000000 / fps;
+  Window w = player.advance(player.atUs);
+  Image first = picture(player, w, scale, gain);
+  GifWriter gif;
+  if (!gif.open(path, first.w, first.h)) return false;
+  unsigned n = 0;
+  for (uint64_t t = player.atUs + stepUs; t <= toUs + stepUs - 1; t += stepUs, n++) {
+    w = player.advance(std::min(t, toUs));
+    gif.frame(picture(player, w, scale, gain), 100 / fps);
+  }
+  printf("%u pictures at %d per second\n", n, fps);
+  return gif.close();
+}
+
+void summary(const Recording& rec, const char* path) {
+  FILE* f = fopen(path, "rb");
+  fseek(f, 0, SEEK_END);
+  long bytes = ftell(f);
+  fclose(f);
+  printf("%s: %.3f s, %zu shows, %zu events, %ld bytes (%.0f per show)\n", path, rec.endUs / 1e6,
+         rec.frames.size(), rec.events.size(), bytes, rec.frames.empty() ? 0.0 : (double)bytes / rec.frames.size());
+  for (size_t s = 0; s < rec.strips.size(); s++) {
+    unsigned long shows = 0, unchanged = 0, changed = 0;
+    uint64_t us = 0;
+    for (const Frame& fr : rec.frames) {
+      if (fr.strip != s) continue;
+      shows++;
+      unchanged += fr.changed == 0;
+      changed += fr.changed;
+      us += fr.showUs;
+    }
+    printf("  strip %zu (pin %u, quadrant %d): %lu shows, %lu changed nothing, %.0f LEDs changed per show, "
+           "%.1f ms on the wire\n", s, rec.strips[s].pin, rec.quadOf[s], shows, unchanged,
+           shows ? (double)changed / shows : 0.0, us / 1000.0);
+  }
+}
+
+int main(int argc, char** argv) {
+  const char* path = nullptr;
+  const char* png = nullptr;
+  const char* gifPath = nullptr;
+  float fromS = 0, toS = -1, speed = 1, gain = 0;
+  int everyMs = 250, fps = 10, scale = 4;
+  for (int i = 1; i < argc; i++) {
+    std::string a = argv[i];
+    bool more = i + 1 < argc;
+    if (a == "--png" && more) png = argv[++i];
+    else if (a == "--gif" && more) gifPath = argv[++i];
+    else if (a == "--from" && more) fromS = atof(argv[++i]);
+    else if (a == "--to" && more) toS = atof(argv[++i]);
+    else if (a == "--speed" && more) speed = atof(argv[++i]);
+    else if (a == "--every" && more) everyMs = std::max(1, atoi(argv[++i]));
+    else if (a == "--fps" && more) fps = std::min(100, std::max(1, atoi(argv[++i])));
+    else if (a == "--scale" && more) scale = std::max(1, atoi(argv[++i]));
+    else if (a == "--gain" && more) gain = atof(argv[++i]);
+    else if (a[0] != '-' && !path) path = argv[i];
+    else {
+      printf("Usage: view_recording FILE [--png OUT | --gif OUT] [--from S] [--to S] [--speed X]\n"
+             "       [--every MS] [--fps N] [--scale N] [--gain G]\n");
+      return 1;
+    }
+  }
+  if (!path) {
+    printf("Which recording? (make one with: run_scenarios --record DIR)\n");
+    return 1;
+  }
+
+  Recording rec;
+  if (!load(path, rec)) return 1;
+  if (gain <= 0) gain = rec.peak ? 255.0f / rec.peak : 1;
+  uint64_t toUs = toS < 0 ? rec.endUs : std::min<uint64_t>(rec.endUs, (uint64_t)(toS * 1e6));
+  Player player(rec);
+  player.advance((uint64_t)(fromS * 1e6)); // catch up silently
+
+  bool ok = true;
+  if (png) {
+    ok = filmStrip(png, player, toUs, everyMs * 1000ULL, scale, gain);
+    printf("%s %s\n", ok ? "Wrote" : "Couldn't write", png);
+  } else if (gifPath) {
+    ok = animation(gifPath, player, toUs, fps, scale, gain);
+    printf("%s %s\n", ok ? "Wrote" : "Couldn't write", gifPath);
+  } else {
+    replayTerminal(rec, player, toUs, speed, gain);
+  }
+  summary(rec, path);
+  return ok ? 0 : 1;
+}